@@ -0,0 +1,922 @@
+// gradient_core のホットパスを計測するベンチマーク
+//
+// 使い方: gradient_bench [--filter=<部分文字列>] [--min-time=<秒>] [--list]
+// 結果はベンチマークごとに 1 行で、バッチごとの 1 回あたりの所要時間の中央値と最小値を出力する
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <latch>
+#include <memory>
+#include <regex>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "json.hpp"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_binary.h"
+#include "ui/widgets/preset_eval.h"
+#include "ui/widgets/preset_hash.h"
+#include "ui/widgets/preset_import.h"
+#include "ui/widgets/preset_list_cache.h"
+#include "ui/widgets/preset_search_index.h"
+#include "ui/widgets/thumbnail_disk_cache.h"
+#include "ui/widgets/thumbnail_lru.h"
+#include "utils/aviutl2/alias_document.h"
+#include "utils/aviutl2/alias_parser.h"
+#include "utils/common/async_log.h"
+#include "utils/common/color_conv.h"
+#include "utils/common/frame_profiler.h"
+#include "utils/common/str_conv.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 1 バッチの最短の所要時間。これに満たない場合は回数を増やして測り直す
+constexpr std::chrono::milliseconds MIN_BATCH_TIME{10};
+
+constexpr uint32_t PRESET_COUNT = 1000;
+
+// 計算結果を捨てられないようにするための出力先
+std::atomic<uint64_t> g_sink{0};
+
+void consume(const uint64_t value) noexcept { g_sink.fetch_xor(value, std::memory_order_relaxed); }
+
+/// @brief 再現性のある疑似乱数 (xorshift64)
+class Random {
+public:
+    explicit Random(const uint64_t seed) : m_state{seed} {}
+
+    uint64_t next() noexcept
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 7;
+        m_state ^= m_state << 17;
+        return m_state;
+    }
+
+    float uniform() noexcept { return static_cast<float>(next() >> 40) / static_cast<float>(1u << 24); }
+    uint32_t below(const uint32_t n) noexcept { return static_cast<uint32_t>(next() % n); }
+
+private:
+    uint64_t m_state;
+};
+
+preset::GradientPreset makePreset(Random& random, const uint32_t index)
+{
+    const uint32_t stop_count = 2 + random.below(7);
+
+    preset::GradientPreset preset;
+    preset.name = "Preset " + std::to_string(index);
+    preset.colors.clear();
+    preset.positions.clear();
+    preset.midpoints.clear();
+    for (uint32_t i = 0; i < stop_count; ++i) {
+        preset.colors.push_back(static_cast<uint32_t>(random.next() >> 32) | 0xFF);
+        preset.positions.push_back(static_cast<float>(i) / static_cast<float>(stop_count - 1));
+        if (i + 1 < stop_count) preset.midpoints.push_back(0.3f + random.uniform() * 0.4f);
+    }
+    preset.blur_width = random.uniform();
+    return preset;
+}
+
+preset_file::GradientPresetFile makePresetFile(const uint32_t count)
+{
+    Random random{0x9E3779B97F4A7C15ull};
+    preset_file::GradientPresetFile file;
+    file.presets.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) file.presets.push_back(makePreset(random, i));
+    file.revision = 1;
+    return file;
+}
+
+std::string makeGgr(const uint32_t segment_count)
+{
+    std::string text = "GIMP Gradient\nName: Bench\n" + std::to_string(segment_count) + "\n";
+    for (uint32_t i = 0; i < segment_count; ++i) {
+        const float left  = static_cast<float>(i) / static_cast<float>(segment_count);
+        const float right = static_cast<float>(i + 1) / static_cast<float>(segment_count);
+        text += std::to_string(left) + " " + std::to_string((left + right) * 0.5f) + " " + std::to_string(right) +
+                " 0.1 0.2 0.3 1.0 0.4 0.5 0.6 1.0 0 0\n";
+    }
+    return text;
+}
+
+std::string makeCss(const uint32_t stop_count)
+{
+    std::string text = ".bench { background: linear-gradient(90deg";
+    for (uint32_t i = 0; i < stop_count; ++i) {
+        text += i % 2 == 0 ? ", #3366cc " : ", rgba(200, 40, 10, 0.5) ";
+        text += std::to_string(i * 100 / std::max(stop_count - 1, 1u)) + "%";
+    }
+    return text + "); }\n";
+}
+
+/// @brief 一時ディレクトリに書き出したプリセットライブラリ。終了時に削除する
+class TempPresetLibrary {
+public:
+    TempPresetLibrary(const std::string_view name, const uint32_t count)
+        : file{makePresetFile(count)},
+          m_dir{std::filesystem::temp_directory_path() / ("gradient_bench_" + std::string{name})}
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+        std::filesystem::create_directories(m_dir);
+        manager.setPresetFilePath(m_dir / "presets.json");
+        if (!manager.writePresetFile(file).is_success) std::abort();
+    }
+
+    /// @brief バイナリを削除し、次の読み込みを JSON から行わせる
+    void removeBinary()
+    {
+        std::filesystem::path path = manager.presetFilePath();
+        path.replace_extension(preset_binary::EXTENSION);
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    ~TempPresetLibrary()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_dir, ec);
+    }
+
+    preset_file::GradientPresetFile file;
+    PresetManager manager;
+
+private:
+    std::filesystem::path m_dir;
+};
+
+// グラデーションのエフェクトを持つオブジェクトのエイリアス
+std::string makeAlias(const uint32_t marker_count)
+{
+    std::string text = "[Object]\r\nframe=0,299\r\nlayer=1\r\n[Object.0]\r\neffect.name=図形\r\nサイズ=100\r\n";
+    text += "[Object.1]\r\neffect.name=グラデーション編集@GradientEditor\r\n";
+    text += "マーカー数=" + std::to_string(marker_count) + "\r\nぼかし幅=1.00\r\n";
+    for (uint32_t i = 1; i <= marker_count; ++i) {
+        const std::string id = std::to_string(i);
+        text += "位置" + id + "=0.000," + std::to_string(i * 3) + ".000,0.500\r\n";
+        text += "色" + id + "=ff8040\r\n";
+        text += "透明度" + id + "=0.00\r\n";
+        text += "中間点" + id + "=0.500\r\n";
+    }
+    return text + "[Object.2]\r\neffect.name=標準描画\r\nX=0.00\r\nY=0.00\r\n";
+}
+
+// セクションとエフェクトの多いオブジェクトのエイリアス。frame= は section_count 個の値を持つ
+std::string makeLargeAlias(const uint32_t section_count, const uint32_t effect_count)
+{
+    std::string text = "[Object]\r\nlayer=1\r\nframe=0";
+    for (uint32_t i = 1; i < section_count; ++i) text += "," + std::to_string(i * 30);
+    text += "\r\n";
+    // makeAlias() のグラデーションのエフェクトのセクションの中身を、番号を付け替えて並べる
+    const std::string alias = makeAlias(30);
+    const size_t first      = alias.find("[Object.1]") + std::string_view{"[Object.1]"}.size();
+    const std::string body  = alias.substr(first, alias.find("[Object.2]") - first);
+    for (uint32_t i = 0; i < effect_count; ++i) text += "[Object." + std::to_string(i) + "]" + body;
+    return text;
+}
+
+// 書き換える前の getFrameCount。結果と速度の比較に使う
+int32_t regexGetFrameCount(std::string_view alias)
+{
+    int32_t count{2};
+    std::regex re(R"(\[Object\][\s\S]*?\r?\n(frame=.*))");
+    std::string s{alias};
+    std::smatch m;
+    if (std::regex_search(s, m, re)) {
+        std::string frame_line = m[1].str();
+        count                  = static_cast<int32_t>(std::count(frame_line.begin(), frame_line.end(), ',')) + 1;
+    }
+    return count;
+}
+
+/// @brief サムネイルの描画の代わりに、CPU で評価して RGBA8 のピクセルにする
+/// @note D3D11 での描画と読み戻しはこの環境では計測できないため、同じ大きさの結果を作る処理で置き換える
+std::vector<std::byte> renderThumbnailOnCpu(const preset::GradientPreset& preset, const int32_t width, const int32_t height)
+{
+    std::vector<preset_eval::Oklab> samples(static_cast<size_t>(width));
+    preset_eval::sampleOklab(preset, samples);
+
+    const auto to_byte = [](const float value) { return std::byte{static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f)}; };
+    const size_t row_bytes = static_cast<size_t>(width) * 4;
+    std::vector<std::byte> pixels(row_bytes * static_cast<size_t>(height));
+    for (int32_t x = 0; x < width; ++x) {
+        pixels[x * 4 + 0] = to_byte(samples[x].x);
+        pixels[x * 4 + 1] = to_byte(samples[x].y + 0.5f);
+        pixels[x * 4 + 2] = to_byte(samples[x].z + 0.5f);
+        pixels[x * 4 + 3] = std::byte{0xFF};
+    }
+    for (int32_t y = 1; y < height; ++y) std::copy_n(pixels.begin(), row_bytes, pixels.begin() + y * row_bytes);
+    return pixels;
+}
+
+// ImVec4 の代わり
+struct Color4 {
+    float x, y, z, w;
+};
+
+/// @brief 計測対象。run(n) は処理を n 回行う
+struct Benchmark {
+    std::string name;
+    std::function<void(uint64_t)> run;
+    uint64_t bytes_per_op = 0;  // 0 以外の場合はスループット (MB/s) も表示する
+    double target_ns      = 0;  // 0 以外の場合は目標の時間。中央値が超えたら終了コードを 1 にする
+};
+
+struct Result {
+    uint64_t iterations = 0;
+    double median_ns    = 0.0;
+    double min_ns       = 0.0;
+};
+
+Result measure(const Benchmark& benchmark, const std::chrono::duration<double> min_time)
+{
+    // 関数内の static の初期化など、初回のみの準備を計測の前に済ませる
+    benchmark.run(0);
+
+    // 1 バッチが MIN_BATCH_TIME 以上になる回数を求める
+    uint64_t batch = 1;
+    while (true) {
+        const auto start = Clock::now();
+        benchmark.run(batch);
+        if (Clock::now() - start >= MIN_BATCH_TIME || batch >= (uint64_t{1} << 40)) break;
+        batch *= 2;
+    }
+
+    std::vector<double> per_op_ns;
+    Result result;
+    const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(min_time);
+    do {
+        const auto start = Clock::now();
+        benchmark.run(batch);
+        const auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        per_op_ns.push_back(elapsed / static_cast<double>(batch));
+        result.iterations += batch;
+    } while (Clock::now() < deadline || per_op_ns.size() < 5);
+
+    std::sort(per_op_ns.begin(), per_op_ns.end());
+    result.median_ns = per_op_ns[per_op_ns.size() / 2];
+    result.min_ns    = per_op_ns.front();
+    return result;
+}
+
+std::vector<Benchmark> makeBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+
+    // 以下のデータはベンチマークの間で共有し、計測前に一度だけ作る
+    static const preset_file::GradientPresetFile file = makePresetFile(PRESET_COUNT);
+    static const std::string json_text                = nlohmann::ordered_json(file).dump();
+    static const std::vector<std::byte> binary        = preset_binary::serialize(file, {}, 0);
+
+    static const std::vector<preset::GradientPreset> canonical_presets = [] {
+        std::vector<preset::GradientPreset> presets;
+        for (const auto& preset : file.presets) presets.push_back(preset_hash::canonicalize(preset));
+        return presets;
+    }();
+
+    static const preset_search::PresetSearchIndex search_index = [] {
+        preset_search::PresetSearchIndex index;
+        index.build(file);
+        return index;
+    }();
+
+    // プリセットファイル
+    benchmarks.push_back({"preset_json/parse_1000", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  auto parsed = nlohmann::ordered_json::parse(json_text).get<preset_file::GradientPresetFile>();
+                                  consume(parsed.presets.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_binary/serialize_1000", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) consume(preset_binary::serialize(file, {}, 0).size());
+                          }});
+    benchmarks.push_back({"preset_binary/open_deserialize_1000", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  preset_binary::View view;
+                                  if (!view.open(binary)) std::abort();
+                                  consume(preset_binary::deserialize(view).presets.size());
+                              }
+                          }});
+
+    // 起動時の読み込み (PresetManager::loadPresetFile)。JSON の解析と、メモリマップしたバイナリからの読み込みの比較
+    benchmarks.push_back({"preset_load/json_10000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"load_json_10000", 10000};
+                              library.removeBinary();
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  auto result = library.manager.loadPresetFile();
+                                  if (!result.stale_binary_source) std::abort();
+                                  consume(result.preset_file.presets.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_load/binary_10000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"load_binary_10000", 10000};
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  auto result = library.manager.loadPresetFile();
+                                  if (result.stale_binary_source) std::abort();
+                                  consume(result.preset_file.presets.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_load/json_100000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"load_json_100000", 100000};
+                              library.removeBinary();
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  auto result = library.manager.loadPresetFile();
+                                  if (!result.stale_binary_source) std::abort();
+                                  consume(result.preset_file.presets.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_load/binary_100000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"load_binary_100000", 100000};
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  auto result = library.manager.loadPresetFile();
+                                  if (result.stale_binary_source) std::abort();
+                                  consume(result.preset_file.presets.size());
+                              }
+                          }});
+
+    // 10000 個のライブラリへの変更 1 回の所要時間。ジャーナルへの追記 (JOURNAL_COMPACTION_THRESHOLD 回ごとの圧縮を含む) と、ファイル全体の書き出しの比較
+    benchmarks.push_back({"preset_journal/commit_swap_10000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"journal_swap", 10000};
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  const auto index = static_cast<uint32_t>(i % 10000);
+                                  preset_journal::Operation op{.type = preset_journal::OperationType::Swap, .index_1 = index, .index_2 = 9999 - index};
+                                  consume(library.manager.commitOperation(library.file, std::move(op)).is_success);
+                              }
+                          }});
+    benchmarks.push_back({"preset_journal/commit_overwrite_10000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"journal_overwrite", 10000};
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  const auto index = static_cast<uint32_t>(i % 10000);
+                                  preset_journal::Operation op{.type = preset_journal::OperationType::Overwrite, .index_1 = index, .preset = file.presets[i % PRESET_COUNT]};
+                                  consume(library.manager.commitOperation(library.file, std::move(op)).is_success);
+                              }
+                          }});
+    benchmarks.push_back({"preset_journal/full_rewrite_10000", [](const uint64_t n) {
+                              static TempPresetLibrary library{"journal_rewrite", 10000};
+                              for (uint64_t i = 0; i < n; ++i) consume(library.manager.writePresetFile(library.file).is_success);
+                          }});
+
+    // プリセット一覧の 1 フレーム分 (5000 個) の色の変換。以前は 16 進数の文字列を毎フレーム変換していた。
+    // 現在は RGBA を直接変換し、その結果もプリセットが変わるまでキャッシュするため、定常のフレームではどちらも行わない
+    static const preset_file::GradientPresetFile list_file = makePresetFile(5000);
+    benchmarks.push_back({"preset_list/decode_hex_5000", [](const uint64_t n) {
+                              static const std::vector<std::vector<std::string>> hex_colors = [] {
+                                  std::vector<std::vector<std::string>> colors;
+                                  for (const auto& preset : list_file.presets) {
+                                      auto& hex = colors.emplace_back();
+                                      for (uint32_t rgba : preset.colors) hex.push_back(preset::formatColor(rgba));
+                                  }
+                                  return colors;
+                              }();
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  float sum = 0.0f;
+                                  for (const auto& colors : hex_colors) {
+                                      for (const auto& hex : colors) sum += color_conv::u32Rgba2Vec4Rgba<Color4>(preset::parseColor(hex)).x;
+                                  }
+                                  consume(static_cast<uint64_t>(sum));
+                              }
+                          }});
+    benchmarks.push_back({"preset_list/decode_rgba_5000", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  float sum = 0.0f;
+                                  for (const auto& preset : list_file.presets) {
+                                      for (uint32_t rgba : preset.colors) sum += color_conv::u32Rgba2Vec4Rgba<Color4>(rgba).x;
+                                  }
+                                  consume(static_cast<uint64_t>(sum));
+                              }
+                          }});
+
+    // プリセット一覧の 1 フレーム分の ImGui 以外の処理。表示中の 40 行の変換結果を RowCache から取得し、サムネイルの LRU に問い合わせる。
+    // 1 フレームに 1 行ずつスクロールする。uncached は毎フレーム revision が変わる (すべての行を変換し直す) 場合
+    constexpr uint32_t LIST_VISIBLE_ROWS = 40;
+    struct ListFrame {
+        preset_file::GradientPresetFile file = list_file;
+        preset_list::RowCache<std::vector<Color4>> rows;
+        thumbnail_cache::ThumbnailLru thumbnails{256};
+
+        void run(const bool bump_revision, const uint64_t n)
+        {
+            const auto decode = [](const preset::GradientPreset& preset) {
+                std::vector<Color4> colors(preset.colors.size());
+                for (size_t i = 0; i < colors.size(); ++i) colors[i] = color_conv::u32Rgba2Vec4Rgba<Color4>(preset.colors[i]);
+                return colors;
+            };
+            for (uint64_t i = 0; i < n; ++i) {
+                if (bump_revision) ++file.revision;
+                rows.sync(file);
+                const auto first = static_cast<uint32_t>(i % (file.presets.size() - LIST_VISIBLE_ROWS));
+                for (uint32_t index = first; index < first + LIST_VISIBLE_ROWS; ++index) {
+                    const auto& row = rows.get(file, index, decode);
+                    consume(thumbnails.acquire(index, row.content_hash, 160, 20).needs_render);
+                }
+            }
+        }
+    };
+    benchmarks.push_back({"preset_list/cached_frame_5000", [](const uint64_t n) {
+                              static ListFrame frame;
+                              frame.run(false, n);
+                          }});
+    benchmarks.push_back({"preset_list/uncached_frame_5000", [](const uint64_t n) {
+                              static ListFrame frame;
+                              frame.run(true, n);
+                          }});
+
+    // 重複の検出
+    benchmarks.push_back({"preset_hash/canonicalize", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  consume(preset_hash::canonicalize(file.presets[i % PRESET_COUNT]).colors.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_hash/content_hash", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) consume(preset_hash::contentHash(canonical_presets[i % PRESET_COUNT]));
+                          }});
+
+    // 起動直後に表示する 40 行のサムネイル。cold はキャッシュファイルがなく、すべて描画して登録する。
+    // warm は前回の起動で保存した 1000 個分のファイル (約 12.8 MB) を読み込み、表示する行を探すだけで済む
+    constexpr int32_t THUMBNAIL_WIDTH        = 160;
+    constexpr int32_t THUMBNAIL_HEIGHT       = 20;
+    constexpr uint64_t THUMBNAIL_RENDERER_ID = 1;
+    struct ThumbnailStartup {
+        TempPresetLibrary library;
+        std::vector<uint64_t> hashes;
+        std::filesystem::path cache_path;
+
+        /// @param is_warm 前回の起動で、すべてのプリセットのサムネイルを保存したキャッシュファイルを用意する
+        ThumbnailStartup(const std::string_view name, const bool is_warm)
+            : library{name, 1000}
+        {
+            cache_path = library.manager.presetFilePath();
+            cache_path.replace_extension(thumbnail_cache::EXTENSION);
+            for (const auto& preset : library.file.presets) hashes.push_back(preset_hash::contentHash(preset_hash::canonicalize(preset)));
+            if (!is_warm) return;
+
+            thumbnail_cache::ThumbnailDiskCache cache;
+            cache.load(cache_path, THUMBNAIL_RENDERER_ID);
+            for (size_t i = 0; i < hashes.size(); ++i) {
+                cache.store(hashes[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, renderThumbnailOnCpu(library.file.presets[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT));
+            }
+            if (!cache.save(cache_path, [](uint64_t) { return true; })) std::abort();
+        }
+
+        /// @brief キャッシュファイルを読み込み、表示する行のサムネイルを揃える。見つからないものは描画して登録する
+        void start() const
+        {
+            thumbnail_cache::ThumbnailDiskCache cache;
+            cache.load(cache_path, THUMBNAIL_RENDERER_ID);
+            for (uint32_t i = 0; i < 40; ++i) {
+                auto pixels = cache.find(hashes[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+                if (pixels.empty()) {
+                    cache.store(hashes[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT, renderThumbnailOnCpu(library.file.presets[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT));
+                    pixels = cache.find(hashes[i], THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT);
+                }
+                consume(static_cast<uint64_t>(pixels[0]));
+            }
+        }
+    };
+    benchmarks.push_back({"thumbnail_cache/cold_start_40_visible", [](const uint64_t n) {
+                              static const ThumbnailStartup startup{"thumbnail_cold", false};
+                              for (uint64_t i = 0; i < n; ++i) startup.start();
+                          }});
+    benchmarks.push_back({"thumbnail_cache/warm_start_40_visible", [](const uint64_t n) {
+                              static const ThumbnailStartup startup{"thumbnail_warm", true};
+                              for (uint64_t i = 0; i < n; ++i) startup.start();
+                          },
+                          sizeof(thumbnail_cache::Header) + 1000 * (sizeof(thumbnail_cache::Entry) + THUMBNAIL_WIDTH * THUMBNAIL_HEIGHT * 4)});
+
+    // 1 万個のライブラリに 1 万個をまとめて読み込む。半分は既存のプリセットと同じ内容を、丸めの誤差とマーカーの並びを変えて表したもの。
+    // PresetController::importPresets() と同じく、1 回ごとに revision が変わったインデックスを作り直してから重複を調べる
+    benchmarks.push_back({"preset_hash/import_dedup_10000_into_10000", [](const uint64_t n) {
+                              static preset_file::GradientPresetFile library = makePresetFile(10000);
+                              static const std::vector<preset::GradientPreset> incoming = [] {
+                                  std::vector<preset::GradientPreset> presets;
+                                  Random random{0xD1B54A32D192ED03ull};
+                                  for (uint32_t i = 0; i < 10000; ++i) {
+                                      if (i % 2 == 1) {
+                                          presets.push_back(makePreset(random, i));
+                                          continue;
+                                      }
+                                      auto preset = library.presets[i];
+                                      preset.name = "import " + std::to_string(i);
+                                      for (float& position : preset.positions) position = std::min(position + 1e-6f, 1.0f);
+                                      if (preset.colors.size() >= 3) {
+                                          std::swap(preset.colors[0], preset.colors[1]);
+                                          std::swap(preset.positions[0], preset.positions[1]);
+                                          std::swap(preset.midpoints[0], preset.midpoints[1]);
+                                      }
+                                      presets.push_back(std::move(preset));
+                                  }
+                                  return presets;
+                              }();
+                              static preset_hash::PresetDedupIndex index;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  library.presets.resize(10000);
+                                  ++library.revision;
+                                  index.sync(library);
+
+                                  uint32_t duplicate_count = 0;
+                                  for (const auto& source : incoming) {
+                                      auto preset = preset_hash::canonicalize(source);
+                                      if (index.findDuplicate(preset)) {
+                                          ++duplicate_count;
+                                          continue;
+                                      }
+                                      preset.name = index.uniqueName(preset.name);
+                                      library.presets.push_back(std::move(preset));
+                                      ++library.revision;
+                                      index.add(library);
+                                  }
+                                  if (duplicate_count != 5000) std::abort();  // 同じ内容を見逃していない
+                                  consume(duplicate_count);
+                              }
+                          }});
+
+    // CPU での評価と検索
+    benchmarks.push_back({"preset_eval/sample_oklab_256", [](const uint64_t n) {
+                              std::vector<preset_eval::Oklab> samples(256);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  preset_eval::sampleOklab(file.presets[i % PRESET_COUNT], samples);
+                                  consume(static_cast<uint64_t>(samples[128].x * 1e6f));
+                              }
+                          }});
+    benchmarks.push_back({"preset_search/make_signature", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  const auto signature = preset_search::makeSignature(file.presets[i % PRESET_COUNT]);
+                                  consume(static_cast<uint64_t>(signature[0] * 1e6f));
+                              }
+                          }});
+    benchmarks.push_back({"preset_search/build_1000", [](const uint64_t n) {
+                              preset_search::PresetSearchIndex index;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  index.build(file);
+                                  consume(index.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_search/find_similar_k10", [](const uint64_t n) {
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  search_index.findSimilar(search_index.signature(static_cast<uint32_t>(i % PRESET_COUNT)), 10, out);
+                                  consume(out.front());
+                              }
+                          }});
+    benchmarks.push_back({"preset_search/find_by_name", [](const uint64_t n) {
+                              static constexpr std::string_view QUERIES[] = {"preset 1", "set 42", "7", "none"};
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  search_index.findByName(QUERIES[i % std::size(QUERIES)], out);
+                                  consume(out.size());
+                              }
+                          }});
+
+    // 10 万個での検索。入力のたびに行うため、いずれも 1 ms 以内を目標にする
+    constexpr uint32_t LARGE_PRESET_COUNT = 100000;
+    constexpr double SEARCH_TARGET_NS     = 1e6;
+    static const auto large_search_index = [] {
+        static const preset_file::GradientPresetFile large_file = makePresetFile(LARGE_PRESET_COUNT);
+        auto index = std::make_unique<preset_search::PresetSearchIndex>();
+        index->build(large_file);
+        return index;
+    };
+    benchmarks.push_back({"preset_search/build_100000", [](const uint64_t n) {
+                              static const preset_file::GradientPresetFile large_file = makePresetFile(LARGE_PRESET_COUNT);
+                              preset_search::PresetSearchIndex index;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  index.build(large_file);
+                                  consume(index.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_search/find_similar_k10_100000", [](const uint64_t n) {
+                              static const auto index = large_search_index();
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  index->findSimilar(index->signature(static_cast<uint32_t>(i * 7919 % LARGE_PRESET_COUNT)), 10, out);
+                                  consume(out.front());
+                              }
+                          },
+                          0, SEARCH_TARGET_NS});
+    benchmarks.push_back({"preset_search/find_similar_color_k10_100000", [](const uint64_t n) {
+                              static const auto index = large_search_index();
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  const auto rgba = static_cast<uint32_t>(i * 0x9E3779B1u) | 0xFF;
+                                  index->findSimilar(preset_search::makeSignature(rgba), 10, out);
+                                  consume(out.front());
+                              }
+                          },
+                          0, SEARCH_TARGET_NS});
+    benchmarks.push_back({"preset_search/find_by_prefix_100000", [](const uint64_t n) {
+                              static constexpr std::string_view QUERIES[] = {"preset 1", "preset 4242", "pre", "none"};
+                              static const auto index                     = large_search_index();
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  index->findByPrefix(QUERIES[i % std::size(QUERIES)], out);
+                                  consume(out.size());
+                              }
+                          },
+                          0, SEARCH_TARGET_NS});
+    benchmarks.push_back({"preset_search/find_by_name_100000", [](const uint64_t n) {
+                              static constexpr std::string_view QUERIES[] = {"preset 1", "set 42", "7", "none"};
+                              static const auto index                     = large_search_index();
+                              std::vector<uint32_t> out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  index->findByName(QUERIES[i % std::size(QUERIES)], out);
+                                  consume(out.size());
+                              }
+                          },
+                          0, SEARCH_TARGET_NS});
+
+    // 読み込み
+    benchmarks.push_back({"preset_import/parse_ggr_64", [](const uint64_t n) {
+                              static const std::string text = makeGgr(64);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::istringstream in{text};
+                                  consume(preset_import::parseGgr(in, "bench").front().colors.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_import/parse_css_16", [](const uint64_t n) {
+                              static const std::string text = makeCss(16);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::istringstream in{text};
+                                  consume(preset_import::parseCss(in, "bench").front().colors.size());
+                              }
+                          }});
+    benchmarks.push_back({"preset_import/resample_129_to_30", [](const uint64_t n) {
+                              static const preset::GradientPreset source = [] {
+                                  std::istringstream in{makeGgr(64)};
+                                  return preset_import::parseGgr(in, "bench").front();
+                              }();
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  preset::GradientPreset preset = source;
+                                  preset_import::resampleStops(preset, 30);
+                                  consume(preset.colors.size());
+                              }
+                          }});
+
+    // エイリアス
+    static const std::string alias_text = makeAlias(30);
+    benchmarks.push_back({"alias/parse_30_markers", [](const uint64_t n) {
+                              alias_parser::AliasDocument document;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  document.parse(alias_text);
+                                  consume(document.findSection("Object.1") != nullptr);
+                              }
+                          },
+                          alias_text.size()});
+    // 反映 1 回分。エイリアス全体を解析し、動く項目 (位置、透明度) をすべて書き換えて書き出す
+    benchmarks.push_back({"alias/parse_patch_serialize_30_markers", [](const uint64_t n) {
+                              static const std::vector<std::string> keys = [] {
+                                  std::vector<std::string> keys;
+                                  for (uint32_t i = 1; i <= 30; ++i) {
+                                      keys.push_back("位置" + std::to_string(i));
+                                      keys.push_back("透明度" + std::to_string(i));
+                                  }
+                                  return keys;
+                              }();
+                              alias_parser::AliasDocument document;
+                              std::string out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  document.parse(alias_text);
+                                  const auto* section = document.findEffectSection("グラデーション編集@GradientEditor", 0);
+                                  if (!section) std::abort();
+                                  for (const auto& key : keys) document.setToken(*section, key, 1, "12.345");
+                                  out.clear();
+                                  document.serialize(out);
+                                  consume(out.size());
+                              }
+                          },
+                          alias_text.size()});
+    benchmarks.push_back({"alias/set_token_serialize", [](const uint64_t n) {
+                              static const std::string text = makeAlias(30);
+                              alias_parser::AliasDocument document;
+                              document.parse(text);
+                              const auto* section = document.findEffectSection("グラデーション編集@GradientEditor", 0);
+                              if (!section) std::abort();
+                              std::string out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  document.clearPatches();
+                                  document.setToken(*section, "位置1", 1, "12.345");
+                                  out.clear();
+                                  document.serialize(out);
+                                  consume(out.size());
+                              }
+                          }});
+    // セクション 64 個、エフェクト 20 個のエイリアスのフレーム数。正規表現による以前の実装との比較
+    static const std::string large_alias = makeLargeAlias(64, 20);
+    if (alias_parser::getFrameCount(large_alias) != 64 || regexGetFrameCount(large_alias) != 64) std::abort();
+    benchmarks.push_back({"alias/frame_count_64_sections", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) consume(static_cast<uint64_t>(alias_parser::getFrameCount(large_alias)));
+                          }});
+    benchmarks.push_back({"alias/frame_count_64_sections_regex", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) consume(static_cast<uint64_t>(regexGetFrameCount(large_alias)));
+                          }});
+    benchmarks.push_back({"alias/nth_token", [](const uint64_t n) {
+                              static constexpr std::string_view LINE = "0.000,12.000,0.500,1.000,linear";
+                              for (uint64_t i = 0; i < n; ++i) consume(alias_parser::getNthTokenView(LINE, static_cast<uint32_t>(i % 5)).size());
+                          }});
+    // 中間点のある区間 (複数のセクション) へ同じ値を書き込む。範囲の置換と、セクションごとの置換の比較
+    benchmarks.push_back({"alias/replace_range_4_sections", [](const uint64_t n) {
+                              static constexpr std::string_view LINE = "0.000,12.000,0.500,1.000,24.000,linear";
+                              std::string out;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  out.clear();
+                                  alias_parser::appendReplacedTokenRange(out, LINE, 1, 4, "12.345");
+                                  consume(out.size());
+                              }
+                          }});
+    benchmarks.push_back({"alias/replace_each_4_sections", [](const uint64_t n) {
+                              static constexpr std::string_view LINE = "0.000,12.000,0.500,1.000,24.000,linear";
+                              std::string line;
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  line = LINE;
+                                  for (uint32_t section = 1; section <= 4; ++section) line = alias_parser::replaceNthToken(line, section, "12.345");
+                                  consume(line.size());
+                              }
+                          }});
+
+    // 文字列の変換
+    benchmarks.push_back({"str_conv/utf8_wide_round_trip", [](const uint64_t n) {
+                              static const std::string text = "グラデーション編集@GradientEditor:位置12";
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  consume(str_conv::wideCharToMultiByte(str_conv::multiByteToWideChar(text)).size());
+                              }
+                          }});
+
+    // プロファイラ。有効な区間は 50 ns 以内に記録できること
+    benchmarks.push_back({"frame_profiler/zone", [](const uint64_t n) {
+                              frame_profiler::setEnabled(true);
+                              for (uint64_t i = 0; i < n; ++i) frame_profiler::ScopedZone zone{"bench"};
+                              frame_profiler::setEnabled(false);
+                          }});
+    benchmarks.push_back({"frame_profiler/zone_disabled", [](const uint64_t n) {
+                              for (uint64_t i = 0; i < n; ++i) frame_profiler::ScopedZone zone{"bench"};
+                          }});
+
+    // ログ。積んでから、出力するスレッドが数えるだけのシンクに渡し終えるまで
+    static std::atomic<uint64_t> log_written_count{0};
+    static const auto start_logger = [](async_log::AsyncLogger& logger) {
+        // 出力数の制限で捨てずにシンクまで届くようにする
+        if (!logger.isRunning()) logger.start([](const async_log::LogRecord&) { log_written_count.fetch_add(1, std::memory_order_relaxed); }, UINT32_MAX);
+    };
+    benchmarks.push_back({"async_log/push_flush", [](const uint64_t n) {
+                              static async_log::AsyncLogger logger;
+                              start_logger(logger);
+                              for (uint64_t i = 0; i < n; ++i) logger.push({.level = async_log::LogLevel::Info, .text = "preset loaded"});
+                              logger.flush();
+                              consume(log_written_count.load(std::memory_order_relaxed));
+                          }});
+    benchmarks.push_back({"async_log/format_push_flush", [](const uint64_t n) {
+                              static async_log::AsyncLogger logger;
+                              start_logger(logger);
+                              for (uint64_t i = 0; i < n; ++i) logger.push(async_log::formatRecord(async_log::LogLevel::Info, "preset {} loaded in {} ms", i, 1.5));
+                              logger.flush();
+                              consume(log_written_count.load(std::memory_order_relaxed));
+                          }});
+
+    // スレッドプール。1 回はタスクを積んでから実行が終わるまで
+    benchmarks.push_back({"thread_pool/submit_1000", [](const uint64_t n) {
+                              static gradient_editor::ThreadPool pool;
+                              pool.start();
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::latch done{1000};
+                                  for (uint32_t j = 0; j < 1000; ++j) {
+                                      pool.submit(gradient_editor::TaskPriority::Interactive, [&done](std::stop_token) { done.count_down(); });
+                                  }
+                                  done.wait();
+                              }
+                          }});
+
+    // ワーカー数によるスケーリング。1 回あたり約 2 µs の計算を 1000 個実行する
+    const auto run_parallel = [](gradient_editor::ThreadPool& pool, const uint64_t n) {
+        for (uint64_t i = 0; i < n; ++i) {
+            std::latch done{1000};
+            for (uint32_t j = 0; j < 1000; ++j) {
+                pool.submit(gradient_editor::TaskPriority::Background, [&done, j](std::stop_token) {
+                    Random random{j + 1ull};
+                    uint64_t value = 0;
+                    for (int k = 0; k < 1000; ++k) value += random.next();
+                    consume(value);
+                    done.count_down();
+                });
+            }
+            done.wait();
+        }
+    };
+    for (const uint32_t worker_count : {1u, 2u, 4u, 8u}) {
+        benchmarks.push_back({"thread_pool/parallel_1000_x" + std::to_string(worker_count), [run_parallel, worker_count](const uint64_t n) {
+                                  static std::vector<std::unique_ptr<gradient_editor::ThreadPool>> pools;
+                                  if (pools.size() <= worker_count) pools.resize(worker_count + 1);
+                                  auto& pool = pools[worker_count];
+                                  if (!pool) {
+                                      pool = std::make_unique<gradient_editor::ThreadPool>();
+                                      pool->start(worker_count);
+                                  }
+                                  run_parallel(*pool, n);
+                              }});
+    }
+
+    // 待機中のワーカーを起こして 1 個のタスクを実行し、完了を受け取るまでの時間
+    benchmarks.push_back({"thread_pool/latency_idle", [](const uint64_t n) {
+                              static gradient_editor::ThreadPool pool;
+                              pool.start(2);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::latch done{1};
+                                  pool.submit(gradient_editor::TaskPriority::Interactive, [&done](std::stop_token) { done.count_down(); });
+                                  done.wait();
+                              }
+                          }});
+
+    // 約 20 µs の Background のタスクが 64 個積まれている状態で、Interactive のタスクが完了するまでの時間。
+    // 優先度がなければ、ワーカー 2 個で約 640 µs 待つ。残った Background のタスクは取り消す
+    benchmarks.push_back({"thread_pool/latency_interactive_behind_background", [](const uint64_t n) {
+                              static gradient_editor::ThreadPool pool;
+                              pool.start(2);
+                              for (uint64_t i = 0; i < n; ++i) {
+                                  std::stop_source background_stop;
+                                  for (uint32_t j = 0; j < 64; ++j) {
+                                      pool.submit(
+                                          gradient_editor::TaskPriority::Background,
+                                          [j](std::stop_token) {
+                                              Random random{j + 1ull};
+                                              uint64_t value = 0;
+                                              for (int k = 0; k < 10000; ++k) value += random.next();
+                                              consume(value);
+                                          },
+                                          background_stop.get_token());
+                                  }
+                                  std::latch done{1};
+                                  pool.submit(gradient_editor::TaskPriority::Interactive, [&done](std::stop_token) { done.count_down(); });
+                                  done.wait();
+                                  background_stop.request_stop();
+                              }
+                          }});
+
+    return benchmarks;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::string_view filter;
+    double min_time_s = 0.5;
+    bool is_list      = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--filter=")) {
+            filter = arg.substr(9);
+        } else if (arg.starts_with("--min-time=")) {
+            min_time_s = std::atof(argv[i] + 11);
+        } else if (arg == "--list") {
+            is_list = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--list]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!is_list) std::printf("%-40s %14s %14s %14s %10s %12s\n", "benchmark", "iterations", "median ns/op", "min ns/op", "MB/s", "target ns");
+    bool is_over_target = false;
+    for (const auto& benchmark : makeBenchmarks()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+        if (is_list) {
+            std::printf("%s\n", benchmark.name.c_str());
+            continue;
+        }
+        const Result result = measure(benchmark, std::chrono::duration<double>(min_time_s));
+        std::printf("%-40s %14llu %14.1f %14.1f", benchmark.name.c_str(), static_cast<unsigned long long>(result.iterations),
+                    result.median_ns, result.min_ns);
+        // 中央値の時間で処理したバイト数 (1 MB = 10^6 バイト)
+        if (benchmark.bytes_per_op > 0) {
+            std::printf(" %10.1f", static_cast<double>(benchmark.bytes_per_op) * 1e3 / result.median_ns);
+        } else if (benchmark.target_ns > 0) {
+            std::printf(" %10s", "");
+        }
+        if (benchmark.target_ns > 0) {
+            const bool is_over = result.median_ns > benchmark.target_ns;
+            std::printf(" %12.0f%s", benchmark.target_ns, is_over ? "  OVER" : "");
+            is_over_target |= is_over;
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return is_over_target ? 1 : 0;
+}
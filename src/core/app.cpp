@@ -1,9 +1,15 @@
 #include "core/app.h"
 
+#include <chrono>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "IconsMaterialSymbols.h"
 #include "core/constants.h"
+#include "core/frame_pacer.h"
 #include "fonts/material_symbols.cpp"
 #include "imgui.h"
 #include "imgui_impl_dx11.h"
@@ -12,6 +18,7 @@
 #include "ui/widgets/gradient_widget.h"
 #include "utils/common/color_conv.h"
 #include "utils/common/font_loader.h"
+#include "utils/common/frame_arena.h"
 
 namespace gradient_editor {
 
@@ -31,8 +38,9 @@ void App::run(std::promise<HWND>&& hwnd_promise)
     ImGui_ImplWin32_EnableDpiAwareness();
     float main_scale = ImGui_ImplWin32_GetDpiScaleForMonitor(::MonitorFromPoint(POINT{0, 0}, MONITOR_DEFAULTTOPRIMARY));
 
-    // ウィンドウの作成
-    if (!g_app_state.window_manager.createPluginWindow(WINDOW_NAME_DEFAULT, main_scale, wnd_proc)) {
+    // ウィンドウの作成。ホストはウィンドウハンドルを受け取るまで待つため、ここまでを先に済ませる
+    m_startup.add("window", [&] { return g_app_state.window_manager.createPluginWindow(WINDOW_NAME_DEFAULT, main_scale, wnd_proc); });
+    if (!m_startup.runPending()) {
         hwnd_promise.set_exception(std::make_exception_ptr(std::runtime_error("Failed to create window")));
         return;
     }
@@ -40,37 +48,86 @@ void App::run(std::promise<HWND>&& hwnd_promise)
     HWND hwnd = g_app_state.window_manager.getWindowHandle();
     hwnd_promise.set_value(hwnd);
 
-    if (!initialize(hwnd)) {
-        return;
-    }
-
     ::ShowWindow(hwnd, SW_SHOWDEFAULT);
     ::UpdateWindow(hwnd);
 
-    m_main_view = std::make_unique<MainView>();
-
-    // WM_SIZE で ImGui のレンダリング処理を呼び出すために保存する
-    g_app_state.render = [this]() {
-        renderFrame();
-    };
+    // 重い初期化はパネルが初めて表示されるまで遅らせる
+    scheduleDeferredPhases(hwnd);
 
+    // 入力などのイベントがない間は描画せずにメッセージを待ち、アイドル時の CPU 使用率を抑える
+    FramePacer pacer;
     bool done = false;
     while (!done) {
+        DWORD wait_timeout = STARTUP_VISIBILITY_POLL_INTERVAL_MS;
+        if (m_main_view) {
+            wait_timeout = static_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(pacer.waitTimeout(FramePacer::Clock::now())).count());
+        }
+        if (wait_timeout > 0) {
+            ::MsgWaitForMultipleObjectsEx(0, nullptr, wait_timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        }
+
         MSG msg;
+        bool has_message = false;
         while (::PeekMessage(&msg, nullptr, 0U, 0U, PM_REMOVE)) {
             ::TranslateMessage(&msg);
             ::DispatchMessage(&msg);
             if (msg.message == WM_QUIT)
                 done = true;
+            has_message = true;
         }
+
+        // 他のスレッドからのコマンド。届いた時点で WM_NULL で起こされている
+        g_app_state.commands.drain([&]<typename Command>(Command& command) {
+            if constexpr (std::is_same_v<Command, gui_command::RequestRender>) {
+                has_message = true;
+            } else if constexpr (std::is_same_v<Command, gui_command::WindowRegistered>) {
+                m_is_window_registered = true;
+            } else if constexpr (std::is_same_v<Command, gui_command::Quit>) {
+                done = true;
+            } else if constexpr (std::is_same_v<Command, gui_command::Continuation>) {
+                // renderFrame() で実行する
+                m_continuations.push_back(std::move(command.run));
+                has_message = true;
+            }
+        });
         if (done) break;
 
+        if (!m_main_view) {
+            // 親のパネルが表示されても子ウィンドウにはメッセージが届かない場合があるため、一定の間隔でも確かめる
+            if (!isPanelVisible(hwnd)) continue;
+
+            m_startup.mark("wait_visible", true);
+            if (!m_startup.runPending()) {
+                g_app_state.log.error("Failed to initialize: {}", m_startup.report());
+                break;
+            }
+            has_message = true;
+        }
+
+        const auto now = FramePacer::Clock::now();
+        if (has_message) pacer.notifyEvent(now);
+        if (!pacer.shouldRender(now)) continue;
+
         renderFrame();
+        pacer.onFrameRendered(now);
+        pacer.setBusy(m_main_view->isBusy());
+
+        if (!m_is_startup_reported) {
+            m_startup.mark("first_frame");
+            g_app_state.log.info("Startup: {}", m_startup.report());
+            m_is_startup_reported = true;
+        }
     }
 }
 
 void App::renderFrame()
 {
+    // 前のフレームの一時的なオブジェクトを解放する
+    frame_arena::get().reset();
+
+    // ワーカースレッドの処理の続き。遮蔽されていて描画しない場合も結果は反映する
+    for (auto& continuation : std::exchange(m_continuations, {})) continuation();
+
     if (g_app_state.d3d_manager.isSwapChainOccluded() && g_app_state.d3d_manager.getSwapChain()->Present(0, DXGI_PRESENT_TEST) == DXGI_STATUS_OCCLUDED) {
         ::Sleep(10);
         return;
@@ -105,20 +162,49 @@ void App::renderFrame()
     g_app_state.d3d_manager.setSwapChainOccluded(hr == DXGI_STATUS_OCCLUDED);
 }
 
-bool App::initialize(HWND hwnd)
+void App::scheduleDeferredPhases(HWND hwnd)
 {
-    if (!g_app_state.d3d_manager.initialize(hwnd)) {
+    m_startup.add("d3d", [hwnd] {
+        if (g_app_state.d3d_manager.initialize(hwnd)) return true;
         g_app_state.d3d_manager.cleanup();
         g_app_state.window_manager.unregisterClass();
         return false;
-    }
-
-    setupImGui(hwnd);
-    setupFonts();
-    applyCustomColors();
-    CustomUI::initDX11(g_app_state.d3d_manager.getDevice(), g_app_state.d3d_manager.getDeviceContext());
+    });
+    m_startup.add("imgui", [this, hwnd] {
+        setupImGui(hwnd);
+        applyCustomColors();
+        m_is_imgui_initialized = true;
+        return true;
+    });
+    m_startup.add("fonts", [this] {
+        setupFonts();
+        return true;
+    });
+    m_startup.add("shaders", [] {
+        CustomUI::initDX11(g_app_state.d3d_manager.getDevice(), g_app_state.d3d_manager.getDeviceContext());
+        return true;
+    });
+    m_startup.add("thread_pool", [] {
+        g_app_state.thread_pool.start();
+        return true;
+    });
+    // プリセットの読み込みを開始する
+    m_startup.add("main_view", [this] {
+        m_main_view = std::make_unique<MainView>();
+
+        // WM_SIZE で ImGui のレンダリング処理を呼び出すために保存する
+        g_app_state.render = [this]() {
+            renderFrame();
+        };
+        return true;
+    });
+}
 
-    return true;
+bool App::isPanelVisible(HWND hwnd) const
+{
+    // ホストのパネルに登録されるまでは、トップレベルのウィンドウとして表示されているだけなので待つ
+    if (!m_is_window_registered) return false;
+    return ::IsWindowVisible(hwnd) && !::IsIconic(hwnd);
 }
 
 void App::setupImGui(HWND hwnd)
@@ -161,17 +247,24 @@ void App::setupFonts()
 
     // sytle.conf からフォント名を取得
     FONT_INFO* font_info = g_app_state.config->get_font_info(g_app_state.config, "DefaultFamily");
-    // フォント名からフォントデータを取得
-    std::vector<unsigned char> font_data = getFontDataByName(font_info->name);
+    // フォント名からフォントファイルを探し、メモリマップする。見つからない場合は既定のフォントを使う
+    float font_size                           = font_info->size;
+    std::optional<SystemFontFile> system_font = findSystemFontFile(font_info->name);
+    if (!system_font || !m_font_file.open(system_font->path, system_font->face_index)) {
+        font_size = DEFAULT_FONT_SIZE;
+        m_font_file.open(FALLBACK_FONT_PATH);
+    }
 
-    if (!font_data.empty()) {
-        // AddFontFromMemoryTTF() はバッファの所有権をフォントアトラスに転送し、フォントアトラス破棄時にバッファを解放する
+    if (m_font_file.isOpen()) {
+        // フォントデータはコピーせず、マップした領域をフォントアトラスに参照させる。m_font_file はフォントアトラスより長く保持する
+        // グリフは動的なフォントアトラスが使う時にラスタライズするため、起動時に読むのはフォントのテーブルのみ
         // https://github.com/ocornut/imgui/blob/master/docs/FONTS.md#loading-font-data-from-memory
-        void* buffer = malloc(font_data.size());
-        memcpy(buffer, font_data.data(), font_data.size());
-        io.Fonts->AddFontFromMemoryTTF(buffer, static_cast<int>(font_data.size()), font_info->size, &config1);
+        config1.FontDataOwnedByAtlas               = false;
+        config1.FontNo                             = static_cast<int>(m_font_file.faceIndex());
+        const std::span<const std::byte> font_data = m_font_file.bytes();
+        io.Fonts->AddFontFromMemoryTTF(const_cast<std::byte*>(font_data.data()), static_cast<int>(font_data.size()), font_size, &config1);
     } else {
-        io.Fonts->AddFontFromFileTTF("C:\\Windows\\Fonts\\YuGothM.ttc", DEFAULT_FONT_SIZE, &config1);
+        io.Fonts->AddFontDefault(&config1);
     }
 
     // アイコンフォントの設定
@@ -185,12 +278,19 @@ void App::setupFonts()
 void App::cleanup()
 {
     g_app_state.render = nullptr;
+    // タスクや処理の続きが MainView を参照するため、先に停止・破棄する
+    g_app_state.thread_pool.shutdown();
+    m_continuations.clear();
     m_main_view.reset();
     CustomUI::cleanup();
 
-    ImGui_ImplDX11_Shutdown();
-    ImGui_ImplWin32_Shutdown();
-    ImGui::DestroyContext();
+    // パネルが一度も表示されずに終了した場合は ImGui を初期化していない
+    if (m_is_imgui_initialized) {
+        ImGui_ImplDX11_Shutdown();
+        ImGui_ImplWin32_Shutdown();
+        ImGui::DestroyContext();
+        m_is_imgui_initialized = false;
+    }
 
     g_app_state.d3d_manager.cleanup();
 }
@@ -1,16 +1,20 @@
 #ifndef APP_H
 #define APP_H
 
+#include <functional>
 #include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
 
 #include "core/app_state.h"
+#include "core/startup_phases.h"
 #include "ui/main_view.h"
+#include "utils/common/font_file.h"
 
 namespace gradient_editor {
 
@@ -23,12 +27,20 @@ public:
     void renderFrame();
 
 private:
-    bool initialize(HWND hwnd);
+    /// @brief パネルが初めて表示された時に実行する初期化を予約する
+    void scheduleDeferredPhases(HWND hwnd);
+    bool isPanelVisible(HWND hwnd) const;
     void setupImGui(HWND hwnd);
     void setupFonts();
     void cleanup();
 
     std::unique_ptr<MainView> m_main_view;
+    font_file::MappedFont m_font_file;  // フォントアトラスが参照するため、cleanup() で ImGui を破棄するまで保持する
+    StartupPhases m_startup;
+    std::vector<std::move_only_function<void()>> m_continuations;  // gui_command::Continuation。renderFrame() で実行する
+    bool m_is_window_registered = false;  // gui_command::WindowRegistered を受け取ったか
+    bool m_is_imgui_initialized = false;
+    bool m_is_startup_reported  = false;
 };
 
 }  // namespace gradient_editor
@@ -4,40 +4,75 @@
 #include <d3d11.h>
 
 #include <atomic>
+#include <filesystem>
 #include <functional>
 #include <thread>
+#include <vector>
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
 
 #include "aviutl2_sdk.h"
 #include "d3d_manager.h"
+#include "gui_command_queue.h"
+#include "thread_pool.h"
+#include "utils/aviutl2/logger_wrapper.h"
 #include "window_manager.h"
 
 namespace gradient_editor {
 
 /// @brief アプリケーション全体の状態を管理する構造体
+/// @note ホストのスレッドと GUI スレッドの間で直接書き換えず、GUI スレッドへは post() でコマンドを送る
 struct ApplicationState {
-    // AviUtl2 SDK ハンドラー
+    // AviUtl2 SDK ハンドラー。GUI スレッドを開始する前にホストのスレッドで設定し、以降は読み取りのみ
     EDIT_HANDLE* edit_handle = nullptr;
     LOG_HANDLE* logger       = nullptr;
     CONFIG_HANDLE* config    = nullptr;
 
+    // ログの出力。整形以外はバックグラウンドのスレッドで行う
+    LoggerWrapper log;
+
     // マネージャー
     D3DManager d3d_manager;
     WindowManager window_manager;
 
     // スレッド
     std::thread gui_thread;
+    ThreadPool thread_pool;  // GUI スレッドで開始・停止する
+
+    // GUI スレッドへのコマンド
+    GuiCommandQueue commands;
 
-    // WM_SIZE で呼ぶためのコールバック
+    // WM_SIZE で呼ぶためのコールバック。GUI スレッドでのみ読み書きする
     std::move_only_function<void()> render;
 
+    // WM_DROPFILES で受け取ったファイル。GUI スレッドでのみ読み書きする
+    std::vector<std::filesystem::path> dropped_files;
+
+    /// @brief GUI スレッドにコマンドを送り、待機中であれば起こす。どのスレッドから呼んでもよい
+    /// @note ウィンドウの作成前に送ったコマンドは、メッセージループの開始時に処理される
+    void post(GuiCommand command)
+    {
+        if (!commands.post(std::move(command))) return;  // 起こした後、まだ処理されていない
+        if (HWND hwnd = window_manager.getWindowHandle()) {
+            ::PostMessageW(hwnd, WM_NULL, 0, 0);
+        }
+    }
+
+    /// @brief 待機中の GUI スレッドを起こして次のフレームを描画させる。どのスレッドから呼んでもよい
+    void requestRender() { post(gui_command::RequestRender{}); }
+
+    /// @brief 次のフレームの描画の前に GUI スレッドで func を実行させる。どのスレッドから呼んでもよい
+    /// @note ワーカースレッドの結果を UI に反映するために使う
+    void runOnGui(std::move_only_function<void()> func) { post(gui_command::Continuation{std::move(func)}); }
+
     void cleanup()
     {
         if (gui_thread.joinable()) {
             gui_thread.join();
         }
+        thread_pool.shutdown();
+        log.stop();
     }
 };
 
@@ -34,7 +34,12 @@ constexpr float ICON_FONT_GLYPHOFFSET_Y = 1.5f;
 constexpr const wchar_t* WINDOW_NAME_DEFAULT = L"GradientEditor";
 constexpr const char* PRESET_FOLDER_NAME     = "GradientEditorPreset";
 constexpr const char* PRESET_FILE_NAME       = "gradient_editor_preset.json";
+constexpr const char* TRACE_FILE_NAME        = "gradient_editor_trace.json";
 constexpr const wchar_t* PLUGIN_INFORMATION  = L"Gradient Editor for AviUtl2";
+constexpr const wchar_t* FALLBACK_FONT_PATH  = L"C:\\Windows\\Fonts\\YuGothM.ttc";
+
+// 初期化を遅らせている間、パネルが表示されたかを確かめる間隔
+constexpr uint32_t STARTUP_VISIBILITY_POLL_INTERVAL_MS = 250;
 
 #ifdef MARKER_COUNT
 inline constexpr uint32_t MAX_MARKER_COUNT = MARKER_COUNT;
@@ -49,6 +54,8 @@ inline constexpr const wchar_t* EFFECT_NAMES[]    = {
 
 constexpr const char* COLOR_SPACE_NAMES[] = {"sRGB", "Linear sRGB", "HSV", "HSL", "L*a*b", "LCh", "Oklab", "Oklch"};
 inline const char* INTERP_DIR_NAMES[]     = {reinterpret_cast<const char*>(u8"短経路"), reinterpret_cast<const char*>(u8"長経路")};
+// 補間経路の表示名の翻訳のキー。INTERP_DIR_NAMES はスクリプトに書き込む値のため翻訳しない
+inline constexpr const wchar_t* INTERP_DIR_LABEL_KEYS[] = {L"短経路", L"長経路"};
 
 }  // namespace gradient_editor
 
@@ -0,0 +1,73 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <algorithm>
+#include <chrono>
+
+namespace gradient_editor {
+
+/// @brief GUI スレッドでいつフレームを描画するかを決めるクラス
+/// @note 入力などのイベントがあった直後と、バックグラウンドの処理が続いている間だけ毎フレーム描画し、
+///       それ以外は idle_interval ごとに 1 回だけ描画する。
+///       時刻はすべて引数で受け取るため、プラットフォームや実際の時計に依存せずに判断を確かめられる
+class FramePacer {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+
+    struct Config {
+        // 最後のイベントから毎フレーム描画を続ける時間。ImGui はクリックの結果やツールチップを後のフレームで表示するため
+        std::chrono::milliseconds active_duration{1000};
+        // 何も起きていない間に描画する間隔。テキスト入力のカーソルの点滅など、時間だけで変わる表示のため
+        std::chrono::milliseconds idle_interval{500};
+    };
+
+    FramePacer() = default;
+
+    explicit FramePacer(const Config& config)
+        : m_config{config}
+    {
+    }
+
+    /// @brief 入力やホストからの通知など、表示が変わりうるイベントがあったことを知らせる
+    void notifyEvent(const TimePoint now) noexcept
+    {
+        m_active_until = std::max(m_active_until, now + m_config.active_duration);
+    }
+
+    /// @brief アニメーションやバックグラウンドの処理など、毎フレームの描画が必要な状態かを設定する
+    void setBusy(const bool is_busy) noexcept { m_is_busy = is_busy; }
+
+    /// @brief 現在のフレームを描画するか
+    [[nodiscard]] bool shouldRender(const TimePoint now) const noexcept
+    {
+        return m_is_busy || !m_has_rendered || now < m_active_until || now - m_last_render >= m_config.idle_interval;
+    }
+
+    /// @brief 次に描画するまでイベントを待ってよい時間
+    /// @return 今すぐ描画する場合は 0
+    [[nodiscard]] Duration waitTimeout(const TimePoint now) const noexcept
+    {
+        if (shouldRender(now)) return Duration::zero();
+        return m_last_render + m_config.idle_interval - now;
+    }
+
+    /// @brief フレームを描画したことを知らせる
+    void onFrameRendered(const TimePoint now) noexcept
+    {
+        m_last_render  = now;
+        m_has_rendered = true;
+    }
+
+private:
+    Config m_config;
+    TimePoint m_active_until{};
+    TimePoint m_last_render{};
+    bool m_has_rendered = false;
+    bool m_is_busy      = false;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !FRAME_PACER_H
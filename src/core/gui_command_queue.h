@@ -0,0 +1,73 @@
+#ifndef GUI_COMMAND_QUEUE_H
+#define GUI_COMMAND_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <variant>
+
+#include "utils/common/mpsc_queue.h"
+
+namespace gradient_editor {
+
+/// @brief 他のスレッドから GUI スレッドに送るコマンド
+namespace gui_command {
+
+/// @brief 次のフレームを描画させる
+struct RequestRender {};
+
+/// @brief ホストのパネルにウィンドウを登録した
+struct WindowRegistered {};
+
+/// @brief メッセージループを終了させる
+struct Quit {};
+
+/// @brief ワーカースレッドの処理の続きを、次のフレームの描画の前に GUI スレッドで実行させる
+struct Continuation {
+    std::move_only_function<void()> run;
+};
+
+}  // namespace gui_command
+
+using GuiCommand = std::variant<gui_command::RequestRender, gui_command::WindowRegistered, gui_command::Quit, gui_command::Continuation>;
+
+/// @brief 他のスレッドから GUI スレッドへコマンドを渡すキュー
+/// @note post() はどのスレッドから呼んでもロックを取らない。drain() は GUI スレッドからのみ呼ぶ。
+///       GUI スレッドを起こす処理は呼び出し側が行うため、プラットフォームに依存しない
+class GuiCommandQueue {
+public:
+    /// @brief コマンドを積む
+    /// @return GUI スレッドを起こす必要がある場合は true。次の drain() までに積んだ 2 つ目以降は false
+    bool post(GuiCommand command)
+    {
+        m_queue.push(std::move(command));
+        return !m_is_wake_pending.exchange(true, std::memory_order_acq_rel);
+    }
+
+    /// @brief 積まれているコマンドを順に handler に渡す
+    /// @param handler すべてのコマンドの型を (非 const の参照で) 受け取れる関数オブジェクト
+    /// @return 処理したコマンドの数
+    template <typename Handler>
+    size_t drain(Handler&& handler)
+    {
+        // 取り出す前に下ろし、取り出している間に積まれたコマンドでも GUI スレッドを起こさせる。
+        // 読み書きを同時に行うことで、フラグを立てたスレッドが積んだコマンドを確実に読める
+        m_is_wake_pending.exchange(false, std::memory_order_acq_rel);
+
+        size_t count = 0;
+        while (auto command = m_queue.pop()) {
+            std::visit(handler, *command);
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    MpscQueue<GuiCommand> m_queue;
+    std::atomic<bool> m_is_wake_pending{false};  // GUI スレッドを起こしてから drain() していないか
+};
+
+}  // namespace gradient_editor
+
+#endif  // !GUI_COMMAND_QUEUE_H
@@ -0,0 +1,37 @@
+#include "core/linked_gradient_group.h"
+
+#include <algorithm>
+
+namespace gradient_editor {
+
+bool LinkedGradientGroup::add(OBJECT_HANDLE object, const int32_t effect_index)
+{
+    if (!object) return false;
+
+    auto it = std::ranges::find(m_targets, object, &LinkedTarget::object);
+    if (it != m_targets.end()) {
+        it->effect_index = effect_index;
+        return false;
+    }
+    m_targets.push_back({object, effect_index});
+    return true;
+}
+
+bool LinkedGradientGroup::remove(OBJECT_HANDLE object)
+{
+    return std::erase_if(m_targets, [&](const LinkedTarget& target) { return target.object == object; }) > 0;
+}
+
+bool LinkedGradientGroup::contains(OBJECT_HANDLE object) const
+{
+    return std::ranges::find(m_targets, object, &LinkedTarget::object) != m_targets.end();
+}
+
+void LinkedGradientGroup::removeInvalid(EDIT_SECTION* edit, const std::wstring& effect_name)
+{
+    std::erase_if(m_targets, [&](const LinkedTarget& target) {
+        return edit->count_object_effect(target.object, effect_name.c_str()) <= target.effect_index;
+    });
+}
+
+}  // namespace gradient_editor
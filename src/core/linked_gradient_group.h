@@ -0,0 +1,54 @@
+#ifndef LINKED_GRADIENT_GROUP_H
+#define LINKED_GRADIENT_GROUP_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+
+#include "aviutl2_sdk.h"
+
+namespace gradient_editor {
+
+/// @brief リンクしたオブジェクトと、その中で編集対象とするエフェクトのインデックス
+struct LinkedTarget {
+    OBJECT_HANDLE object = nullptr;
+    int32_t effect_index = 0;
+};
+
+/// @brief 同じグラデーションを反映するオブジェクトの集まり
+/// @note 反映は選択オブジェクトへの反映と同じ編集セクション内でまとめて行う (ScriptBridge::applyGradientToScript)
+class LinkedGradientGroup {
+public:
+    /// @brief オブジェクトを追加する。追加済みの場合はエフェクトのインデックスのみ更新する
+    /// @return 新たに追加した場合は true
+    bool add(OBJECT_HANDLE object, int32_t effect_index);
+
+    /// @brief オブジェクトを取り除く
+    /// @return 取り除いた場合は true
+    bool remove(OBJECT_HANDLE object);
+
+    [[nodiscard]] bool contains(OBJECT_HANDLE object) const;
+
+    /// @brief 対象のエフェクトが無くなったオブジェクトを取り除く
+    /// @param edit 編集セクション構造体
+    /// @param effect_name エフェクト名 (EFFECT_NAMES + EFFECT_GROUP_NAME)
+    void removeInvalid(EDIT_SECTION* edit, const std::wstring& effect_name);
+
+    void clear() noexcept { m_targets.clear(); }
+
+    [[nodiscard]] bool empty() const noexcept { return m_targets.empty(); }
+    [[nodiscard]] size_t size() const noexcept { return m_targets.size(); }
+    [[nodiscard]] std::span<const LinkedTarget> targets() const noexcept { return m_targets; }
+
+private:
+    std::vector<LinkedTarget> m_targets;
+};
+
+}  // namespace gradient_editor
+
+#endif  // LINKED_GRADIENT_GROUP_H
@@ -1,11 +1,10 @@
 #include "script_bridge.h"
 
-#include <algorithm>
-#include <ranges>
+#include <string>
+#include <string_view>
 
 #include "core/constants.h"
-#include "utils/aviutl2/plugin2_utils.h"
-#include "utils/common/str_conv.h"
+#include "core/script_item_keys.h"
 
 namespace gradient_editor {
 
@@ -18,22 +17,26 @@ void ScriptBridge::loadGradientFromScript(EDIT_SECTION* edit,
     OBJECT_HANDLE object_handle = edit->get_focus_object();
     if (!object_handle) return;
 
+    const auto& keys = ScriptItemKeys::instance();
+    m_items.open(edit, object_handle, effect_name, effect_index);
+
     // マーカー数
-    uint32_t marker_count = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"マーカー数", 2u, target_move_index);
+    uint32_t marker_count = m_items.readItem(edit, object_handle, keys.markerCount(), 2u, target_move_index);
     data.getMarkerManager()->changeMarkerCount(marker_count);
 
-    auto markers = data.getMarkerManager()->getMarkers();
+    m_loading_markers.assign(data.getMarkerManager()->getMarkers().begin(), data.getMarkerManager()->getMarkers().end());
+    const auto& markers = m_loading_markers;
 
     // 位置
     for (const auto& marker : markers) {
-        float marker_pos = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"位置" + str_conv::intToWchars(marker.id + 1, "1")).c_str(), 0.0f, target_move_index);
+        float marker_pos = m_items.readItem(edit, object_handle, keys.position(marker.id), 0.0f, target_move_index);
         data.getMarkerManager()->setMarkerPos(marker.id, marker_pos / 100.0f);
     }
 
     // 色と透明度
     for (const auto& marker : markers) {
-        uint32_t hex_rgb = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"色" + str_conv::intToWchars(marker.id + 1, "1")).c_str(), 0xffffff, 0, 16);
-        float alpha      = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"透明度" + str_conv::intToWchars(marker.id + 1, "1")).c_str(), 0.0f, target_move_index);
+        uint32_t hex_rgb = m_items.readItem(edit, object_handle, keys.color(marker.id), 0xffffff, 0, 16);
+        float alpha      = m_items.readItem(edit, object_handle, keys.alpha(marker.id), 0.0f, target_move_index);
 
         ImVec4 marker_color;
         marker_color.x = ((hex_rgb >> 16) & 0xFF) / 255.0f;
@@ -46,17 +49,18 @@ void ScriptBridge::loadGradientFromScript(EDIT_SECTION* edit,
     // 中間点
     for (size_t i = 0; i < markers.size(); ++i) {
         if (i != markers.size() - 1) {
-            float marker_midpoint_ratio = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"中間点" + str_conv::intToWchars(markers[i].id + 1, "1")).c_str(), 0.0f);
+            float marker_midpoint_ratio = m_items.readItem(edit, object_handle, keys.midpoint(markers[i].id), 0.0f);
             data.getMarkerManager()->setMidpointRatio(markers[i].id, marker_midpoint_ratio / 100.0f);
         }
     }
 
     // ぼかし幅
-    float blur_width = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"ぼかし幅", 100.0f);
+    float blur_width = m_items.readItem(edit, object_handle, keys.blurWidth(), 100.0f);
     data.setBlurWidth(blur_width / 100.0f);
 
     // 色空間
-    std::string color_space_str = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"色空間", std::string{COLOR_SPACE_NAMES[0]});
+    // 文字列の値はエイリアスを参照したまま比較する
+    std::string_view color_space_str = m_items.readItem(edit, object_handle, keys.colorSpace(), std::string_view{COLOR_SPACE_NAMES[0]});
     for (uint32_t i = 0; i < 8; ++i) {
         if (color_space_str == COLOR_SPACE_NAMES[i]) {
             data.setColorSpace(i);
@@ -65,7 +69,7 @@ void ScriptBridge::loadGradientFromScript(EDIT_SECTION* edit,
     }
 
     // 補間経路
-    std::string interp_dir_str = plugin2_utils::getObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"補間経路", std::string("短経路"));
+    std::string_view interp_dir_str = m_items.readItem(edit, object_handle, keys.interpDir(), std::string_view{INTERP_DIR_NAMES[0]});
     for (uint32_t i = 0; i < 2; ++i) {
         if (interp_dir_str == INTERP_DIR_NAMES[i]) {
             data.setInterpDir(i);
@@ -87,58 +91,21 @@ void ScriptBridge::applyGradientToScript(EDIT_SECTION* edit,
                                          GradientData& data,
                                          const std::wstring& effect_name,
                                          int32_t effect_index,
-                                         int32_t target_move_index)
+                                         SectionRange sections,
+                                         std::span<const LinkedTarget> linked_targets)
 {
     OBJECT_HANDLE object_handle = edit->get_focus_object();
-    if (!object_handle) return;
-
-    auto markers          = data.getMarkerManager()->getMarkers();
-    uint32_t marker_count = static_cast<uint32_t>(markers.size());
-
-    // マーカー数
-    plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"マーカー数", marker_count, 2u, target_move_index);
-
-    // 各マーカーのデータ
-    for (const auto& marker : markers) {
-        // 色
-        uint32_t r          = static_cast<uint32_t>(marker.color.x * 255.0f + 0.5f);
-        uint32_t g          = static_cast<uint32_t>(marker.color.y * 255.0f + 0.5f);
-        uint32_t b          = static_cast<uint32_t>(marker.color.z * 255.0f + 0.5f);
-        uint32_t marker_rgb = (r << 16) | (g << 8) | b;
-
-        char hex_rgb_buf[8];
-        std::snprintf(hex_rgb_buf, sizeof(hex_rgb_buf), "%06x", marker_rgb);
-
-        // 透明度
-        float alpha = (1.0f - marker.color.w) * 100.0f;
-
-        std::wstring id_wstr = str_conv::intToWchars(marker.id + 1, "1");
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"色" + id_wstr).c_str(), std::string(hex_rgb_buf), std::string("ffffff"));
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"透明度" + id_wstr).c_str(), alpha, 0.0f, target_move_index);
-
-        // 位置
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"位置" + id_wstr).c_str(), marker.pos * 100.0f, 0.0f, target_move_index);
-
-        // 中間点 (最後のマーカー以外)
-        auto it = std::find_if(markers.begin(), markers.end(), [&](const auto& m) { return m.id == marker.id; });
-        if (it != markers.end() && std::next(it) != markers.end()) {
-            plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"中間点" + id_wstr).c_str(), marker.midpoint.ratio * 100.0f, 50.0f);
-        }
-    }
+    if (!object_handle && linked_targets.empty()) return;
 
-    // ぼかし幅
-    plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"ぼかし幅", data.getBlurWidth() * 100.0f, 100.0f);
+    // 値の文字列変換はオブジェクトの数によらず 1 回だけ行う
+    m_items.stageGradient(data.getMarkerManager()->getMarkers(), data.getBlurWidth(), data.getColorSpace(), data.getInterpDir(), sections);
 
-    // 色空間
-    int32_t cs_idx = data.getColorSpace();
-    if (cs_idx >= 0 && cs_idx < 8) {
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"色空間", std::string(COLOR_SPACE_NAMES[cs_idx]), std::string(COLOR_SPACE_NAMES[0]));
-    }
+    if (object_handle) m_items.writeStaged(edit, object_handle, effect_name, effect_index);
 
-    // 補間経路
-    int32_t id_idx = data.getInterpDir();
-    if (id_idx >= 0 && id_idx < 2) {
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, L"補間経路", std::string(INTERP_DIR_NAMES[id_idx]), std::string(INTERP_DIR_NAMES[0]));
+    // リンクしたオブジェクト
+    for (const auto& target : linked_targets) {
+        if (target.object == object_handle) continue;
+        m_items.writeStaged(edit, target.object, effect_name, target.effect_index);
     }
 }
 
@@ -146,28 +113,24 @@ void ScriptBridge::resetScriptData(EDIT_SECTION* edit,
                                    uint32_t start_id, uint32_t end_id,
                                    const std::wstring& effect_name,
                                    int32_t effect_index,
-                                   int32_t target_move_index,
-                                   uint32_t max_marker_count)
+                                   SectionRange sections,
+                                   uint32_t max_marker_count,
+                                   std::span<const LinkedTarget> linked_targets)
 {
     if (start_id >= end_id) return;
 
+    // start_id ~ end_id までの範囲を初期値にリセットする
     OBJECT_HANDLE object_handle = edit->get_focus_object();
-    if (!object_handle) return;
-
-    const uint32_t DEFAULT_COLOR = 0xffffff;
-    const float DEFAULT_ALPHA    = 0.0f;
-    const float DEFAULT_POS      = 0.0f;
-    const float DEFAULT_MIDPOINT = 50.0f;
+    if (object_handle) {
+        m_items.open(edit, object_handle, effect_name, effect_index);
+        m_items.resetMarkers(edit, object_handle, start_id, end_id, sections, max_marker_count);
+    }
 
-    // start_id ~ end_id までの範囲を初期値にリセットする
-    for (uint32_t i = start_id; i < end_id; ++i) {
-        std::wstring id_wstr = str_conv::intToWchars(i + 1, "1");
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"位置" + id_wstr).c_str(), DEFAULT_POS, DEFAULT_POS, target_move_index);
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"色" + id_wstr).c_str(), DEFAULT_COLOR, DEFAULT_COLOR, 0, 16);
-        plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"透明度" + id_wstr).c_str(), DEFAULT_ALPHA, DEFAULT_ALPHA, target_move_index);
-        if (i < max_marker_count) {
-            plugin2_utils::setObjectItemValue(edit, object_handle, effect_name.c_str(), effect_index, (L"中間点" + id_wstr).c_str(), DEFAULT_MIDPOINT, DEFAULT_MIDPOINT, target_move_index);
-        }
+    // リンクしたオブジェクトにも反映しているため、マーカー数を超えた分が残らないようにする
+    for (const auto& target : linked_targets) {
+        if (target.object == object_handle) continue;
+        m_items.open(edit, target.object, effect_name, target.effect_index);
+        m_items.resetMarkers(edit, target.object, start_id, end_id, sections, max_marker_count);
     }
 }
 
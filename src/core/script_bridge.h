@@ -2,6 +2,7 @@
 #define SCRIPT_BRIDGE_H
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,8 @@
 #include <windows.h>
 
 #include "aviutl2_sdk.h"
+#include "core/linked_gradient_group.h"
+#include "core/script_item_access.h"
 #include "imgui.h"
 #include "ui/widgets/gradient_data.h"
 
@@ -25,20 +28,46 @@ public:
                                 int32_t target_move_index);
 
     // スクリプトへグラデーションデータを反映する
+    // セクションの範囲を指定した場合、項目ごとに範囲内のすべてのセクションの値を 1 回の set_object_item_value() で書き換える
+    // linked_targets を指定した場合、選択オブジェクトに加えてリンクしたオブジェクトにも同じ値を反映する。
+    // セクションの範囲はオブジェクトごとに、そのオブジェクトのセクション数に収まるように詰める
     void applyGradientToScript(EDIT_SECTION* edit,
                                GradientData& data,
                                const std::wstring& effect_name,
                                int32_t effect_index,
-                               int32_t target_move_index);
+                               SectionRange sections,
+                               std::span<const LinkedTarget> linked_targets = {});
+
+    void applyGradientToScript(EDIT_SECTION* edit,
+                               GradientData& data,
+                               const std::wstring& effect_name,
+                               int32_t effect_index,
+                               int32_t target_move_index)
+    {
+        applyGradientToScript(edit, data, effect_name, effect_index, SectionRange::single(static_cast<uint32_t>(target_move_index)));
+    }
 
     // 特定の範囲のスクリプトデータをリセットする
+    // linked_targets を指定した場合、リンクしたオブジェクトも同じ範囲をリセットする
+    void resetScriptData(EDIT_SECTION* edit,
+                         uint32_t start_id,
+                         uint32_t end_id,
+                         const std::wstring& effect_name,
+                         int32_t effect_index,
+                         SectionRange sections,
+                         uint32_t max_marker_count,
+                         std::span<const LinkedTarget> linked_targets = {});
+
     void resetScriptData(EDIT_SECTION* edit,
                          uint32_t start_id,
                          uint32_t end_id,
                          const std::wstring& effect_name,
                          int32_t effect_index,
                          int32_t target_move_index,
-                         uint32_t max_marker_count);
+                         uint32_t max_marker_count)
+    {
+        resetScriptData(edit, start_id, end_id, effect_name, effect_index, SectionRange::single(static_cast<uint32_t>(target_move_index)), max_marker_count);
+    }
 
     bool isChangedValues(GradientData& data)
     {
@@ -106,6 +135,12 @@ private:
     Values m_prev_values;
     Values m_curr_values;
 
+    // オブジェクトごとの設定項目の読み書きと、反映する項目
+    ScriptItemAccess m_items;
+
+    // 読み込み中はマーカーが並べ替わるため、読み込む前のマーカーを写しておくバッファ
+    std::vector<GradientMarkerData> m_loading_markers;
+
     bool m_is_changed_values = false;
 };
 
@@ -0,0 +1,242 @@
+#ifndef SCRIPT_ITEM_ACCESS_H
+#define SCRIPT_ITEM_ACCESS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/constants.h"
+#include "core/script_item_keys.h"
+#include "utils/aviutl2/alias_document.h"
+#include "utils/aviutl2/alias_parser.h"
+#include "utils/aviutl2/item_value.h"
+
+namespace gradient_editor {
+
+/// @brief 反映先のセクションの範囲
+struct SectionRange {
+    uint32_t first = 0;
+    uint32_t last  = 0;
+
+    static constexpr SectionRange single(const uint32_t index) noexcept { return {index, index}; }
+    static constexpr SectionRange all() noexcept { return {0, UINT32_MAX}; }
+};
+
+/// @brief スクリプトの設定項目をオブジェクトごとに読み書きするクラス
+/// @note open() でエイリアスを解析し、値はエイリアスから読む。書き込みは値が変わった項目のみ set_object_item_value() で行う。
+///       ホストの API (EDIT_SECTION) とオブジェクトハンドルの型はテンプレート引数で受け取るため SDK に依存せず、
+///       同じ名前の関数を持つ代わりの型でも動かせる
+class ScriptItemAccess {
+public:
+    /// @brief 読み書きするオブジェクトとエフェクトを切り替え、そのオブジェクトのエイリアスを解析する
+    /// @param effect_name エフェクト名 (EFFECT_NAMES + EFFECT_GROUP_NAME)。次に open() するまで有効であること
+    template <typename Edit, typename Object>
+    void open(Edit* edit, Object object, const std::wstring& effect_name, const int32_t effect_index)
+    {
+        m_effect_name   = effect_name.c_str();
+        m_effect_key    = m_effect_key_buffer.get(effect_name, static_cast<uint32_t>(effect_index));
+        m_alias_section = nullptr;
+        m_section_count = UINT32_MAX;
+
+        auto alias = edit->get_object_alias(object);
+        if (!alias || effect_index < 0) return;
+
+        // 戻り値のポインタは次の API 呼び出しまでしか有効でないため、保持しているバッファにコピーしてから解析する
+        m_alias_buffer.assign(alias);
+        m_alias_document.parse(m_alias_buffer);
+        m_alias_section = m_alias_document.findEffectSection(ScriptItemKeys::instance().effectAliasName(effect_name), static_cast<uint32_t>(effect_index));
+        m_section_count = static_cast<uint32_t>(alias_parser::getFrameCount(m_alias_buffer));
+    }
+
+    /// @brief open() したオブジェクトのセクション数。エイリアスを取得できなかった場合は UINT32_MAX
+    [[nodiscard]] uint32_t sectionCount() const noexcept { return m_section_count; }
+
+    /// @brief 値を読み込む。エイリアスにない場合は get_object_item_value() で取得する
+    template <typename T, typename Edit, typename Object>
+    T readItem(Edit* edit, Object object, const ItemKey& key, const T default_value, const uint32_t section_index = 0, const int32_t base = 10)
+    {
+        if (!key) return default_value;
+        if (auto current = currentValue(edit, object, key)) {
+            return plugin2_utils::parseItemValue(alias_parser::getNthTokenView(*current, section_index), default_value, base);
+        }
+        return default_value;
+    }
+
+    /// @brief 範囲内のセクションの値を置き換え、値が変わった場合のみ set_object_item_value() で書き込む
+    /// @param sections 範囲。open() したオブジェクトのセクション数に収まるように詰める
+    template <typename Edit, typename Object>
+    void writeItemString(Edit* edit, Object object, const ItemKey& key, std::string_view value, const SectionRange sections)
+    {
+        if (!key) return;
+        auto current = currentValue(edit, object, key);
+        if (!current) return;
+
+        // key=value1,valu2,value3... のとき、範囲内の値のみを置き換える。
+        // リンクしたオブジェクトは選択オブジェクトよりセクションが少ない場合があり、範囲外を指定すると 1 値に潰れるため最後のセクションに詰める
+        const uint32_t last_section = m_section_count - 1;
+        std::string& line           = plugin2_utils::itemLineBuffer();
+        alias_parser::appendReplacedTokenRange(line, *current, std::min(sections.first, last_section), std::min(sections.last, last_section), value);
+
+        // 値が変わらない項目は書き込まない
+        if (line == *current) return;
+
+        edit->set_object_item_value(object, m_effect_key, key.name, line.c_str());
+        if (m_alias_section) m_alias_document.setValue(*m_alias_section, key.alias_name, line);
+    }
+
+    template <typename T, typename Edit, typename Object>
+    void writeItem(Edit* edit, Object object, const ItemKey& key, const T& value, const T default_value, const SectionRange sections = {}, const int32_t base = 10)
+    {
+        plugin2_utils::ValueBuffer value_buf;
+        writeItemString(edit, object, key, plugin2_utils::formatItemValue(value_buf, value, default_value, base), sections);
+    }
+
+    /// @brief open() したオブジェクトの start_id ~ end_id のマーカーを初期値にリセットする
+    template <typename Edit, typename Object>
+    void resetMarkers(Edit* edit, Object object, const uint32_t start_id, const uint32_t end_id, const SectionRange sections, const uint32_t max_marker_count)
+    {
+        const auto& keys = ScriptItemKeys::instance();
+
+        const uint32_t DEFAULT_COLOR = 0xffffff;
+        const float DEFAULT_ALPHA    = 0.0f;
+        const float DEFAULT_POS      = 0.0f;
+        const float DEFAULT_MIDPOINT = 50.0f;
+
+        for (uint32_t i = start_id; i < end_id; ++i) {
+            writeItem(edit, object, keys.position(i), DEFAULT_POS, DEFAULT_POS, sections);
+            writeItem(edit, object, keys.color(i), DEFAULT_COLOR, DEFAULT_COLOR, {}, 16);
+            writeItem(edit, object, keys.alpha(i), DEFAULT_ALPHA, DEFAULT_ALPHA, sections);
+            if (i < max_marker_count) {
+                writeItem(edit, object, keys.midpoint(i), DEFAULT_MIDPOINT, DEFAULT_MIDPOINT, sections);
+            }
+        }
+    }
+
+    /// @brief 反映する項目をすべて取り除く
+    void clearStaged() noexcept { m_staged_items.clear(); }
+
+    /// @brief 反映する項目を追加する。複数のオブジェクトへ反映する際に値の文字列変換を 1 回で済ませるため、先に変換しておく
+    template <typename T>
+    void stageItem(const ItemKey& key, const T& value, const T default_value, const SectionRange sections = {}, const int32_t base = 10)
+    {
+        if (!key) return;
+
+        StagedItem& item = m_staged_items.emplace_back();
+        item.key         = key;
+        item.sections    = sections;
+
+        // 文字列はそのまま参照が返るため、バッファにコピーしておく
+        std::string_view str = plugin2_utils::formatItemValue(item.value, value, default_value, base);
+        if (str.data() != item.value.data) {
+            item.value.size = std::min(str.size(), std::size(item.value.data));
+            std::copy_n(str.data(), item.value.size, item.value.data);
+        }
+    }
+
+    /// @brief グラデーションから反映する項目を作成する
+    /// @param markers マーカーの並び。要素は id, pos, color (x, y, z, w), midpoint.ratio を持つこと
+    template <typename Markers>
+    void stageGradient(const Markers& markers, const float blur_width, const int32_t color_space, const int32_t interp_dir, const SectionRange sections)
+    {
+        const auto& keys = ScriptItemKeys::instance();
+        clearStaged();
+
+        uint32_t marker_count = static_cast<uint32_t>(std::size(markers));
+
+        // マーカー数
+        stageItem(keys.markerCount(), marker_count, 2u, sections);
+
+        // 各マーカーのデータ
+        for (auto it = std::begin(markers); it != std::end(markers); ++it) {
+            const auto& marker = *it;
+
+            // 色
+            uint32_t r          = static_cast<uint32_t>(marker.color.x * 255.0f + 0.5f);
+            uint32_t g          = static_cast<uint32_t>(marker.color.y * 255.0f + 0.5f);
+            uint32_t b          = static_cast<uint32_t>(marker.color.z * 255.0f + 0.5f);
+            uint32_t marker_rgb = (r << 16) | (g << 8) | b;
+
+            char hex_rgb_buf[8];
+            std::snprintf(hex_rgb_buf, sizeof(hex_rgb_buf), "%06x", marker_rgb);
+
+            // 透明度
+            float alpha = (1.0f - marker.color.w) * 100.0f;
+
+            stageItem(keys.color(marker.id), std::string_view(hex_rgb_buf), std::string_view("ffffff"));
+            stageItem(keys.alpha(marker.id), alpha, 0.0f, sections);
+
+            // 位置
+            stageItem(keys.position(marker.id), marker.pos * 100.0f, 0.0f, sections);
+
+            // 中間点 (最後のマーカー以外)
+            if (std::next(it) != std::end(markers)) {
+                stageItem(keys.midpoint(marker.id), marker.midpoint.ratio * 100.0f, 50.0f);
+            }
+        }
+
+        // ぼかし幅
+        stageItem(keys.blurWidth(), blur_width * 100.0f, 100.0f);
+
+        // 色空間
+        if (color_space >= 0 && color_space < static_cast<int32_t>(std::size(COLOR_SPACE_NAMES))) {
+            stageItem(keys.colorSpace(), std::string_view(COLOR_SPACE_NAMES[color_space]), std::string_view(COLOR_SPACE_NAMES[0]));
+        }
+
+        // 補間経路
+        if (interp_dir >= 0 && interp_dir < static_cast<int32_t>(std::size(INTERP_DIR_NAMES))) {
+            stageItem(keys.interpDir(), std::string_view(INTERP_DIR_NAMES[interp_dir]), std::string_view(INTERP_DIR_NAMES[0]));
+        }
+    }
+
+    /// @brief 作成済みの項目を 1 つのオブジェクトへ書き込む。オブジェクトごとに現在の値と比較し、変わった項目のみ書き込まれる
+    template <typename Edit, typename Object>
+    void writeStaged(Edit* edit, Object object, const std::wstring& effect_name, const int32_t effect_index)
+    {
+        open(edit, object, effect_name, effect_index);
+        for (const auto& item : m_staged_items) {
+            writeItemString(edit, object, item.key, item.value.view(), item.sections);
+        }
+    }
+
+private:
+    struct StagedItem {
+        ItemKey key;
+        plugin2_utils::ValueBuffer value;
+        SectionRange sections;
+    };
+
+    // エイリアスにある値を優先し、見つからない場合は get_object_item_value() で取得する
+    template <typename Edit, typename Object>
+    std::optional<std::string_view> currentValue(Edit* edit, Object object, const ItemKey& key)
+    {
+        if (m_alias_section) {
+            if (auto value = m_alias_document.getValue(*m_alias_section, key.alias_name)) return value;
+        }
+        if (!m_effect_key || edit->count_object_effect(object, m_effect_name) <= 0) return std::nullopt;
+        auto ret_ptr = edit->get_object_item_value(object, m_effect_key, key.name);
+        if (!ret_ptr) return std::nullopt;
+        return std::string_view{ret_ptr};
+    }
+
+    // テーブル外のエフェクトのインデックスが指定されたときに使う項目名のバッファ
+    EffectKeyBuffer m_effect_key_buffer;
+    const wchar_t* m_effect_name = L"";
+    const wchar_t* m_effect_key  = nullptr;
+
+    // 対象オブジェクトのエイリアス。項目ごとに get_object_item_value() を呼ばずに読み書きするために使う
+    std::string m_alias_buffer;
+    alias_parser::AliasDocument m_alias_document;
+    const alias_parser::AliasDocument::Section* m_alias_section = nullptr;
+    uint32_t m_section_count                                    = UINT32_MAX;
+
+    std::vector<StagedItem> m_staged_items;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !SCRIPT_ITEM_ACCESS_H
@@ -0,0 +1,87 @@
+#include "core/script_item_keys.h"
+
+#include <charconv>
+
+#include "utils/common/str_conv.h"
+
+namespace gradient_editor {
+
+namespace {
+// 数値を 10 進数のワイド文字列として末尾に追加する (ASCII の数字のみなので単純に拡張する)
+void appendUint(std::wstring& dst, const uint32_t value)
+{
+    char buf[16];
+    auto res = std::to_chars(std::begin(buf), std::end(buf), value);
+    for (const char* p = buf; p != res.ptr; ++p) dst.push_back(static_cast<wchar_t>(*p));
+}
+}  // namespace
+
+const ScriptItemKeys& ScriptItemKeys::instance()
+{
+    static const ScriptItemKeys keys;
+    return keys;
+}
+
+ScriptItemKeys::Key ScriptItemKeys::makeKey(std::wstring name)
+{
+    Key key;
+    key.alias_name = str_conv::wideCharToMultiByte(name);
+    key.name       = std::move(name);
+    return key;
+}
+
+ScriptItemKeys::ScriptItemKeys()
+{
+    for (uint32_t i = 0; i < MAX_MARKER_COUNT; ++i) {
+        std::wstring id_wstr = str_conv::intToWchars(i + 1, "1");
+        m_position[i]        = makeKey(L"位置" + id_wstr);
+        m_color[i]           = makeKey(L"色" + id_wstr);
+        m_alpha[i]           = makeKey(L"透明度" + id_wstr);
+        m_midpoint[i]        = makeKey(L"中間点" + id_wstr);
+    }
+    m_marker_count = makeKey(L"マーカー数");
+    m_blur_width   = makeKey(L"ぼかし幅");
+    m_color_space  = makeKey(L"色空間");
+    m_interp_dir   = makeKey(L"補間経路");
+
+    for (uint32_t n = 0; n < std::size(EFFECT_NAMES); ++n) {
+        m_effect_names[n] = makeKey(std::wstring{EFFECT_NAMES[n]} + EFFECT_GROUP_NAME);
+        for (uint32_t i = 0; i < MAX_EFFECT_INDEX; ++i) {
+            m_effect_with_index[n][i] = m_effect_names[n].name + L":";
+            appendUint(m_effect_with_index[n][i], i);
+        }
+    }
+}
+
+const wchar_t* ScriptItemKeys::effectWithIndex(std::wstring_view effect_name, const uint32_t effect_index) const noexcept
+{
+    if (effect_index >= MAX_EFFECT_INDEX) return nullptr;
+
+    for (uint32_t n = 0; n < std::size(EFFECT_NAMES); ++n) {
+        if (m_effect_names[n].name == effect_name) return m_effect_with_index[n][effect_index].c_str();
+    }
+    return nullptr;
+}
+
+std::string_view ScriptItemKeys::effectAliasName(std::wstring_view effect_name) const noexcept
+{
+    for (const auto& key : m_effect_names) {
+        if (key.name == effect_name) return key.alias_name;
+    }
+    return {};
+}
+
+const wchar_t* EffectKeyBuffer::get(std::wstring_view effect_name, const uint32_t effect_index)
+{
+    if (auto key = ScriptItemKeys::instance().effectWithIndex(effect_name, effect_index)) {
+        return key;
+    }
+
+    // テーブル外の場合はバッファに組み立てる。容量が足りていれば再確保は起きない
+    m_buffer.assign(effect_name);
+    m_buffer.push_back(L':');
+    appendUint(m_buffer, effect_index);
+    return m_buffer.c_str();
+}
+
+}  // namespace gradient_editor
@@ -0,0 +1,93 @@
+#ifndef SCRIPT_ITEM_KEYS_H
+#define SCRIPT_ITEM_KEYS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "core/constants.h"
+
+namespace gradient_editor {
+
+/// @brief スクリプトの設定項目名
+struct ItemKey {
+    const wchar_t* name = nullptr;  // get/set_object_item_value() に渡す項目名
+    std::string_view alias_name;    // エイリアス上のキー (UTF-8)
+
+    explicit operator bool() const noexcept { return name != nullptr; }
+};
+
+/// @brief スクリプトの設定項目名 (位置N, 色N, 透明度N, 中間点N) とエフェクト名:インデックスを事前に生成して保持するテーブル
+/// @note 反映・読込のたびに項目名の文字列を組み立てないようにするため、初回アクセス時に一度だけ生成する
+class ScriptItemKeys {
+public:
+    // テーブルに保持するエフェクトのインデックスの上限。これ以上は呼び出し側で組み立てる
+    static constexpr uint32_t MAX_EFFECT_INDEX = 16;
+
+    static const ScriptItemKeys& instance();
+
+    // id は 0 始まりのマーカー ID
+    [[nodiscard]] ItemKey position(const uint32_t id) const noexcept { return at(m_position, id); }
+    [[nodiscard]] ItemKey color(const uint32_t id) const noexcept { return at(m_color, id); }
+    [[nodiscard]] ItemKey alpha(const uint32_t id) const noexcept { return at(m_alpha, id); }
+    [[nodiscard]] ItemKey midpoint(const uint32_t id) const noexcept { return at(m_midpoint, id); }
+
+    [[nodiscard]] ItemKey markerCount() const noexcept { return get(m_marker_count); }
+    [[nodiscard]] ItemKey blurWidth() const noexcept { return get(m_blur_width); }
+    [[nodiscard]] ItemKey colorSpace() const noexcept { return get(m_color_space); }
+    [[nodiscard]] ItemKey interpDir() const noexcept { return get(m_interp_dir); }
+
+    /// @brief "<エフェクト名>:<インデックス>" の文字列を取得する
+    /// @param effect_name エフェクト名 (EFFECT_NAMES + EFFECT_GROUP_NAME)
+    /// @param effect_index エフェクトのインデックス
+    /// @return テーブルにない場合は nullptr
+    [[nodiscard]] const wchar_t* effectWithIndex(std::wstring_view effect_name, const uint32_t effect_index) const noexcept;
+
+    /// @brief エイリアスの effect.name に書かれるエフェクト名 (UTF-8) を取得する
+    /// @return テーブルにない場合は空文字列
+    [[nodiscard]] std::string_view effectAliasName(std::wstring_view effect_name) const noexcept;
+
+private:
+    ScriptItemKeys();
+
+    struct Key {
+        std::wstring name;
+        std::string alias_name;
+    };
+
+    using MarkerKeys = std::array<Key, MAX_MARKER_COUNT>;
+    using EffectKeys = std::array<std::array<std::wstring, MAX_EFFECT_INDEX>, std::size(EFFECT_NAMES)>;
+
+    static ItemKey get(const Key& key) noexcept { return {key.name.c_str(), key.alias_name}; }
+    static ItemKey at(const MarkerKeys& keys, const uint32_t id) noexcept
+    {
+        return id < keys.size() ? get(keys[id]) : ItemKey{};
+    }
+    static Key makeKey(std::wstring name);
+
+    MarkerKeys m_position;
+    MarkerKeys m_color;
+    MarkerKeys m_alpha;
+    MarkerKeys m_midpoint;
+    Key m_marker_count;
+    Key m_blur_width;
+    Key m_color_space;
+    Key m_interp_dir;
+
+    std::array<Key, std::size(EFFECT_NAMES)> m_effect_names;
+    EffectKeys m_effect_with_index;
+};
+
+/// @brief ScriptItemKeys のテーブル外の "<エフェクト名>:<インデックス>" を組み立てるためのバッファ。確保済みの領域を使い回す
+class EffectKeyBuffer {
+public:
+    const wchar_t* get(std::wstring_view effect_name, const uint32_t effect_index);
+
+private:
+    std::wstring m_buffer;
+};
+
+}  // namespace gradient_editor
+
+#endif  // SCRIPT_ITEM_KEYS_H
@@ -0,0 +1,70 @@
+#include "core/startup_phases.h"
+
+#include <cstdio>
+
+namespace gradient_editor {
+
+StartupPhases::StartupPhases(std::function<TimePoint()> now)
+    : m_now{std::move(now)}
+    , m_last_mark{m_now()}
+{
+}
+
+void StartupPhases::add(const char* name, std::move_only_function<bool()> run)
+{
+    m_phases.push_back({name, std::move(run)});
+}
+
+bool StartupPhases::runPending()
+{
+    while (!m_has_failed && hasPending()) {
+        Phase& phase          = m_phases[m_next_phase++];
+        const TimePoint start = m_now();
+        const bool is_success = phase.run();
+        const TimePoint end   = m_now();
+
+        m_timings.push_back({.name = phase.name, .duration = end - start, .is_success = is_success});
+        m_last_mark  = end;
+        m_has_failed = !is_success;
+        phase.run    = nullptr;  // キャプチャした資源を解放する
+    }
+    return !m_has_failed;
+}
+
+void StartupPhases::mark(const char* name, const bool is_wait)
+{
+    const TimePoint now = m_now();
+    m_timings.push_back({.name = name, .duration = now - m_last_mark, .is_wait = is_wait});
+    m_last_mark = now;
+}
+
+StartupPhases::Duration StartupPhases::busyTime() const noexcept
+{
+    Duration total{};
+    for (const auto& timing : m_timings) {
+        if (!timing.is_wait) total += timing.duration;
+    }
+    return total;
+}
+
+std::string StartupPhases::report() const
+{
+    const auto to_ms = [](const Duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+
+    std::string text;
+    char buffer[128];
+    for (const auto& timing : m_timings) {
+        if (!text.empty()) text += ", ";
+        if (timing.is_wait) {
+            std::snprintf(buffer, sizeof(buffer), "(%s %.2f ms)", timing.name, to_ms(timing.duration));
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%s %.2f ms%s", timing.name, to_ms(timing.duration), timing.is_success ? "" : " FAILED");
+        }
+        text += buffer;
+    }
+    std::snprintf(buffer, sizeof(buffer), " / busy %.2f ms", to_ms(busyTime()));
+    text += buffer;
+    return text;
+}
+
+}  // namespace gradient_editor
@@ -0,0 +1,68 @@
+#ifndef STARTUP_PHASES_H
+#define STARTUP_PHASES_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace gradient_editor {
+
+/// @brief 起動処理をフェーズに分けて順に実行し、それぞれの所要時間を記録するクラス
+/// @note フェーズは add() で予約しておき、必要になった時点で runPending() で実行する。
+///       時刻は now 関数で取得するため、フェーズと時計を差し替えればプラットフォームに依存せずに確かめられる
+class StartupPhases {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Duration  = Clock::duration;
+
+    struct PhaseTiming {
+        const char* name = nullptr;  // 静的な文字列
+        Duration duration{};
+        bool is_success = true;
+        bool is_wait    = false;  // 処理ではなく待ち時間
+    };
+
+    explicit StartupPhases(std::function<TimePoint()> now = Clock::now);
+
+    /// @brief フェーズを予約する
+    /// @param run 処理。false を返すと失敗とし、以降のフェーズは実行しない
+    void add(const char* name, std::move_only_function<bool()> run);
+
+    /// @brief 予約済みで未実行のフェーズを順に実行する
+    /// @return すべて成功した場合は true
+    bool runPending();
+
+    /// @brief 前回の記録からの経過時間を記録する。フェーズとして予約できない処理や待ち時間に使う
+    /// @param is_wait 処理ではなく待ち時間の場合は true。busyTime() に含めない
+    void mark(const char* name, bool is_wait = false);
+
+    [[nodiscard]] bool hasPending() const noexcept { return m_next_phase < m_phases.size(); }
+    [[nodiscard]] bool hasFailed() const noexcept { return m_has_failed; }
+    [[nodiscard]] const std::vector<PhaseTiming>& timings() const noexcept { return m_timings; }
+
+    /// @brief 待ち時間を除いた所要時間の合計
+    [[nodiscard]] Duration busyTime() const noexcept;
+
+    /// @brief "window 0.52 ms, (wait_visible 812.00 ms), d3d 35.10 ms, ... / busy 60.31 ms" の形式の文字列
+    [[nodiscard]] std::string report() const;
+
+private:
+    struct Phase {
+        const char* name;
+        std::move_only_function<bool()> run;
+    };
+
+    std::function<TimePoint()> m_now;
+    std::vector<Phase> m_phases;
+    size_t m_next_phase = 0;
+    std::vector<PhaseTiming> m_timings;
+    TimePoint m_last_mark;
+    bool m_has_failed = false;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !STARTUP_PHASES_H
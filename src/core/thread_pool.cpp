@@ -0,0 +1,115 @@
+#include "core/thread_pool.h"
+
+#include <algorithm>
+
+namespace gradient_editor {
+
+namespace {
+
+// ワーカーのスレッドから積んだタスクをそのワーカーのキューに入れるため、どのプールの何番目のワーカーかを保持する
+thread_local const ThreadPool* t_current_pool = nullptr;
+thread_local size_t t_worker_index            = 0;
+
+}  // namespace
+
+void ThreadPool::start(uint32_t thread_count)
+{
+    if (!m_workers.empty()) return;
+    if (thread_count == 0) thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+
+    m_stop_source = std::stop_source{};
+    // すべてのワーカーのキューを作ってからスレッドを開始する。他のワーカーのキューから取るため
+    for (uint32_t i = 0; i < thread_count; ++i) m_workers.push_back(std::make_unique<Worker>());
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        m_workers[i]->thread = std::jthread([this, i](std::stop_token stop_token) { workerMain(std::move(stop_token), i); });
+    }
+}
+
+void ThreadPool::shutdown()
+{
+    if (m_workers.empty()) return;
+
+    // 積まれているタスクを取り出さないよう、実行中のタスクに停止を伝えるより先にワーカーを止める
+    for (auto& worker : m_workers) worker->thread.request_stop();
+    m_stop_source.request_stop();
+    for (auto& worker : m_workers) worker->thread.join();
+    m_workers.clear();
+
+    std::lock_guard lock(m_shared_queue.mutex);
+    for (auto& jobs : m_shared_queue.jobs) jobs.clear();
+    m_pending_count.store(0);
+}
+
+void ThreadPool::submit(const TaskPriority priority, Task task, std::stop_token stop_token)
+{
+    if (!stop_token.stop_possible()) stop_token = m_stop_source.get_token();
+
+    const size_t priority_index = static_cast<size_t>(priority);
+    WorkQueue& queue            = t_current_pool == this ? m_workers[t_worker_index]->queue : m_shared_queue;
+    {
+        std::lock_guard lock(queue.mutex);
+        queue.jobs[priority_index].push_back({std::move(task), std::move(stop_token)});
+    }
+
+    // 待機に入る途中のワーカーが取りこぼさないよう、待機中の数は積んだ後に読む (ワーカーは逆の順に読み書きする)
+    m_pending_count.fetch_add(1);
+    if (m_sleeping_count.load() > 0) {
+        { std::lock_guard lock(m_sleep_mutex); }
+        m_cv.notify_one();
+    }
+}
+
+void ThreadPool::workerMain(std::stop_token stop_token, const size_t index)
+{
+    t_current_pool = this;
+    t_worker_index = index;
+
+    while (!stop_token.stop_requested()) {
+        if (auto job = findJob(index)) {
+            // 取り出している間に停止を要求された場合は実行しない
+            if (!stop_token.stop_requested() && !job->stop_token.stop_requested()) job->task(std::move(job->stop_token));
+            continue;
+        }
+
+        std::unique_lock lock(m_sleep_mutex);
+        m_sleeping_count.fetch_add(1);
+        m_cv.wait(lock, stop_token, [&] { return m_pending_count.load() > 0; });
+        m_sleeping_count.fetch_sub(1);
+    }
+
+    t_current_pool = nullptr;
+}
+
+std::optional<ThreadPool::Job> ThreadPool::findJob(const size_t index)
+{
+    // 自身のキューは後ろから (直前に積んだタスクはキャッシュに残っている)、他のキューは前から取る
+    const auto take = [this](WorkQueue& queue, const size_t priority_index, const bool is_own) -> std::optional<Job> {
+        std::lock_guard lock(queue.mutex);
+        auto& jobs = queue.jobs[priority_index];
+        if (jobs.empty()) return std::nullopt;
+
+        Job job;
+        if (is_own) {
+            job = std::move(jobs.back());
+            jobs.pop_back();
+        } else {
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        m_pending_count.fetch_sub(1);
+        return job;
+    };
+
+    for (size_t priority_index = 0; priority_index < PRIORITY_COUNT; ++priority_index) {
+        if (m_pending_count.load(std::memory_order_relaxed) == 0) return std::nullopt;
+
+        if (auto job = take(m_workers[index]->queue, priority_index, true)) return job;
+        if (auto job = take(m_shared_queue, priority_index, false)) return job;
+        for (size_t offset = 1; offset < m_workers.size(); ++offset) {
+            if (auto job = take(m_workers[(index + offset) % m_workers.size()]->queue, priority_index, false)) return job;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace gradient_editor
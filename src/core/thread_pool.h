@@ -0,0 +1,100 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gradient_editor {
+
+enum class TaskPriority : uint8_t {
+    Interactive = 0,  // 操作の結果として待たれている処理 (サムネイルの作成など)
+    Background,       // 急がない処理 (ファイルの読み込みや監視など)
+};
+
+/// @brief 編集中のバックグラウンドの処理を実行するワークスティーリングのスレッドプール
+/// @note ワーカーごとのキューと共有のキューを持ち、空いたワーカーは他のワーカーのキューから取る。
+///       Interactive のタスクはすべてのキューの Background のタスクより先に実行する。
+///       キャンセルは submit() で渡した std::stop_token で行い、キャンセルされたタスクは実行しない
+class ThreadPool {
+public:
+    using Task = std::move_only_function<void(std::stop_token)>;
+
+    ThreadPool() = default;
+    ~ThreadPool() { shutdown(); }
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief ワーカーを開始する。開始済みの場合は何もしない
+    /// @param thread_count 0 の場合はハードウェアのスレッド数
+    void start(uint32_t thread_count = 0);
+
+    /// @brief 実行中のタスクの終了を待ってワーカーを停止する。積まれているタスクは実行せずに破棄する
+    /// @note stop_token を渡さずに積んだタスクには、停止を要求してから待つ
+    void shutdown();
+
+    [[nodiscard]] size_t threadCount() const noexcept { return m_workers.size(); }
+
+    /// @brief タスクを積む。どのスレッドから呼んでもよい
+    /// @note ワーカーのスレッドから積んだタスクはそのワーカーのキューに入り、優先して実行される
+    void submit(TaskPriority priority, Task task, std::stop_token stop_token = {});
+
+    /// @brief 戻り値を std::future で受け取るタスクを積む
+    /// @note キャンセルや停止で実行されなかった場合、future は std::future_errc::broken_promise を返す
+    template <typename F>
+    auto async(const TaskPriority priority, F&& func, std::stop_token stop_token = {})
+        -> std::future<std::invoke_result_t<F&, std::stop_token>>
+    {
+        std::packaged_task<std::invoke_result_t<F&, std::stop_token>(std::stop_token)> task{std::forward<F>(func)};
+        auto future = task.get_future();
+        submit(priority, std::move(task), std::move(stop_token));
+        return future;
+    }
+
+private:
+    static constexpr size_t PRIORITY_COUNT = 2;
+
+    struct Job {
+        Task task;
+        std::stop_token stop_token;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs[PRIORITY_COUNT];
+    };
+
+    struct Worker {
+        WorkQueue queue;
+        std::jthread thread;
+    };
+
+    void workerMain(std::stop_token stop_token, size_t index);
+    std::optional<Job> findJob(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    WorkQueue m_shared_queue;  // ワーカー以外のスレッドから積んだタスク
+    std::stop_source m_stop_source;
+
+    std::atomic<size_t> m_pending_count{0};   // 積まれていて、まだ取り出されていないタスクの数
+    std::atomic<size_t> m_sleeping_count{0};  // 待機中のワーカーの数
+    std::mutex m_sleep_mutex;
+    std::condition_variable_any m_cv;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !THREAD_POOL_H
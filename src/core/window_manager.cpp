@@ -16,11 +16,12 @@ bool WindowManager::createPluginWindow(const wchar_t* window_name, const float s
     }
 
     // ウィンドウ作成
-    m_hwnd = CreateWindowEx(
-        0, window_name, window_name,
-        WS_POPUP,  // 親設定前なのでPOPUPで作る
+    HWND hwnd = CreateWindowEx(
+        WS_EX_ACCEPTFILES, window_name, window_name,  // グラデーションのファイルのドロップを受け付ける
+        WS_POPUP,                                     // 親設定前なのでPOPUPで作る
         0, 0, (int)(1280 * scale), (int)(800 * scale),
         nullptr, nullptr, GetModuleHandle(nullptr), nullptr);
+    m_hwnd.store(hwnd, std::memory_order_release);
     return true;
 }
 
@@ -31,7 +32,7 @@ void WindowManager::unregisterClass()
 
 void WindowManager::destroyPluginWindow()
 {
-    ::DestroyWindow(m_hwnd);
+    ::DestroyWindow(m_hwnd.exchange(nullptr, std::memory_order_acq_rel));
     ::UnregisterClassW(m_wc.lpszClassName, m_wc.hInstance);
 }
 
@@ -1,6 +1,8 @@
 #ifndef WINDOW_MANAGER_H
 #define WINDOW_MANAGER_H
 
+#include <atomic>
+
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
@@ -21,13 +23,14 @@ public:
     void unregisterClass();
     void destroyPluginWindow();
     static LRESULT CALLBACK windowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
-    HWND getWindowHandle() const { return m_hwnd; }
+    /// @brief ウィンドウハンドルを返す。どのスレッドから呼んでもよい
+    HWND getWindowHandle() const { return m_hwnd.load(std::memory_order_acquire); }
 
     void setResizing(const bool state) noexcept { m_is_resizing = state; }
     [[nodiscard]] bool isResizing() const noexcept { return m_is_resizing; }
 
 private:
-    HWND m_hwnd;
+    std::atomic<HWND> m_hwnd{nullptr};  // GUI スレッドで作成・破棄し、他のスレッドは読み取りのみ
     WNDCLASSEXW m_wc   = {};
     bool m_is_resizing = false;
 };
@@ -1,9 +1,11 @@
 #include <future>
+#include <string>
 #include <thread>
 
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#include <shellapi.h>
 
 #include "aviutl2_sdk.h"
 #include "core/app.h"
@@ -45,6 +47,18 @@ LRESULT CALLBACK wnd_proc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam)
         case WM_DESTROY:
             ::PostQuitMessage(0);
             return 0;
+        case WM_DROPFILES: {
+            // 読み込みは MainView で行う
+            HDROP drop       = reinterpret_cast<HDROP>(wparam);
+            const UINT count = ::DragQueryFileW(drop, 0xFFFFFFFF, nullptr, 0);
+            for (UINT i = 0; i < count; ++i) {
+                std::wstring path(::DragQueryFileW(drop, i, nullptr, 0), L'\0');
+                ::DragQueryFileW(drop, i, path.data(), static_cast<UINT>(path.size() + 1));
+                g_app_state.dropped_files.emplace_back(std::move(path));
+            }
+            ::DragFinish(drop);
+            return 0;
+        }
         case WM_ENTERSIZEMOVE:
             g_app_state.window_manager.setResizing(true);
             return 0;
@@ -77,6 +91,7 @@ EXTERN_C __declspec(dllexport) DWORD RequiredVersion() {
 EXTERN_C __declspec(dllexport) void InitializeLogger(LOG_HANDLE* handle)
 {
     g_app_state.logger = handle;
+    g_app_state.log.setLogHandle(handle);
 }
 
 EXTERN_C __declspec(dllexport) void InitializeConfig(CONFIG_HANDLE* handle)
@@ -94,11 +109,8 @@ EXTERN_C __declspec(dllexport) bool InitializePlugin(DWORD version)
 
 EXTERN_C __declspec(dllexport) void UninitializePlugin()
 {
-    // WM_QUIT を App::run() 内のメッセージループに通知
-    HWND hwnd = g_app_state.window_manager.getWindowHandle();
-    if (hwnd) {
-        ::PostMessage(hwnd, WM_QUIT, 0, 0);
-    }
+    // App::run() 内のメッセージループを終了させる
+    g_app_state.post(gui_command::Quit{});
     g_app_state.cleanup();
 }
 
@@ -113,4 +125,7 @@ EXTERN_C __declspec(dllexport) void RegisterPlugin(HOST_APP_TABLE* host)
 
     HWND hwnd = f.get();
     host->register_window_client(g_app_state.config->translate(g_app_state.config, WINDOW_NAME_DEFAULT), hwnd);
+
+    // パネルが表示されているか GUI スレッドに確かめさせる
+    g_app_state.post(gui_command::WindowRegistered{});
 }
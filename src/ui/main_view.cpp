@@ -1,9 +1,14 @@
 #include "ui/main_view.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
 
 #include "IconsMaterialSymbols.h"
 #include "core/constants.h"
@@ -14,6 +19,7 @@
 #include "ui/widgets/menu_bar.h"
 #include "utils/aviutl2/config2_utils.h"
 #include "utils/aviutl2/plugin2_utils.h"
+#include "utils/common/frame_profiler.h"
 #include "utils/common/str_conv.h"
 #include "utils/common/color_conv.h"
 #include "utils/imgui/imgui_utils.h"
@@ -40,24 +46,103 @@ MainView::MainView()
     // プリセットファイルがなければ作成
     preset_path /= PRESET_FILE_NAME;
     if (!std::filesystem::exists(preset_path)) {
-        m_preset_manager.createDefaultPresetFile(preset_path);
+        m_preset_library.manager().createDefaultPresetFile(preset_path);
     }
 
-    // プリセットを読み込む
-    m_preset_manager.setPresetFilePath(preset_path);
-    auto load_result = m_preset_manager.loadPresetFile();
-    m_preset_file    = load_result.preset_file;
-    if (!load_result.error.empty()) {
-        g_app_state.logger->error(g_app_state.logger, str_conv::multiByteToWideChar(load_result.error).c_str());
-    }
+    // プリセットはワーカースレッドで読み込み、完了するまでは読み込み中と表示する
+    m_preset_window.setLoading(true);
+    m_preset_library.setUpdateCallback([] { g_app_state.requestRender(); });
+    m_preset_library.setErrorCallback([](const std::string& error) { g_app_state.log.error(L"{}", str_conv::multiByteToWideChar(error)); });
+    m_preset_library.start(preset_path);
+
+    // 前回の起動で描画したサムネイルを読み込む
+    m_thumbnail_cache_path = preset_path;
+    m_thumbnail_cache_path.replace_extension(thumbnail_cache::EXTENSION);
+    m_preset_window.loadThumbnailCache(m_thumbnail_cache_path);
+
+    m_trace_path = preset_path.parent_path() / TRACE_FILE_NAME;
 
     m_object_video_color_start = color_conv::u32Rgba2u32Abgr(color_conv::u32Rgb2u32Rgba(g_app_state.config->get_color_code_index(g_app_state.config, "ObjectVideo", 0), 0xFF));
     m_object_video_color_stop  = color_conv::u32Rgba2u32Abgr(color_conv::u32Rgb2u32Rgba(g_app_state.config->get_color_code_index(g_app_state.config, "ObjectVideo", 1), 0xFF));
     m_frame_cursor_color       = color_conv::u32Rgba2u32Abgr(color_conv::u32Rgb2u32Rgba(g_app_state.config->get_color_code(g_app_state.config, "FrameCursor"), 0xFF));
 }
 
+MainView::~MainView()
+{
+    m_import_stop.request_stop();
+
+    // サムネイルを保存してから、ワーカースレッドを止めてジャーナルを本体に反映する
+    m_preset_library.shutdown([this](const preset_file::GradientPresetFile& file) { m_preset_window.saveThumbnailCache(m_thumbnail_cache_path, file); });
+}
+
+void MainView::updatePresetLoader()
+{
+    if (m_preset_library.update()) m_preset_window.setLoading(false);
+}
+
+void MainView::updatePresetImport()
+{
+    // プリセットファイルの読み込みが完了するまでと、前のファイルを読み込んでいる間はドロップされたファイルを保持しておく
+    if (!m_preset_library.isLoaded() || m_is_importing || g_app_state.dropped_files.empty()) return;
+
+    std::vector<std::filesystem::path> paths;
+    for (auto& path : g_app_state.dropped_files) {
+        if (preset_import::isSupportedFile(path)) paths.push_back(std::move(path));
+    }
+    g_app_state.dropped_files.clear();
+    if (paths.empty()) return;
+
+    // 大量のファイルでも GUI スレッドを止めないよう、ファイルごとにスレッドプールで並列に読み込む。
+    // 最後に終わったタスクが、まとめてプリセットに追加する処理を GUI スレッドに渡す
+    struct ImportBatch {
+        std::vector<preset_import::ImportResult> results;
+        std::atomic<size_t> remaining_count;
+    };
+    auto batch = std::make_shared<ImportBatch>();
+    batch->results.resize(paths.size());
+    batch->remaining_count = paths.size();
+
+    m_is_importing = true;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        g_app_state.thread_pool.submit(TaskPriority::Background, [this, batch, i, path = std::move(paths[i])](std::stop_token) {
+            batch->results[i] = preset_import::importFile(path, MAX_MARKER_COUNT);
+            if (batch->remaining_count.fetch_sub(1) != 1) return;
+            g_app_state.runOnGui([this, batch] { applyImportResults(std::move(batch->results)); });
+        }, m_import_stop.get_token());
+    }
+}
+
+void MainView::applyImportResults(std::vector<preset_import::ImportResult> results)
+{
+    m_is_importing = false;
+
+    std::vector<preset::GradientPreset> presets;
+    for (auto& result : results) {
+        if (!result.error.empty()) {
+            g_app_state.log.warn(L"{}: {}", result.path.wstring(), str_conv::multiByteToWideChar(result.error));
+        }
+        std::move(result.presets.begin(), result.presets.end(), std::back_inserter(presets));
+    }
+
+    auto result = m_preset_window.importPresets(m_preset_library.manager(), m_preset_library.file(), std::move(presets));
+    if (result.is_success) {
+        g_app_state.log.info("imported {} presets ({} duplicates skipped)", result.added_count, result.duplicate_count);
+    } else {
+        g_app_state.log.error(L"{}", str_conv::multiByteToWideChar(result.error));
+    }
+}
+
 void MainView::render()
 {
+    frame_profiler::ScopedZone zone{"MainView::render"};
+
+    // 言語が変わった場合のみ翻訳を作り直す
+    aul2::translationCache().refresh();
+
+    // バックグラウンドでの読み込み結果を反映する
+    updatePresetLoader();
+    updatePresetImport();
+
     //
     // ドッキングスペースの設定
     //
@@ -84,7 +169,13 @@ void MainView::render()
     windowClass.DockNodeFlagsOverrideSet = ImGuiDockNodeFlags_NoCloseButton | ImGuiDockNodeFlags_NoWindowMenuButton | ImGuiDockNodeFlags_NoTabBar;
     ImGui::SetNextWindowClass(&windowClass);
     if (m_window_visible.preset_window) {
-        m_preset_window.render(&m_window_visible.preset_window, m_preset_manager, m_preset_file);
+        m_preset_window.render(&m_window_visible.preset_window, m_preset_library.manager(), m_preset_library.file());
+    }
+
+    // プロファイラは表示している間だけ記録する
+    frame_profiler::setEnabled(m_window_visible.profiler_window);
+    if (m_window_visible.profiler_window) {
+        m_profiler_window.render(&m_window_visible.profiler_window, m_trace_path);
     }
 
     if (!m_is_init) {
@@ -95,6 +186,8 @@ void MainView::render()
 
 void MainView::renderGradientEditor()
 {
+    frame_profiler::ScopedZone zone{"MainView::renderGradientEditor"};
+
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
                                     ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse |
                                     ImGuiWindowFlags_MenuBar;
@@ -123,7 +216,7 @@ void MainView::renderGradientEditor()
     //
     bool is_changed_section = false;
     ImGui::AlignTextToFramePadding();
-    ImGui::Text(aul2::tr(L"セクション").c_str());
+    ImGui::Text(aul2::tr(L"セクション"));
     ImGui::SameLine();
 
     if (ImGui::ArrowButton("##left", ImGuiDir_Left)) {
@@ -137,7 +230,7 @@ void MainView::renderGradientEditor()
         });
         m_target_move_index = std::clamp(m_target_move_index - 1, 0, m_frame_count - 1);
     }
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"前のセクションに移動").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"前のセクションに移動"));
 
     ImGui::SameLine(0, ImGui::GetStyle().ItemInnerSpacing.x);
     if (ImGui::ArrowButton("##right", ImGuiDir_Right)) {
@@ -151,7 +244,7 @@ void MainView::renderGradientEditor()
         });
         m_target_move_index = std::clamp(m_target_move_index + 1, 0, m_frame_count - 1);
     }
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"次のセクションに移動").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"次のセクションに移動"));
 
     static bool is_refresh = false;
     if (is_refresh) {
@@ -192,10 +285,16 @@ void MainView::renderGradientEditor()
         for (auto name : EFFECT_NAMES) res.push_back(str_conv::wideCharToMultiByte(name));
         return res;
     }();
+    // ホストに渡すエフェクト名。毎フレーム連結しないよう、最初に作っておく
+    static const std::vector<std::wstring> effect_full_names = []() {
+        std::vector<std::wstring> res;
+        for (auto name : EFFECT_NAMES) res.push_back(std::wstring(name) + EFFECT_GROUP_NAME);
+        return res;
+    }();
 
     bool is_changed_section_effect = false;
     ImGui::AlignTextToFramePadding();
-    ImGui::Text(aul2::tr(L"対象").c_str());
+    ImGui::Text(aul2::tr(L"対象"));
     ImGui::SameLine();
     if (ImGui::BeginCombo("##エフェクト", effect_names_vec[m_effect_name_index].c_str(), ImGuiComboFlags_WidthFitPreview)) {
         for (uint32_t i = 0; i < effect_names_vec.size(); ++i) {
@@ -206,8 +305,8 @@ void MainView::renderGradientEditor()
         }
         ImGui::EndCombo();
     }
-    std::wstring effect_full_name = std::wstring(EFFECT_NAMES[m_effect_name_index]) + EFFECT_GROUP_NAME;
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"編集対象のエフェクト名").c_str());
+    const std::wstring& effect_full_name = effect_full_names[m_effect_name_index];
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"編集対象のエフェクト名"));
 
     bool is_changed_effect_index = false;
     ImGui::SameLine();
@@ -221,26 +320,31 @@ void MainView::renderGradientEditor()
         m_effect_index = std::clamp(m_effect_index, 0, count == 0 ? 0 : count - 1);
     }
     ImGui::PopItemWidth();
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"編集対象のエフェクトのインデックス").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"編集対象のエフェクトのインデックス"));
 
     //
     // 各種データ操作ボタン
     //
     // スクリプトへ反映
     bool off_to_on = false;
-    if (imgui_utils::pushToggleButton(aul2::tr(L"反映").c_str(), &m_apply)) {
+    if (imgui_utils::pushToggleButton(aul2::tr(L"反映"), &m_apply)) {
         plugin2_utils::call_edit_lambda(g_app_state.edit_handle->call_edit_section_param, [&](EDIT_SECTION* edit) {
             if (auto obj = edit->get_focus_object()) m_layer_frame = edit->get_object_layer_frame(obj);
         });
         if (m_apply) off_to_on = true;
     }
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"スクリプトへ値を反映").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"スクリプトへ値を反映"));
     if (m_apply) m_load = false;
 
+    // すべてのセクションへ反映
+    ImGui::SameLine(0, 0);
+    bool is_changed_all_sections = imgui_utils::pushToggleButton(aul2::tr(L"全セクション"), &m_apply_all_sections);
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"すべてのセクションへ値を反映"));
+
     // スクリプトから読み込む
     ImGui::SameLine(0, 0);
-    m_load = ImGui::Button(aul2::tr(L"読込").c_str());
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"スクリプトから値を読み込む").c_str());
+    m_load = ImGui::Button(aul2::tr(L"読込"));
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"スクリプトから値を読み込む"));
 
     // 再読み込み
     ImGui::SameLine();
@@ -250,11 +354,29 @@ void MainView::renderGradientEditor()
             if (auto obj = edit->get_focus_object()) m_layer_frame = edit->get_object_layer_frame(obj);
         });
     }
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"選択オブジェクトの再読み込み").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"選択オブジェクトの再読み込み"));
+
+    // 選択オブジェクトをリンクに追加・リンクから削除
+    ImGui::SameLine();
+    bool is_changed_link = false;
+    if (imgui_utils::squareIconButton(ICON_MS_LINK, "##link")) {
+        plugin2_utils::call_edit_lambda(g_app_state.edit_handle->call_edit_section_param, [&](EDIT_SECTION* edit) {
+            OBJECT_HANDLE obj = edit->get_focus_object();
+            if (!obj) return;
+            if (!m_linked_group.remove(obj)) m_linked_group.add(obj, m_effect_index);
+            is_changed_link = true;
+        });
+    }
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"選択オブジェクトをリンクに追加/削除", " (%d)"), static_cast<int32_t>(m_linked_group.size()));
+
+    // リンクを解除
+    ImGui::SameLine(0, 0);
+    if (imgui_utils::squareIconButton(ICON_MS_LINK_OFF, "##unlink")) m_linked_group.clear();
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"すべてのリンクを解除"));
 
     ImGui::SameLine();
     ImGui::AlignTextToFramePadding();
-    ImGui::Text((aul2::tr(L"レイヤー") + "=%d, " + aul2::tr(L"フレーム") + "=[%d - %d]").c_str(), m_layer_frame.layer + 1, m_layer_frame.start + 1, m_layer_frame.end + 1);
+    ImGui::Text("%s=%d, %s=[%d - %d]", aul2::tr(L"レイヤー"), m_layer_frame.layer + 1, aul2::tr(L"フレーム"), m_layer_frame.start + 1, m_layer_frame.end + 1);
 
     //
     // グラデーションエディタの描画
@@ -281,25 +403,28 @@ void MainView::renderGradientEditor()
     // 各種ツールボタン
     //
     bool is_reset_all = imgui_utils::squareIconButton(ICON_MS_SYNC, "##reset");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"リセット").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"リセット"));
     ImGui::SameLine();
 
     float tb_width = frame_height * 5 + ImGui::GetStyle().ItemSpacing.x * 4;
     imgui_utils::alignForWidth(tb_width, 1.0f);  // 右揃えにする
     bool is_distribute_marker = imgui_utils::squareIconButton(ICON_MS_ARROW_RANGE, "##distribute");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーを等間隔に配置").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーを等間隔に配置"));
     ImGui::SameLine();
     bool is_distribute_marker_and_midpoint = imgui_utils::squareIconButton(ICON_MS_FORMAT_LETTER_SPACING, "##distribut_bothe");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーと中間点を等間隔に配置").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーと中間点を等間隔に配置"));
     ImGui::SameLine();
     bool is_reset_midpoint = imgui_utils::squareIconButton(ICON_MS_STAT_0, "##reset_midpoints");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"すべての中間点を中央に再配置").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"すべての中間点を中央に再配置"));
     ImGui::SameLine();
     bool is_reverse = imgui_utils::squareIconButton(ICON_MS_SYNC_ALT, "##reverse");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーを反転").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"マーカーを反転"));
     ImGui::SameLine();
     bool is_del = imgui_utils::squareIconButton(ICON_MS_DELETE, "##delete");
-    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"選択中のマーカーを削除").c_str());
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal)) ImGui::SetTooltip(aul2::tr(L"選択中のマーカーを削除"));
+
+    // 反映先のセクション
+    const SectionRange target_sections = m_apply_all_sections ? SectionRange::all() : SectionRange::single(static_cast<uint32_t>(m_target_move_index));
 
     if (is_distribute_marker) data->getMarkerManager()->distributeMarkersEvenly();
     if (is_distribute_marker_and_midpoint) data->getMarkerManager()->distributeMarkersAndMipointsEvenly();
@@ -310,7 +435,8 @@ void MainView::renderGradientEditor()
         data->setBlurWidth(1.0f);
         if (m_apply) {
             plugin2_utils::call_edit_lambda(g_app_state.edit_handle->call_edit_section_param, [&](EDIT_SECTION* edit) {
-                m_script_bridge.resetScriptData(edit, static_cast<uint32_t>(data->getMarkerManager()->getMarkers().size()), MAX_MARKER_COUNT, effect_full_name, m_effect_index, m_target_move_index, MAX_MARKER_COUNT);
+                m_linked_group.removeInvalid(edit, effect_full_name);
+                m_script_bridge.resetScriptData(edit, static_cast<uint32_t>(data->getMarkerManager()->getMarkers().size()), MAX_MARKER_COUNT, effect_full_name, m_effect_index, target_sections, MAX_MARKER_COUNT, m_linked_group.targets());
             });
         }
     }
@@ -348,20 +474,25 @@ void MainView::renderGradientEditor()
                         is_changed_section ||                 // セクションが変更された
                         is_changed_section_effect ||          // 対象とするエフェクトが変更された
                         is_changed_effect_index ||            // 同じエフェクトが複数ある際の対象とするインデックスが変更された
+                        is_changed_all_sections ||            // 全セクションへの反映が切り替えられた
+                        is_changed_link ||                    // リンクするオブジェクトが変更された
                         is_reverse                            // マーカー反転のボタンが押された
                         ));
     // または各値がグラデーションエディタ側で変更されたとき
     // マーカーの削除、リセット、均等配置による変更は isChangedValues() で検知できる
     if (is_changed_apply || (m_apply && m_script_bridge.getIsChangedValues())) {
+        // リンクしたオブジェクトへの反映も同じ編集セクション内でまとめて行う
         plugin2_utils::call_edit_lambda(g_app_state.edit_handle->call_edit_section_param, [&](EDIT_SECTION* edit) {
-            m_script_bridge.applyGradientToScript(edit, *data, effect_full_name, m_effect_index, m_target_move_index);
+            m_linked_group.removeInvalid(edit, effect_full_name);
+            m_script_bridge.applyGradientToScript(edit, *data, effect_full_name, m_effect_index, target_sections, m_linked_group.targets());
         });
     }
 
     // プリセットが変更されたとき、プリセットの範囲外の値はデフォルト値にリセットする
     if (m_apply && m_preset_window.isClickedPreset()) {
         plugin2_utils::call_edit_lambda(g_app_state.edit_handle->call_edit_section_param, [&](EDIT_SECTION* edit) {
-            m_script_bridge.resetScriptData(edit, static_cast<uint32_t>(data->getMarkerManager()->getMarkers().size()), MAX_MARKER_COUNT, effect_full_name, m_effect_index, m_target_move_index, MAX_MARKER_COUNT);
+            m_linked_group.removeInvalid(edit, effect_full_name);
+            m_script_bridge.resetScriptData(edit, static_cast<uint32_t>(data->getMarkerManager()->getMarkers().size()), MAX_MARKER_COUNT, effect_full_name, m_effect_index, target_sections, MAX_MARKER_COUNT, m_linked_group.targets());
         });
     }
 
@@ -384,12 +515,12 @@ void MainView::renderPropertyEditor(GradientData* data)
         ImGui::PushStyleColor(ImGuiCol_Button, colors[ImGuiCol_Button]);
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, colors[ImGuiCol_Button]);
         ImGui::PushStyleColor(ImGuiCol_ButtonActive, colors[ImGuiCol_Button]);
-        ImGui::Button(aul2::tr(L"色").c_str(), size);
-        ImGui::Button(aul2::tr(L"位置").c_str(), size);
-        ImGui::Button(aul2::tr(L"中間点").c_str(), size);
-        ImGui::Button(aul2::tr(L"ぼかし幅").c_str(), size);
-        ImGui::Button(aul2::tr(L"色空間").c_str(), size);
-        ImGui::Button(aul2::tr(L"補間経路").c_str(), size);
+        ImGui::Button(aul2::tr(L"色"), size);
+        ImGui::Button(aul2::tr(L"位置"), size);
+        ImGui::Button(aul2::tr(L"中間点"), size);
+        ImGui::Button(aul2::tr(L"ぼかし幅"), size);
+        ImGui::Button(aul2::tr(L"色空間"), size);
+        ImGui::Button(aul2::tr(L"補間経路"), size);
         ImGui::PopStyleColor(3);
     }
     ImGui::EndChild();
@@ -444,9 +575,9 @@ void MainView::renderPropertyEditor(GradientData* data)
         }
 
         ImGui::SetNextItemWidth(width);
-        if (ImGui::BeginCombo("##interp dir", aul2::tr(str_conv::multiByteToWideChar(INTERP_DIR_NAMES[curr.interp_dir_index]).c_str()).c_str())) {
-            for (uint32_t i = 0; i < IM_ARRAYSIZE(INTERP_DIR_NAMES); i++) {
-                if (ImGui::Selectable(aul2::tr(str_conv::multiByteToWideChar(INTERP_DIR_NAMES[i]).c_str()).c_str(), curr.interp_dir_index == i))
+        if (ImGui::BeginCombo("##interp dir", aul2::tr(INTERP_DIR_LABEL_KEYS[curr.interp_dir_index]))) {
+            for (uint32_t i = 0; i < IM_ARRAYSIZE(INTERP_DIR_LABEL_KEYS); i++) {
+                if (ImGui::Selectable(aul2::tr(INTERP_DIR_LABEL_KEYS[i]), curr.interp_dir_index == i))
                     data->setInterpDir(i);
             }
             ImGui::EndCombo();
@@ -1,29 +1,50 @@
 #ifndef MAIN_VIEW_H
 #define MAIN_VIEW_H
 
+#include <filesystem>
+#include <stop_token>
+#include <vector>
+
 #include "core/app_state.h"
+#include "core/linked_gradient_group.h"
 #include "core/script_bridge.h"
 #include "ui/widgets/gradient_preset.h"
 #include "ui/widgets/menu_bar.h"
 #include "ui/widgets/preset_controller.h"
+#include "ui/widgets/preset_import.h"
+#include "ui/widgets/preset_library.h"
 #include "ui/widgets/preset_window.h"
+#include "ui/widgets/profiler_window.h"
 
 namespace gradient_editor {
 
 class MainView {
 public:
     MainView();
+    ~MainView();
     void render();
 
+    /// @brief バックグラウンドの処理が続いていて、完了を反映するまで毎フレーム描画する必要があるか
+    /// @note ドロップされたファイルの読み込みは、完了時に GUI スレッドに処理の続きが届くため含めない
+    [[nodiscard]] bool isBusy() const { return m_preset_library.isLoading(); }
+
 private:
     void renderGradientEditor();
     void renderPropertyEditor(GradientData* data);
+    void updatePresetLoader();
+    void updatePresetImport();
+    void applyImportResults(std::vector<preset_import::ImportResult> results);
 
     ScriptBridge m_script_bridge;
-    PresetManager m_preset_manager;
-    preset_file::GradientPresetFile m_preset_file;
+    LinkedGradientGroup m_linked_group;
+    PresetLibrary m_preset_library;
     PresetWindow m_preset_window;
+    std::filesystem::path m_thumbnail_cache_path;
+    ProfilerWindow m_profiler_window;
+    std::filesystem::path m_trace_path;
     WindowVisible m_window_visible;
+    bool m_is_importing = false;     // ドロップされたファイルをスレッドプールで読み込んでいるか
+    std::stop_source m_import_stop;  // 破棄する時に読み込みを取り消す
 
     // UI State
     uint32_t m_effect_name_index     = 0;
@@ -32,9 +53,10 @@ private:
     int32_t m_frame_count            = 2;
     OBJECT_LAYER_FRAME m_layer_frame = {0, 0, 0};
 
-    bool m_apply   = false;
-    bool m_load    = false;
-    bool m_is_init = false;
+    bool m_apply              = false;
+    bool m_apply_all_sections = false;
+    bool m_load               = false;
+    bool m_is_init            = false;
 
     // Colors for AviUtl objects
     ImU32 m_object_video_color_start = 0;
@@ -69,7 +69,7 @@ bool GradientData::init(Microsoft::WRL::ComPtr<ID3D11Device> d3d_device, const i
     return true;
 }
 
-std::vector<float> GradientData::getTextureColor(Microsoft::WRL::ComPtr<ID3D11Device> d3d_device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context, const int32_t x, const int32_t y)
+std::array<float, 4> GradientData::getTextureColor(Microsoft::WRL::ComPtr<ID3D11Device> d3d_device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context, const int32_t x, const int32_t y)
 {
     Microsoft::WRL::ComPtr<ID3D11Resource> resource;
     m_rtv->GetResource(&resource);
@@ -84,4 +84,26 @@ std::vector<float> GradientData::getTextureColor(Microsoft::WRL::ComPtr<ID3D11De
     }
 }
 
+std::vector<std::byte> GradientData::readOutputPixels(Microsoft::WRL::ComPtr<ID3D11Device> d3d_device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context)
+{
+    if (!m_rtv) return {};
+
+    Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+    m_rtv->GetResource(&resource);
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> texure;
+    resource.As(&texure);
+
+    auto result = gradient_editor::GradientRenderer::readPixelsFromTexture2D(d3d_device, d3d_device_context, texure.Get());
+    return result ? std::move(result.value()) : std::vector<std::byte>{};
+}
+
+void GradientData::writeOutputPixels(Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context, std::span<const std::byte> pixels)
+{
+    if (!m_rtv || pixels.size() != static_cast<size_t>(m_texture_width) * m_texture_height * 4) return;
+
+    Microsoft::WRL::ComPtr<ID3D11Resource> resource;
+    m_rtv->GetResource(&resource);
+    d3d_device_context->UpdateSubresource(resource.Get(), 0, nullptr, pixels.data(), static_cast<UINT>(m_texture_width * 4), 0);
+}
+
 }  // namespace gradient_editor
@@ -4,10 +4,13 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <numeric>
 #include <ranges>
+#include <span>
 #include <vector>
 
 #include "gradient_marker.h"
@@ -79,9 +82,17 @@ public:
         }
     }
 
-    std::vector<float> getTextureColor(
+    std::array<float, 4> getTextureColor(
         Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
         Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context, const int32_t x, const int32_t y);
+
+    // 描画結果のテクスチャ全体を RGBA8 で読み出す。失敗した場合は空
+    std::vector<std::byte> readOutputPixels(
+        Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context);
+
+    // 描画結果のテクスチャに RGBA8 のピクセルを書き込む。保存しておいた描画結果を描画せずに表示するために使う
+    void writeOutputPixels(Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context, std::span<const std::byte> pixels);
 };
 
 }  // namespace gradient_editor
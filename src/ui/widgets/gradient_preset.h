@@ -1,20 +1,49 @@
 #ifndef GRADIENT_PRESET_H
 #define GRADIENT_PRESET_H
 
+#include <charconv>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "json.hpp"
+#include "preset_binary.h"
 
 namespace preset {
+/// @brief "0xRRGGBBAA" 形式の色を RGBA に変換する
+/// @return 変換できない場合は 0xffffffff
+inline uint32_t parseColor(std::string_view str) noexcept
+{
+    // 先頭の "0x" を除いた 8 文字を 16 進数として扱う
+    if (str.size() <= 2 || str[0] != '0' || (str[1] != 'x' && str[1] != 'X')) return 0xffffffff;
+    std::string_view hex = str.substr(2, 8);
+    uint32_t rgba        = 0xffffffff;
+    auto [ptr, ec]       = std::from_chars(hex.data(), hex.data() + hex.size(), rgba, 16);
+    if (ec != std::errc() || ptr != hex.data() + hex.size()) return 0xffffffff;
+    return rgba;
+}
+
+/// @brief RGBA を "0xRRGGBBAA" 形式に変換する
+inline std::string formatColor(const uint32_t rgba)
+{
+    constexpr char DIGITS[] = "0123456789ABCDEF";
+    std::string str         = "0x00000000";
+    for (int32_t i = 0; i < 8; ++i) {
+        str[9 - i] = DIGITS[(rgba >> (i * 4)) & 0xf];
+    }
+    return str;
+}
+
 class GradientPreset {
 public:
     std::string name{"default"};
-    std::vector<std::string> colors{"0x000000ff", "0xffffffff"};
+    std::vector<uint32_t> colors{0x000000ff, 0xffffffff};  // RGBA。JSON では "0xRRGGBBAA" 形式の文字列
     std::vector<float> positions{0.0f, 1.0f};
     std::vector<float> midpoints{0.5f};
     float blur_width{1.0f};
@@ -24,9 +53,12 @@ public:
 
 inline void to_json(nlohmann::ordered_json& j, const GradientPreset& preset)
 {
+    nlohmann::ordered_json colors = nlohmann::ordered_json::array();
+    for (uint32_t rgba : preset.colors) colors.push_back(formatColor(rgba));
+
     j = nlohmann::ordered_json{
         {"name", preset.name},
-        {"colors", preset.colors},
+        {"colors", std::move(colors)},
         {"positions", preset.positions},
         {"midpoints", preset.midpoints},
         {"blur_width", preset.blur_width},
@@ -37,7 +69,10 @@ inline void to_json(nlohmann::ordered_json& j, const GradientPreset& preset)
 inline void from_json(const nlohmann::ordered_json& j, GradientPreset& preset)
 {
     j.at("name").get_to(preset.name);
-    j.at("colors").get_to(preset.colors);
+    const auto& colors = j.at("colors");
+    preset.colors.clear();
+    preset.colors.reserve(colors.size());
+    for (const auto& color : colors) preset.colors.push_back(parseColor(color.get_ref<const std::string&>()));
     j.at("positions").get_to(preset.positions);
     j.at("midpoints").get_to(preset.midpoints);
     j.at("blur_width").get_to(preset.blur_width);
@@ -49,25 +84,156 @@ inline void from_json(const nlohmann::ordered_json& j, GradientPreset& preset)
 namespace preset_file {
 struct GradientPresetFile {
     std::vector<preset::GradientPreset> presets;
+    uint64_t journal_seq{0};  // このファイルに反映済みのジャーナルの最後の通し番号
+    uint64_t revision{0};     // 変更のたびに増える。キャッシュの破棄に使い、ファイルには保存しない
 };
 
 inline void to_json(nlohmann::ordered_json& j, const GradientPresetFile& preset_file)
 {
     j = nlohmann::ordered_json{{"presets", preset_file.presets}};
+    if (preset_file.journal_seq != 0) j["journal_seq"] = preset_file.journal_seq;
 }
 
 inline void from_json(const nlohmann::ordered_json& j, GradientPresetFile& preset_file)
 {
     j.at("presets").get_to(preset_file.presets);
+    preset_file.journal_seq = j.value("journal_seq", uint64_t{0});
 }
 
 }  // namespace preset_file
 
+namespace preset_journal {
+/// @brief プリセットファイルに対する操作の種類
+enum class OperationType {
+    Add,
+    Delete,
+    Swap,
+    Overwrite,
+};
+
+/// @brief ジャーナルに 1 行で記録するプリセットファイルへの操作
+struct Operation {
+    OperationType type{OperationType::Add};
+    uint32_t index_1{0};            // Delete, Overwrite の対象、Swap の入れ替え元
+    uint32_t index_2{0};            // Swap の入れ替え先
+    preset::GradientPreset preset;  // Add, Overwrite で書き込むプリセット
+    uint64_t seq{0};                // 通し番号
+};
+
+NLOHMANN_JSON_SERIALIZE_ENUM(OperationType, {{OperationType::Add, "add"},
+                                             {OperationType::Delete, "delete"},
+                                             {OperationType::Swap, "swap"},
+                                             {OperationType::Overwrite, "overwrite"}})
+
+inline void to_json(nlohmann::ordered_json& j, const Operation& op)
+{
+    j = nlohmann::ordered_json{{"seq", op.seq}, {"op", op.type}};
+    switch (op.type) {
+        case OperationType::Add:
+            j["preset"] = op.preset;
+            break;
+        case OperationType::Delete:
+            j["index"] = op.index_1;
+            break;
+        case OperationType::Swap:
+            j["index"]   = op.index_1;
+            j["index_2"] = op.index_2;
+            break;
+        case OperationType::Overwrite:
+            j["index"]  = op.index_1;
+            j["preset"] = op.preset;
+            break;
+    }
+}
+
+inline void from_json(const nlohmann::ordered_json& j, Operation& op)
+{
+    j.at("seq").get_to(op.seq);
+    j.at("op").get_to(op.type);
+    op.index_1 = j.value("index", uint32_t{0});
+    op.index_2 = j.value("index_2", uint32_t{0});
+    if (op.type == OperationType::Add || op.type == OperationType::Overwrite) {
+        j.at("preset").get_to(op.preset);
+    }
+}
+
+/// @brief 操作のインデックスがプリセットファイルの範囲内か
+inline bool isValidOperation(const preset_file::GradientPresetFile& file, const Operation& op) noexcept
+{
+    const size_t count = file.presets.size();
+    switch (op.type) {
+        case OperationType::Add:
+            return true;
+        case OperationType::Delete:
+        case OperationType::Overwrite:
+            return op.index_1 < count;
+        case OperationType::Swap:
+            return op.index_1 < count && op.index_2 < count;
+    }
+    return false;
+}
+
+/// @brief 操作をプリセットファイルに適用する
+/// @return インデックスが範囲外の場合は何もせず false
+inline bool applyOperation(preset_file::GradientPresetFile& file, Operation op)
+{
+    if (!isValidOperation(file, op)) return false;
+
+    auto& presets = file.presets;
+    ++file.revision;
+    switch (op.type) {
+        case OperationType::Add:
+            presets.push_back(std::move(op.preset));
+            break;
+        case OperationType::Delete:
+            presets.erase(presets.begin() + op.index_1);
+            break;
+        case OperationType::Swap:
+            std::swap(presets[op.index_1], presets[op.index_2]);
+            break;
+        case OperationType::Overwrite:
+            presets[op.index_1] = std::move(op.preset);
+            break;
+    }
+    return true;
+}
+}  // namespace preset_journal
+
 class PresetManager
     : public preset::GradientPreset,
       public preset_file::GradientPresetFile {
+public:
+    // ジャーナルの行数がこの値に達したらプリセットファイル全体を書き出して圧縮する
+    static constexpr uint32_t JOURNAL_COMPACTION_THRESHOLD = 256;
+
+    /// @brief プリセットファイルとジャーナルの状態。存在しない場合は std::nullopt
+    struct FileStamps {
+        std::optional<preset_binary::SourceStamp> preset;
+        std::optional<preset_binary::SourceStamp> journal;
+
+        bool operator==(const FileStamps&) const = default;
+    };
+
 private:
     std::filesystem::path m_preset_path;
+    uint64_t m_journal_seq{0};       // 最後に記録した操作の通し番号
+    uint32_t m_journal_count{0};     // ジャーナルに記録されている操作の数
+    uint64_t m_write_generation{0};  // 自身が書き込みを行った回数
+    FileStamps m_known_stamps;       // 最後に読み書きした時点のファイルの状態
+
+    std::filesystem::path binaryPath() const
+    {
+        std::filesystem::path path = m_preset_path;
+        path.replace_extension(preset_binary::EXTENSION);
+        return path;
+    }
+
+    void markWritten()
+    {
+        ++m_write_generation;
+        m_known_stamps = currentFileStamps();
+    }
+
     const preset_file::GradientPresetFile DEFAULT_PRESET_FILE{preset_file::GradientPresetFile{.presets = {preset::GradientPreset{}}}};
     inline static const char* DEFAULT_PRESET_FILE_JSON = R"(
 {
@@ -206,59 +372,244 @@ public:
     }
 
     void setPresetFilePath(const std::filesystem::path& path) { m_preset_path = path; }
+    [[nodiscard]] const std::filesystem::path& presetFilePath() const noexcept { return m_preset_path; }
+
+    std::filesystem::path journalPath() const
+    {
+        std::filesystem::path path = m_preset_path;
+        path += ".journal";
+        return path;
+    }
+
+    /// @brief 現在のプリセットファイルとジャーナルの状態を取得する
+    [[nodiscard]] FileStamps currentFileStamps() const
+    {
+        return {preset_binary::getSourceStamp(m_preset_path), preset_binary::getSourceStamp(journalPath())};
+    }
+
+    /// @brief 最後に読み書きした時点の状態。currentFileStamps() と異なれば外部で変更されている
+    [[nodiscard]] const FileStamps& knownFileStamps() const noexcept { return m_known_stamps; }
+
+    /// @brief 書き込みを行うたびに増える値。読み込み中に書き込みが行われたか判別するために使う
+    [[nodiscard]] uint64_t writeGeneration() const noexcept { return m_write_generation; }
+
+    /// @brief 別のインスタンスで読み込んだ結果に合わせて、ジャーナルの状態を引き継ぐ
+    void adoptLoadState(const PresetManager& loaded)
+    {
+        m_journal_seq   = loaded.m_journal_seq;
+        m_journal_count = loaded.m_journal_count;
+        m_known_stamps  = loaded.m_known_stamps;
+    }
 
     struct PresetLoadResult {
         preset_file::GradientPresetFile preset_file;
-        std::string error;  // 空なら成功
+        std::string error;                                              // 空なら成功
+        std::optional<preset_binary::SourceStamp> stale_binary_source;  // バイナリを作り直す必要がある場合、読み込んだ JSON の状態
+        bool needs_compaction = false;                                  // ジャーナルに壊れた行があるか、行数がしきい値に達した
     };
-    PresetLoadResult loadPresetFile() const
+    /// @brief プリセットファイルを読み込み、ジャーナルに記録された操作を順に適用する
+    /// @note ファイルには書き込まないため、ワーカースレッドで呼んでもよい。
+    ///       ジャーナルの圧縮とバイナリの更新は、結果を受け取った側が finishLoad() で行う
+    PresetLoadResult loadPresetFile()
     {
         PresetLoadResult result;
         result.preset_file = DEFAULT_PRESET_FILE;
+        m_journal_count    = 0;
 
-        std::ifstream ifs(m_preset_path);
-        if (!ifs) {
+        // 読み込み中に外部で変更された場合に検知できるよう、読み込む前の状態を基準にする
+        const FileStamps stamps = currentFileStamps();
+        const auto& source      = stamps.preset;
+        if (!source) {
             result.error = "preset file open failed";
             return result;
         }
 
-        nlohmann::ordered_json j;
-        try {
-            j                  = nlohmann::ordered_json::parse(ifs);
-            result.preset_file = j.get<preset_file::GradientPresetFile>();
-        } catch (const nlohmann::json::exception& e) {
-            result.error = e.what();
+        // JSON が更新されていなければ、メモリマップしたバイナリから解析せずに読み込む
+        if (auto cached = preset_binary::readFile(binaryPath(), source)) {
+            result.preset_file = std::move(*cached);
+        } else {
+            std::ifstream ifs(m_preset_path);
+            if (!ifs) {
+                result.error = "preset file open failed";
+                return result;
+            }
+
+            nlohmann::ordered_json j;
+            try {
+                j                  = nlohmann::ordered_json::parse(ifs);
+                result.preset_file = j.get<preset_file::GradientPresetFile>();
+            } catch (const nlohmann::json::exception& e) {
+                result.error = e.what();
+                return result;
+            }
+            result.stale_binary_source = source;
         }
+        m_journal_seq = result.preset_file.journal_seq;
+
+        // ジャーナルの再生
+        bool is_torn = false;
+        if (std::ifstream journal{journalPath()}) {
+            std::string line;
+            while (std::getline(journal, line)) {
+                if (line.empty()) continue;
 
+                preset_journal::Operation op;
+                try {
+                    op = nlohmann::ordered_json::parse(line).get<preset_journal::Operation>();
+                } catch (const nlohmann::json::exception&) {
+                    // 書き込み途中で終了した行以降は破棄する
+                    is_torn = true;
+                    break;
+                }
+
+                // 圧縮後にジャーナルの削除が完了しなかった場合、反映済みの操作が残っている
+                if (op.seq <= m_journal_seq) continue;
+                m_journal_seq = op.seq;
+                preset_journal::applyOperation(result.preset_file, std::move(op));
+                ++m_journal_count;
+            }
+        }
+
+        // 壊れた行の後ろに追記しないよう、追記する前に圧縮する必要がある
+        result.needs_compaction = is_torn || m_journal_count >= JOURNAL_COMPACTION_THRESHOLD;
+
+        m_known_stamps = stamps;
         return result;
     };
 
+
     struct PresetWriteResult {
         bool is_success;
         std::string error;
     };
+    /// @brief プリセットファイル全体を書き出し、ジャーナルを空にする
+    /// @note 一時ファイルに書き出してから置き換えるため、書き込み途中で終了しても元のファイルは壊れない
     PresetWriteResult writePresetFile(const preset_file::GradientPresetFile& preset_file)
     {
         PresetWriteResult result{false, {}};
 
-        nlohmann::ordered_json j = preset_file;
-        std::ofstream ofs(m_preset_path);
-        if (!ofs) {
-            result.error = "failed to open preset file";
+        std::filesystem::path tmp_path = m_preset_path;
+        tmp_path += ".tmp";
+
+        try {
+            nlohmann::ordered_json j = preset_file;
+            j["journal_seq"]         = m_journal_seq;
+
+            std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+            if (!ofs) {
+                result.error = "failed to open preset file";
+                return result;
+            }
+            ofs << j.dump(4);
+            ofs.close();
+            if (!ofs) {
+                result.error = "failed to write preset file";
+                return result;
+            }
+        } catch (const nlohmann::json::exception& e) {
+            result.error = e.what();
             return result;
         }
 
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, m_preset_path, ec);
+        if (ec) {
+            result.error = ec.message();
+            return result;
+        }
+
+        // 反映済みの操作は journal_seq で判別できるため、削除に失敗しても整合性は保たれる
+        std::filesystem::remove(journalPath(), ec);
+        m_journal_count = 0;
+
+        // 次回の起動時に JSON を解析しないよう、バイナリも更新しておく
+        if (auto source = preset_binary::getSourceStamp(m_preset_path)) {
+            preset_binary::writeFile(binaryPath(), preset_file, *source, m_journal_seq);
+        }
+
+        markWritten();
+        result.is_success = true;
+        return result;
+    }
+
+    /// @brief ジャーナルに 1 行追記し、成功した場合のみ操作をプリセットファイルに適用する
+    /// @note ファイル全体の書き出しは、ジャーナルの行数が JOURNAL_COMPACTION_THRESHOLD に達したときのみ行う。
+    ///       失敗した場合 preset_file は変更しないため、メモリ上の内容がファイルより先に進むことはない
+    PresetWriteResult commitOperation(preset_file::GradientPresetFile& preset_file, preset_journal::Operation op)
+    {
+        PresetWriteResult result{false, {}};
+
+        if (!preset_journal::isValidOperation(preset_file, op)) {
+            result.error = "preset index out of range";
+            return result;
+        }
+
+        op.seq = m_journal_seq + 1;
+
+        std::string line;
         try {
-            std::string serialized_string = j.dump(4);
-            ofs << serialized_string;
+            line = nlohmann::ordered_json(op).dump();
         } catch (const nlohmann::json::exception& e) {
             result.error = e.what();
+            return result;
+        }
+
+        std::ofstream ofs(journalPath(), std::ios::binary | std::ios::app);
+        if (ofs) {
+            line.push_back('\n');
+            ofs.write(line.data(), static_cast<std::streamsize>(line.size()));
+            ofs.flush();
+        }
+        if (!ofs) {
+            // ジャーナルに追記できない場合は、適用した結果をファイル全体として書き出す。書き出せた場合のみ差し替える
+            preset_file::GradientPresetFile staged = preset_file;
+            preset_journal::applyOperation(staged, std::move(op));
+            ++m_journal_seq;
+            result = writePresetFile(staged);
+            if (result.is_success) {
+                preset_file = std::move(staged);
+            } else {
+                --m_journal_seq;
+            }
+            return result;
+        }
+
+        preset_journal::applyOperation(preset_file, std::move(op));
+        ++m_journal_seq;
+        ++m_journal_count;
+        markWritten();
+        if (m_journal_count >= JOURNAL_COMPACTION_THRESHOLD) {
+            // 操作はジャーナルに記録済みのため、圧縮に失敗してもメモリとファイルの内容は一致している
+            return writePresetFile(preset_file);
         }
 
         result.is_success = true;
         return result;
     }
 
+    /// @brief ジャーナルを圧縮する。記録された操作がない場合と、外部でファイルが変更されている場合は何もしない
+    /// @note 終了時に呼び、次回の起動でジャーナルを再生しなくて済むようにする
+    PresetWriteResult compact(const preset_file::GradientPresetFile& preset_file)
+    {
+        if (m_journal_count == 0 || currentFileStamps() != m_known_stamps) return {true, {}};
+        return writePresetFile(preset_file);
+    }
+
+    /// @brief loadPresetFile() で行わなかったジャーナルの圧縮とバイナリの更新を行う
+    /// @note ジャーナルに追記するインスタンス (GUI スレッド) で、adoptLoadState() の後に呼ぶ。
+    ///       読み込んだ後にファイルが変更されていた場合は、変更を失わないよう何もしない
+    PresetWriteResult finishLoad(const preset_file::GradientPresetFile& preset_file, const PresetLoadResult& load_result)
+    {
+        if (currentFileStamps() != m_known_stamps) return {true, {}};
+        if (load_result.needs_compaction) return writePresetFile(preset_file);
+
+        // ジャーナルを適用した後の内容を保存し、次回は journal_seq より後の操作のみ適用させる
+        if (load_result.stale_binary_source) {
+            preset_binary::writeFile(binaryPath(), preset_file, *load_result.stale_binary_source, m_journal_seq);
+        }
+        return {true, {}};
+    }
+
     void createDefaultPresetFile(const std::filesystem::path& file_path)
     {
         std::ofstream ofs(file_path);
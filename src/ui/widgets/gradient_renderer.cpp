@@ -1,5 +1,9 @@
 #include "gradient_renderer.h"
 
+#include <cstring>
+
+#include "utils/common/frame_profiler.h"
+
 namespace gradient_editor {
 
 bool GradientRenderer::init(
@@ -317,6 +321,8 @@ void GradientRenderer::runOffscreenRendering(
     ID3D11RenderTargetView* rtv,
     ID3D11ShaderResourceView* srv)
 {
+    frame_profiler::ScopedZone zone{"runOffscreenRendering"};
+
     // 現在のステートを保存
     D3DStateSaver saver(d3d_device_context);
 
@@ -369,14 +375,14 @@ void GradientRenderer::runOffscreenRendering(
     d3d_device_context->PSSetShaderResources(0, 1, null_srv);
 }
 
-std::expected<std::vector<float>, std::string> GradientRenderer::readPixelColorFromTexture2D(
+std::expected<std::array<float, 4>, std::string> GradientRenderer::readPixelColorFromTexture2D(
     Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
     Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context,
     ID3D11Texture2D* source_texture,
     int32_t x,
     int32_t y)
 {
-    std::vector<float> color(4);
+    std::array<float, 4> color{};
 
     // CPU 読み取り用のステージングテクスチャを作る
     ID3D11Texture2D* staging_texture = nullptr;
@@ -427,4 +433,44 @@ std::expected<std::vector<float>, std::string> GradientRenderer::readPixelColorF
 
     return color;
 }
+
+std::expected<std::vector<std::byte>, std::string> GradientRenderer::readPixelsFromTexture2D(
+    Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
+    Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context,
+    ID3D11Texture2D* source_texture)
+{
+    D3D11_TEXTURE2D_DESC desc;
+    source_texture->GetDesc(&desc);
+    if (desc.Format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+        return std::unexpected{"unsupported texture format"};
+    }
+
+    desc.MipLevels      = 1;
+    desc.ArraySize      = 1;
+    desc.Usage          = D3D11_USAGE_STAGING;
+    desc.BindFlags      = 0;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    desc.MiscFlags      = 0;
+
+    Microsoft::WRL::ComPtr<ID3D11Texture2D> staging_texture;
+    if (FAILED(d3d_device->CreateTexture2D(&desc, nullptr, staging_texture.GetAddressOf()))) {
+        return std::unexpected{"create texture2d error"};
+    }
+    d3d_device_context->CopyResource(staging_texture.Get(), source_texture);
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(d3d_device_context->Map(staging_texture.Get(), 0, D3D11_MAP_READ, 0, &mapped))) {
+        return std::unexpected{"map texture2d error"};
+    }
+
+    // 行ごとの余白 (RowPitch) を詰めてコピーする
+    const size_t row_size = static_cast<size_t>(desc.Width) * 4;
+    std::vector<std::byte> pixels(row_size * desc.Height);
+    for (UINT y = 0; y < desc.Height; ++y) {
+        std::memcpy(pixels.data() + row_size * y, static_cast<const std::byte*>(mapped.pData) + static_cast<size_t>(mapped.RowPitch) * y, row_size);
+    }
+    d3d_device_context->Unmap(staging_texture.Get(), 0);
+
+    return pixels;
+}
 }  // namespace gradient_editor
@@ -4,7 +4,9 @@
 #include <d3d11.h>
 #include <wrl/client.h>
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <expected>
 #include <iostream>
 #include <string>
@@ -177,12 +179,18 @@ public:
         ID3D11RenderTargetView* rtv,
         ID3D11ShaderResourceView* srv);
 
-    static std::expected<std::vector<float>, std::string> readPixelColorFromTexture2D(
+    static std::expected<std::array<float, 4>, std::string> readPixelColorFromTexture2D(
         Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
         Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context,
         ID3D11Texture2D* source_texture,
         int32_t x,
         int32_t y);
+
+    // テクスチャ全体を RGBA8 で読み出す (行の間に余白は入れない)
+    static std::expected<std::vector<std::byte>, std::string> readPixelsFromTexture2D(
+        Microsoft::WRL::ComPtr<ID3D11Device> d3d_device,
+        Microsoft::WRL::ComPtr<ID3D11DeviceContext> d3d_device_context,
+        ID3D11Texture2D* source_texture);
 };
 }  // namespace gradient_editor
 
@@ -1,5 +1,7 @@
 #include "gradient_widget.h"
 
+#include "utils/common/frame_profiler.h"
+
 namespace CustomUI {
 
 Microsoft::WRL::ComPtr<ID3D11Device> g_d3d_device                = nullptr;
@@ -9,6 +11,7 @@ gradient_editor::GradientRenderer::RenderResources g_resources;
 // グラデーションデータを保持するマップ
 std::unordered_map<std::string, std::unique_ptr<gradient_editor::GradientData>> g_editor_gradients;
 std::unordered_map<std::string, std::unique_ptr<gradient_editor::GradientData>> g_button_gradients;
+GradientThumbnailCache g_button_thumbnails{256};
 
 void initDX11(Microsoft::WRL::ComPtr<ID3D11Device> device, Microsoft::WRL::ComPtr<ID3D11DeviceContext> context)
 {
@@ -21,6 +24,7 @@ void cleanup()
 {
     g_editor_gradients.clear();
     g_button_gradients.clear();
+    g_button_thumbnails.clear();
 
     g_resources.cleanup();
 
@@ -42,6 +46,8 @@ gradient_editor::GradientData* drawGradientEditor(
     bool replace_data,
     GradientEditorConfig config)
 {
+    frame_profiler::ScopedZone zone{"drawGradientEditor"};
+
     // レンダラーの初期化に失敗していたら早期終了
     if (!g_d3d_device || !g_d3d_device_context) {
         return nullptr;
@@ -169,8 +175,8 @@ gradient_editor::GradientData* drawGradientEditor(
             mouse_pos_on_texture.y = (mouse_pos.y - gradient_marker->getGradientRegionP0().y) * t;
             return mouse_pos_on_texture;
         }();
-        std::vector<float> texture_color = gradient_data->getTextureColor(g_d3d_device, g_d3d_device_context, static_cast<int32_t>(mouse_pos_on_texture.x), static_cast<int32_t>(mouse_pos_on_texture.y));
-        new_marker_color                 = ImVec4(texture_color[0], texture_color[1], texture_color[2], texture_color[3]);
+        std::array<float, 4> texture_color = gradient_data->getTextureColor(g_d3d_device, g_d3d_device_context, static_cast<int32_t>(mouse_pos_on_texture.x), static_cast<int32_t>(mouse_pos_on_texture.y));
+        new_marker_color                   = ImVec4(texture_color[0], texture_color[1], texture_color[2], texture_color[3]);
     } else {
         new_marker_color = gradient_marker->getSelectedMarkerColor();
     }
@@ -216,8 +222,11 @@ ID3D11ShaderResourceView* getGradientSrv(
         gradient_datas[label].get()->setInterpDir(data.m_interp_dir);
     }
 
-    auto* gradient_data = it->second.get();
+    return renderGradient(it->second.get(), display_size);
+}
 
+ID3D11ShaderResourceView* renderGradient(gradient_editor::GradientData* gradient_data, const ImVec2& display_size)
+{
     int32_t current_width  = static_cast<int32_t>(display_size.x);
     int32_t current_height = static_cast<int32_t>(display_size.y);
 
@@ -248,6 +257,50 @@ ID3D11ShaderResourceView* getGradientSrv(
     return gradient_data->getOutputSrv();
 }
 
+ID3D11ShaderResourceView* GradientThumbnailCache::get(const uint64_t key, const uint64_t content_hash, const ImVec2& display_size, const gradient_editor::GradientData& data, thumbnail_cache::ThumbnailDiskCache* disk_cache)
+{
+    // レンダラーの初期化に失敗していたら早期終了
+    if (!g_d3d_device || !g_d3d_device_context) {
+        return nullptr;
+    }
+
+    int32_t width  = static_cast<int32_t>(display_size.x);
+    int32_t height = static_cast<int32_t>(display_size.y);
+
+    const auto slot = m_lru.acquire(key, content_hash, width, height);
+    if (slot.index >= m_gradients.size()) m_gradients.resize(slot.index + 1);
+    if (!m_gradients[slot.index]) m_gradients[slot.index] = std::make_unique<gradient_editor::GradientData>();
+
+    gradient_editor::GradientData* gradient = m_gradients[slot.index].get();
+    if (!slot.needs_render && gradient->getOutputSrv()) return gradient->getOutputSrv();
+
+    // 新規作成、スロットの引き継ぎ、内容の変更、サイズの変更があった場合のみ描画する
+    gradient->getMarkerManager()->setDefaultMarkers(data.m_marker_manager.getMarkers());
+    gradient->setBlurWidth(data.m_blur_width);
+    gradient->setColorSpace(data.m_color_space);
+    gradient->setInterpDir(data.m_interp_dir);
+    if (!disk_cache) return renderGradient(gradient, display_size);
+
+    // 以前の起動で描画したものがあれば、描画せずにピクセルを書き込む
+    if (auto pixels = disk_cache->find(content_hash, width, height); !pixels.empty()) {
+        if (gradient->getTextureWidth() != width || gradient->getTextureHeight() != height || !gradient->getOutputSrv()) {
+            gradient->init(g_d3d_device, width, height);
+        }
+        gradient->writeOutputPixels(g_d3d_device_context, pixels);
+        return gradient->getOutputSrv();
+    }
+
+    ID3D11ShaderResourceView* srv = renderGradient(gradient, display_size);
+    disk_cache->store(content_hash, width, height, gradient->readOutputPixels(g_d3d_device, g_d3d_device_context));
+    return srv;
+}
+
+void GradientThumbnailCache::clear()
+{
+    m_lru.clear();
+    m_gradients.clear();
+}
+
 bool drawGradientButton(const std::string label, const ImVec2& display_size, const gradient_editor::GradientData& data)
 {
     ImVec2 gradient_size                   = ImVec2(display_size.x - ImGui::GetStyle().FramePadding.x * 2.0f, display_size.y - ImGui::GetStyle().FramePadding.y * 2.0f);
@@ -255,4 +308,23 @@ bool drawGradientButton(const std::string label, const ImVec2& display_size, con
     return ImGui::ImageButton(label.c_str(), (ImTextureID)(intptr_t)gradient_srv, gradient_size);
 }
 
+bool drawGradientButton(const std::string& label, const ImVec2& display_size, const uint64_t key, const uint64_t content_hash, const gradient_editor::GradientData& data, thumbnail_cache::ThumbnailDiskCache* disk_cache)
+{
+    ImVec2 gradient_size                   = ImVec2(display_size.x - ImGui::GetStyle().FramePadding.x * 2.0f, display_size.y - ImGui::GetStyle().FramePadding.y * 2.0f);
+    ID3D11ShaderResourceView* gradient_srv = g_button_thumbnails.get(key, content_hash, gradient_size, data, disk_cache);
+    return ImGui::ImageButton(label.c_str(), (ImTextureID)(intptr_t)gradient_srv, gradient_size);
+}
+
+uint64_t thumbnailRendererId()
+{
+    // コンパイル済みのシェーダーのバイト列の FNV-1a
+    static const uint64_t id = [] {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const BYTE b : g_psmain) hash = (hash ^ b) * 0x100000001b3ull;
+        for (const BYTE b : g_vsmain) hash = (hash ^ b) * 0x100000001b3ull;
+        return hash;
+    }();
+    return id;
+}
+
 }  // namespace CustomUI
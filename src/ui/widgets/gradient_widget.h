@@ -8,9 +8,12 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "gradient_data.h"
 #include "gradient_renderer.h"
+#include "thumbnail_disk_cache.h"
+#include "thumbnail_lru.h"
 
 namespace CustomUI {
 
@@ -27,6 +30,9 @@ void initDX11(Microsoft::WRL::ComPtr<ID3D11Device> device, Microsoft::WRL::ComPt
 
 void cleanup();
 
+// gradient_data のテクスチャに描画する
+ID3D11ShaderResourceView* renderGradient(gradient_editor::GradientData* gradient_data, const ImVec2& display_size);
+
 ID3D11ShaderResourceView* getGradientSrv(
     std::unordered_map<std::string, std::unique_ptr<gradient_editor::GradientData>>& gradient_datas,
     const std::string label,
@@ -38,6 +44,51 @@ bool drawGradientButton(
     const ImVec2& display_size,
     const gradient_editor::GradientData& data);
 
+/// @brief グラデーションのテクスチャ (サムネイル) を保持する容量付きのキャッシュ
+/// @note 内容が変わらない限り再描画しない。容量を超えた場合は最も長く使われていないものを破棄し、そのテクスチャを再利用する
+class GradientThumbnailCache {
+public:
+    explicit GradientThumbnailCache(const size_t capacity)
+        : m_lru{capacity}
+    {
+    }
+
+    /// @brief サムネイルを取得する。キャッシュにない場合、または内容かサイズが変わった場合のみ描画する
+    /// @param key サムネイルを識別するキー
+    /// @param content_hash data の内容のハッシュ
+    /// @param display_size 表示サイズ
+    /// @param data グラデーションデータ
+    /// @param disk_cache 指定した場合、描画する前にディスクキャッシュを探し、描画した結果はディスクキャッシュに登録する
+    ID3D11ShaderResourceView* get(const uint64_t key, const uint64_t content_hash, const ImVec2& display_size, const gradient_editor::GradientData& data, thumbnail_cache::ThumbnailDiskCache* disk_cache = nullptr);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const noexcept { return m_lru.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_lru.capacity(); }
+
+private:
+    thumbnail_cache::ThumbnailLru m_lru;
+    std::vector<std::unique_ptr<gradient_editor::GradientData>> m_gradients;  // LRU のスロット番号 -> テクスチャを持つグラデーション
+};
+
+/// @brief サムネイルのキャッシュを使ってグラデーションのボタンを描画する
+/// @param label ボタンのラベル
+/// @param display_size 表示サイズ
+/// @param key サムネイルを識別するキー
+/// @param content_hash data の内容のハッシュ。一致する場合は再描画しない
+/// @param data グラデーションデータ
+/// @param disk_cache サムネイルのディスクキャッシュ。nullptr の場合は使わない
+bool drawGradientButton(
+    const std::string& label,
+    const ImVec2& display_size,
+    const uint64_t key,
+    const uint64_t content_hash,
+    const gradient_editor::GradientData& data,
+    thumbnail_cache::ThumbnailDiskCache* disk_cache = nullptr);
+
+/// @brief サムネイルを描画するシェーダーの識別子。シェーダーが変わった場合にディスクキャッシュを無効にするために使う
+uint64_t thumbnailRendererId();
+
 // 描画前にユーザーが設定できるオプション
 struct GradientEditorConfig {
     uint32_t max_marker_count = 30;     // 最大マーカー数。最大マーカー数を超えると新規マーカー追加不可
@@ -27,8 +27,9 @@ void MenuBar::render(WindowVisible* window_visible)
         }
 
         // 表示メニュー
-        if (ImGui::BeginMenu(aul2::tr(L"表示").c_str())) {
-            ImGui::MenuItem(aul2::tr(L"プリセット").c_str(), nullptr, &window_visible->preset_window);
+        if (ImGui::BeginMenu(aul2::tr(L"表示"))) {
+            ImGui::MenuItem(aul2::tr(L"プリセット"), nullptr, &window_visible->preset_window);
+            ImGui::MenuItem(aul2::tr(L"プロファイラ"), nullptr, &window_visible->profiler_window);
             ImGui::EndMenu();
         }
         ImGui::EndMenuBar();
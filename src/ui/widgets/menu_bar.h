@@ -4,7 +4,8 @@
 namespace gradient_editor {
 
 struct WindowVisible {
-    bool preset_window = true;
+    bool preset_window   = true;
+    bool profiler_window = false;
 };
 
 class MenuBar {
@@ -0,0 +1,211 @@
+#include "preset_binary.h"
+
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#include "gradient_preset.h"
+
+namespace preset_binary {
+
+namespace {
+// 要素の範囲が配列に収まっているか
+bool inRange(const uint32_t offset, const uint32_t count, const uint32_t total) noexcept
+{
+    return offset <= total && count <= total - offset;
+}
+
+template <typename T>
+void appendBytes(std::vector<std::byte>& out, const T* data, const size_t count)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (count == 0) return;
+
+    // insert() は GCC 12 で誤った -Wstringop-overflow の警告が出るため、広げてからコピーする
+    const size_t offset = out.size();
+    out.resize(offset + sizeof(T) * count);
+    std::memcpy(out.data() + offset, data, sizeof(T) * count);
+}
+}  // namespace
+
+std::optional<SourceStamp> getSourceStamp(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return std::nullopt;
+    return SourceStamp{.size = static_cast<uint64_t>(size), .time = static_cast<int64_t>(time.time_since_epoch().count())};
+}
+
+bool View::open(std::span<const std::byte> bytes)
+{
+    *this = View{};
+    if (bytes.size() < sizeof(Header)) return false;
+
+    const auto* header = reinterpret_cast<const Header*>(bytes.data());
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) return false;
+
+    // 各領域が収まるか検証する
+    const uint64_t records_size   = uint64_t{header->preset_count} * sizeof(PresetRecord);
+    const uint64_t colors_size    = uint64_t{header->color_count} * sizeof(uint32_t);
+    const uint64_t positions_size = uint64_t{header->position_count} * sizeof(float);
+    const uint64_t midpoints_size = uint64_t{header->midpoint_count} * sizeof(float);
+    const uint64_t total_size     = sizeof(Header) + records_size + colors_size + positions_size + midpoints_size + header->string_table_size;
+    if (total_size > bytes.size()) return false;
+
+    const std::byte* p  = bytes.data() + sizeof(Header);
+    const auto* records = reinterpret_cast<const PresetRecord*>(p);
+    p += records_size;
+    const auto* colors = reinterpret_cast<const uint32_t*>(p);
+    p += colors_size;
+    const auto* positions = reinterpret_cast<const float*>(p);
+    p += positions_size;
+    const auto* midpoints = reinterpret_cast<const float*>(p);
+    p += midpoints_size;
+    const auto* strings = reinterpret_cast<const char*>(p);
+
+    for (uint32_t i = 0; i < header->preset_count; ++i) {
+        const PresetRecord& r = records[i];
+        if (!inRange(r.name_offset, r.name_size, header->string_table_size) ||
+            !inRange(r.color_offset, r.color_count, header->color_count) ||
+            !inRange(r.position_offset, r.position_count, header->position_count) ||
+            !inRange(r.midpoint_offset, r.midpoint_count, header->midpoint_count)) {
+            return false;
+        }
+    }
+
+    m_header    = header;
+    m_records   = records;
+    m_colors    = colors;
+    m_positions = positions;
+    m_midpoints = midpoints;
+    m_strings   = strings;
+    return true;
+}
+
+std::string_view View::name(const uint32_t index) const noexcept
+{
+    const PresetRecord& r = m_records[index];
+    return {m_strings + r.name_offset, r.name_size};
+}
+
+std::span<const uint32_t> View::colors(const uint32_t index) const noexcept
+{
+    const PresetRecord& r = m_records[index];
+    return {m_colors + r.color_offset, r.color_count};
+}
+
+std::span<const float> View::positions(const uint32_t index) const noexcept
+{
+    const PresetRecord& r = m_records[index];
+    return {m_positions + r.position_offset, r.position_count};
+}
+
+std::span<const float> View::midpoints(const uint32_t index) const noexcept
+{
+    const PresetRecord& r = m_records[index];
+    return {m_midpoints + r.midpoint_offset, r.midpoint_count};
+}
+
+std::vector<std::byte> serialize(const preset_file::GradientPresetFile& file, const SourceStamp& source, const uint64_t journal_seq)
+{
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version     = VERSION;
+    header.journal_seq = journal_seq;
+    header.source      = source;
+
+    std::vector<PresetRecord> records;
+    std::vector<uint32_t> colors;
+    std::vector<float> positions;
+    std::vector<float> midpoints;
+    std::string strings;
+    records.reserve(file.presets.size());
+
+    for (const auto& preset : file.presets) {
+        PresetRecord r{};
+        r.name_offset        = static_cast<uint32_t>(strings.size());
+        r.name_size          = static_cast<uint32_t>(preset.name.size());
+        r.color_offset       = static_cast<uint32_t>(colors.size());
+        r.color_count        = static_cast<uint32_t>(preset.colors.size());
+        r.position_offset    = static_cast<uint32_t>(positions.size());
+        r.position_count     = static_cast<uint32_t>(preset.positions.size());
+        r.midpoint_offset    = static_cast<uint32_t>(midpoints.size());
+        r.midpoint_count     = static_cast<uint32_t>(preset.midpoints.size());
+        r.blur_width         = preset.blur_width;
+        r.color_space        = preset.color_space;
+        r.interpolation_path = preset.interpolation_path;
+        records.push_back(r);
+
+        strings += preset.name;
+        colors.insert(colors.end(), preset.colors.begin(), preset.colors.end());
+        positions.insert(positions.end(), preset.positions.begin(), preset.positions.end());
+        midpoints.insert(midpoints.end(), preset.midpoints.begin(), preset.midpoints.end());
+    }
+
+    header.preset_count      = static_cast<uint32_t>(records.size());
+    header.color_count       = static_cast<uint32_t>(colors.size());
+    header.position_count    = static_cast<uint32_t>(positions.size());
+    header.midpoint_count    = static_cast<uint32_t>(midpoints.size());
+    header.string_table_size = static_cast<uint32_t>(strings.size());
+
+    std::vector<std::byte> out;
+    out.reserve(sizeof(Header) + records.size() * sizeof(PresetRecord) + (colors.size() + positions.size() + midpoints.size()) * 4 + strings.size());
+    appendBytes(out, &header, 1);
+    appendBytes(out, records.data(), records.size());
+    appendBytes(out, colors.data(), colors.size());
+    appendBytes(out, positions.data(), positions.size());
+    appendBytes(out, midpoints.data(), midpoints.size());
+    appendBytes(out, strings.data(), strings.size());
+    return out;
+}
+
+preset_file::GradientPresetFile deserialize(const View& view)
+{
+    preset_file::GradientPresetFile file;
+    file.journal_seq = view.header().journal_seq;
+    file.presets.resize(view.presetCount());
+
+    for (uint32_t i = 0; i < view.presetCount(); ++i) {
+        const PresetRecord& r = view.record(i);
+        auto& preset          = file.presets[i];
+
+        preset.name = view.name(i);
+        preset.colors.assign(view.colors(i).begin(), view.colors(i).end());
+        preset.positions.assign(view.positions(i).begin(), view.positions(i).end());
+        preset.midpoints.assign(view.midpoints(i).begin(), view.midpoints(i).end());
+        preset.blur_width         = r.blur_width;
+        preset.color_space        = r.color_space;
+        preset.interpolation_path = r.interpolation_path;
+    }
+    return file;
+}
+
+bool writeFile(const std::filesystem::path& path, const preset_file::GradientPresetFile& file, const SourceStamp& source, const uint64_t journal_seq)
+{
+    std::vector<std::byte> bytes = serialize(file, source, journal_seq);
+
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!ofs) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    return !ec;
+}
+
+std::optional<preset_file::GradientPresetFile> readFile(const std::filesystem::path& path, const std::optional<SourceStamp>& expected_source)
+{
+    MappedLibrary library;
+    if (!library.open(path)) return std::nullopt;
+    if (expected_source && library.view().header().source != *expected_source) return std::nullopt;
+    return deserialize(library.view());
+}
+
+}  // namespace preset_binary
@@ -0,0 +1,130 @@
+#ifndef PRESET_BINARY_H
+#define PRESET_BINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "utils/common/mapped_file.h"
+
+namespace preset_file {
+struct GradientPresetFile;
+}
+
+/// @brief プリセットライブラリのバイナリ形式
+/// @note レイアウト (すべてリトルエンディアン、4 バイト境界):
+///       Header | PresetRecord[preset_count] | u32 RGBA[color_count] | f32[position_count] | f32[midpoint_count] | 文字列テーブル (UTF-8)
+///       メモリマップした領域をそのまま参照して読み込むため、テキストの解析は行わない
+namespace preset_binary {
+
+inline constexpr char MAGIC[4]    = {'G', 'E', 'P', 'B'};
+inline constexpr uint32_t VERSION = 1;
+inline constexpr char EXTENSION[] = ".bin";
+
+/// @brief 元になった JSON ファイルの状態。一致しない場合はバイナリを使わない
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t time  = 0;  // 更新日時
+
+    bool operator==(const SourceStamp&) const = default;
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t journal_seq;
+    SourceStamp source;
+    uint32_t preset_count;
+    uint32_t color_count;
+    uint32_t position_count;
+    uint32_t midpoint_count;
+    uint32_t string_table_size;
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 56 && std::is_trivially_copyable_v<Header>);
+
+struct PresetRecord {
+    uint32_t name_offset;   // 文字列テーブル内の位置
+    uint32_t name_size;
+    uint32_t color_offset;  // 各配列内の要素の位置
+    uint32_t color_count;
+    uint32_t position_offset;
+    uint32_t position_count;
+    uint32_t midpoint_offset;
+    uint32_t midpoint_count;
+    float blur_width;
+    int32_t color_space;
+    int32_t interpolation_path;
+};
+static_assert(sizeof(PresetRecord) == 44 && std::is_trivially_copyable_v<PresetRecord>);
+
+/// @brief ファイルの状態を取得する
+std::optional<SourceStamp> getSourceStamp(const std::filesystem::path& path);
+
+/// @brief バイナリ形式のプリセットライブラリを参照するビュー。領域のコピーは行わない
+class View {
+public:
+    /// @brief ヘッダと各レコードの範囲を検証する
+    /// @return 不正なデータの場合は false
+    bool open(std::span<const std::byte> bytes);
+
+    [[nodiscard]] const Header& header() const noexcept { return *m_header; }
+    [[nodiscard]] uint32_t presetCount() const noexcept { return m_header ? m_header->preset_count : 0; }
+    [[nodiscard]] const PresetRecord& record(const uint32_t index) const noexcept { return m_records[index]; }
+
+    [[nodiscard]] std::string_view name(const uint32_t index) const noexcept;
+    [[nodiscard]] std::span<const uint32_t> colors(const uint32_t index) const noexcept;
+    [[nodiscard]] std::span<const float> positions(const uint32_t index) const noexcept;
+    [[nodiscard]] std::span<const float> midpoints(const uint32_t index) const noexcept;
+
+private:
+    const Header* m_header        = nullptr;
+    const PresetRecord* m_records = nullptr;
+    const uint32_t* m_colors      = nullptr;
+    const float* m_positions      = nullptr;
+    const float* m_midpoints      = nullptr;
+    const char* m_strings         = nullptr;
+};
+
+/// @brief メモリマップしたバイナリ形式のプリセットライブラリ
+class MappedLibrary {
+public:
+    bool open(const std::filesystem::path& path)
+    {
+        if (!m_file.open(path)) return false;
+        if (m_view.open(m_file.bytes())) return true;
+        m_file.close();
+        return false;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+    [[nodiscard]] const View& view() const noexcept { return m_view; }
+
+private:
+    MappedFile m_file;
+    View m_view;
+};
+
+/// @brief プリセットファイルをバイナリ形式に変換する
+/// @param journal_seq ヘッダに記録するジャーナルの通し番号
+std::vector<std::byte> serialize(const preset_file::GradientPresetFile& file, const SourceStamp& source, uint64_t journal_seq);
+
+/// @brief バイナリ形式からプリセットファイルに変換する
+preset_file::GradientPresetFile deserialize(const View& view);
+
+/// @brief バイナリ形式で書き出す。一時ファイルに書き出してから置き換える
+bool writeFile(const std::filesystem::path& path, const preset_file::GradientPresetFile& file, const SourceStamp& source, uint64_t journal_seq);
+
+/// @brief バイナリ形式のファイルを読み込む
+/// @param expected_source 指定した場合、元の JSON ファイルの状態が一致しないときは読み込まない
+std::optional<preset_file::GradientPresetFile> readFile(const std::filesystem::path& path, const std::optional<SourceStamp>& expected_source = std::nullopt);
+
+}  // namespace preset_binary
+
+#endif  // !PRESET_BINARY_H
@@ -1,12 +1,11 @@
 #include "preset_controller.h"
 
 #include <cstdint>
-#include <format>
 #include <iterator>
+#include <utility>
 #include <vector>
 
 #include "utils/common/color_conv.h"
-#include "utils/common/str_conv.h"
 
 namespace gradient_editor {
 
@@ -14,9 +13,10 @@ gradient_editor::GradientData PresetController::preset2gradient(const preset::Gr
 {
     gradient_editor::GradientData gradient{};
     std::vector<GradientMarkerData> markers_data;
+    markers_data.reserve(preset.colors.size());
     for (uint32_t i = 0; i < static_cast<uint32_t>(std::ssize(preset.colors)); ++i) {
         GradientMarkerData marker_data;
-        marker_data.color = color_conv::u32Rgba2Vec4Rgba<ImVec4>(str_conv::charsToInt(preset.colors[i].substr(2, 8), 0xffffffff, 16));
+        marker_data.color = color_conv::u32Rgba2Vec4Rgba<ImVec4>(preset.colors[i]);
         marker_data.pos   = preset.positions[i];
         if (static_cast<int32_t>(i) < static_cast<int32_t>(std::ssize(preset.colors)) - 1) {
             marker_data.midpoint.ratio = preset.midpoints[i];
@@ -34,12 +34,11 @@ gradient_editor::GradientData PresetController::preset2gradient(const preset::Gr
 preset::GradientPreset PresetController::gradient2preset(gradient_editor::GradientData& gradient)
 {
     preset::GradientPreset preset;
-    std::vector<std::string> rgba_hex_strs(static_cast<uint32_t>(std::ssize(gradient.m_marker_manager.getMarkerColors())));
-    for (const auto& [i, marker_color] : gradient.m_marker_manager.getMarkerColors() | std::views::enumerate) {
-        uint32_t rgba    = color_conv::vec4Rgba2u32Rgba<ImVec4>(marker_color);
-        rgba_hex_strs[i] = std::format("0x{:08X}", rgba);
+    const auto marker_colors = gradient.m_marker_manager.getMarkerColors();
+    preset.colors.resize(marker_colors.size());
+    for (size_t i = 0; i < marker_colors.size(); ++i) {
+        preset.colors[i] = color_conv::vec4Rgba2u32Rgba<ImVec4>(marker_colors[i]);
     }
-    preset.colors             = rgba_hex_strs;
     preset.positions          = gradient.m_marker_manager.getMarkerPos();
     preset.midpoints          = gradient.m_marker_manager.getMidpointRatios();
     preset.blur_width         = gradient.getBlurWidth();
@@ -52,84 +51,83 @@ preset::GradientPreset PresetController::gradient2preset(gradient_editor::Gradie
 bool PresetController::deletePreset(PresetManager& manager, preset_file::GradientPresetFile& file, const uint32_t index)
 {
     // 削除
-    file.presets.erase(file.presets.begin() + index);
-
-    // 書き込み
-    auto write_result = manager.writePresetFile(file);
-    if (!write_result.is_success) {
-        return false;
-    }
-    return true;
+    auto write_result = manager.commitOperation(file, {.type = preset_journal::OperationType::Delete, .index_1 = index});
+    return write_result.is_success;
 }
 
 bool PresetController::swapPreset(PresetManager& manager, preset_file::GradientPresetFile& file, const uint32_t index_1, const uint32_t index_2)
 {
     // スワップ
-    auto tmp              = file.presets[index_1];
-    file.presets[index_1] = file.presets[index_2];
-    file.presets[index_2] = tmp;
-
-    // 書き込み
-    auto write_result = manager.writePresetFile(file);
-    if (!write_result.is_success) {
-        return false;
-    }
-    return true;
+    auto write_result = manager.commitOperation(file, {.type = preset_journal::OperationType::Swap, .index_1 = index_1, .index_2 = index_2});
+    return write_result.is_success;
 }
 
 bool PresetController::overwritePreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset::GradientPreset preset, const std::string& new_name, const uint32_t index)
 {
-    preset.name         = new_name;
-    file.presets[index] = preset;  // 上書き
-
-    // 書き込み
-    auto write_result = manager.writePresetFile(file);
-    if (!write_result.is_success) {
-        return false;
-    }
+    preset      = preset_hash::canonicalize(std::move(preset));
+    preset.name = new_name;
 
-    // 再読み込み
-    auto result = manager.loadPresetFile();
-    file        = result.preset_file;
-    if (!result.error.empty()) {
-        return false;
-    }
-    return true;
+    // 上書き
+    auto write_result = manager.commitOperation(file, {.type = preset_journal::OperationType::Overwrite, .index_1 = index, .preset = std::move(preset)});
+    return write_result.is_success;
 }
 
-bool PresetController::addPreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset::GradientPreset preset, const std::string& new_name)
+PresetController::AddPresetResult PresetController::addPreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset_hash::PresetDedupIndex& index, preset::GradientPreset preset, const std::string& new_name)
 {
-    // 追加する前に名前の重複を避ける
-    auto has_duplicate_name = [&file](std::string& target_name) {
-        for (const auto& p : file.presets) {
-            if (p.name == target_name) {
-                return true;
-            }
-        }
-        return false;
-    };
-
-    std::string original_name  = new_name;
-    std::string candidate_name = original_name;
-    // 重複がある限りループし続ける
-    while (has_duplicate_name(candidate_name)) {
-        candidate_name += "_copy";
+    AddPresetResult result;
+    index.sync(file);
+
+    // 内容が同じプリセットは追加しない
+    preset = preset_hash::canonicalize(std::move(preset));
+    if (auto duplicate = index.findDuplicate(preset)) {
+        result.duplicate_index = duplicate;
+        return result;
     }
-    preset.name = candidate_name;  // 新しい名前をセット
 
-    file.presets.push_back(preset);  // 追加
+    // 追加する前に名前の重複を避ける
+    preset.name = index.uniqueName(new_name);
 
-    // 書き込み
-    auto res = manager.writePresetFile(file);
+    // 追加
+    auto write_result = manager.commitOperation(file, {.type = preset_journal::OperationType::Add, .preset = std::move(preset)});
+    if (write_result.is_success) index.add(file);
+    result.is_success = write_result.is_success;
+    return result;
+}
 
-    // 再読み込み
-    auto result = manager.loadPresetFile();
-    file        = result.preset_file;
-    if (!result.error.empty()) {
-        return false;
+PresetController::ImportPresetsResult PresetController::importPresets(PresetManager& manager, preset_file::GradientPresetFile& file, preset_hash::PresetDedupIndex& index, std::vector<preset::GradientPreset> presets)
+{
+    ImportPresetsResult result;
+    index.sync(file);
+
+    // 書き出しに失敗した場合に戻すため、追加前の数を覚えておく。追加は末尾にのみ行う
+    const size_t original_count = file.presets.size();
+    for (auto& preset : presets) {
+        preset = preset_hash::canonicalize(std::move(preset));
+        if (index.findDuplicate(preset)) {
+            ++result.duplicate_count;
+            continue;
+        }
+        preset.name = index.uniqueName(preset.name);
+        preset_journal::applyOperation(file, {.type = preset_journal::OperationType::Add, .preset = std::move(preset)});
+        index.add(file);
+        ++result.added_count;
+    }
+    if (result.added_count == 0) {
+        result.is_success = true;
+        return result;
     }
 
-    return true;
+    auto write_result = manager.writePresetFile(file);
+    if (!write_result.is_success) {
+        // メモリ上だけに追加が残ると、以降のジャーナルのインデックスがファイルとずれるため取り消す。
+        // revision を進めるため、インデックスは次の sync() で作り直される
+        file.presets.resize(original_count);
+        ++file.revision;
+        result.added_count = 0;
+    }
+    result.is_success = write_result.is_success;
+    result.error      = std::move(write_result.error);
+    return result;
 }
 
 }  // namespace gradient_editor
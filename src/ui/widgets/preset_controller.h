@@ -1,8 +1,14 @@
 #ifndef PRESET_CONTROLLER_H
 #define PRESET_CONTROLLER_H
 
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
 #include "gradient_data.h"
 #include "gradient_preset.h"
+#include "preset_hash.h"
 
 namespace gradient_editor {
 
@@ -18,7 +24,23 @@ public:
 
     static bool overwritePreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset::GradientPreset preset, const std::string& new_name, const uint32_t index);
 
-    static bool addPreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset::GradientPreset preset, const std::string& new_name);
+    struct AddPresetResult {
+        bool is_success = false;
+        std::optional<uint32_t> duplicate_index;  // 内容が同じプリセットがあったため追加しなかった場合、そのインデックス
+    };
+    /// @brief 正規化したプリセットを追加する。内容が同じプリセットがある場合は追加しない
+    /// @note 名前が重複する場合は "_copy" などを付ける
+    static AddPresetResult addPreset(PresetManager& manager, preset_file::GradientPresetFile& file, preset_hash::PresetDedupIndex& index, preset::GradientPreset preset, const std::string& new_name);
+
+    struct ImportPresetsResult {
+        bool is_success          = false;
+        uint32_t added_count     = 0;
+        uint32_t duplicate_count = 0;  // 既存のプリセットや、同時に読み込んだプリセットと内容が同じため追加しなかった数
+        std::string error;
+    };
+    /// @brief 読み込んだプリセットをまとめて追加する。重複の扱いは addPreset() と同じ
+    /// @note ジャーナルには記録せず、最後にファイル全体を 1 回だけ書き出す。書き出しに失敗した場合は file を元に戻す
+    static ImportPresetsResult importPresets(PresetManager& manager, preset_file::GradientPresetFile& file, preset_hash::PresetDedupIndex& index, std::vector<preset::GradientPreset> presets);
 };
 
 }  // namespace gradient_editor
@@ -0,0 +1,65 @@
+#include "preset_eval.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "utils/common/color_conv.h"
+
+namespace preset_eval {
+
+Oklab rgba2Oklab(const uint32_t rgba)
+{
+    const float inv_255 = 1.0f / 255.0f;
+    Oklab linear{
+        color_conv::srgb2Linear(static_cast<float>((rgba >> 24) & 0xFF) * inv_255),
+        color_conv::srgb2Linear(static_cast<float>((rgba >> 16) & 0xFF) * inv_255),
+        color_conv::srgb2Linear(static_cast<float>((rgba >> 8) & 0xFF) * inv_255),
+    };
+    return color_conv::linear2Oklab(linear);
+}
+
+float smoothStep(const float lower, const float upper, const float x) noexcept
+{
+    if (upper <= lower) return x < lower ? 0.0f : 1.0f;
+    float t = std::clamp((x - lower) / (upper - lower), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+void sampleOklab(const preset::GradientPreset& preset, const std::span<Oklab> out)
+{
+    if (preset.colors.empty() || out.empty()) return;
+
+    std::vector<Oklab> labs;
+    labs.reserve(preset.colors.size());
+    for (const uint32_t rgba : preset.colors) labs.push_back(rgba2Oklab(rgba));
+
+    const size_t stop_count = std::min(labs.size(), preset.positions.size());
+    const float half_width  = preset.blur_width * 0.5f;
+    const size_t last       = out.size() - 1;
+
+    for (size_t j = 0; j < out.size(); ++j) {
+        const float t = last > 0 ? static_cast<float>(j) / static_cast<float>(last) : 0.0f;
+
+        Oklab lab = labs.front();
+        if (stop_count >= 2 && t >= preset.positions[stop_count - 1]) {
+            lab = labs[stop_count - 1];
+        } else if (stop_count >= 2 && t > preset.positions[0]) {
+            size_t k = 0;
+            while (k + 2 < stop_count && t >= preset.positions[k + 1]) ++k;
+
+            const float dist = preset.positions[k + 1] - preset.positions[k];
+            const float u    = dist > 0.0f ? (t - preset.positions[k]) / dist : 1.0f;
+            const float mid  = k < preset.midpoints.size() ? preset.midpoints[k] : 0.5f;
+            const float w    = smoothStep(mid - half_width, mid + half_width, u);
+
+            lab = {
+                labs[k].x + (labs[k + 1].x - labs[k].x) * w,
+                labs[k].y + (labs[k + 1].y - labs[k].y) * w,
+                labs[k].z + (labs[k + 1].z - labs[k].z) * w,
+            };
+        }
+        out[j] = lab;
+    }
+}
+
+}  // namespace preset_eval
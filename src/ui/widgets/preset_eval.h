@@ -0,0 +1,29 @@
+#ifndef PRESET_EVAL_H
+#define PRESET_EVAL_H
+
+#include <cstdint>
+#include <span>
+
+#include "gradient_preset.h"
+
+/// @brief プリセットのグラデーションを CPU で評価する関数
+/// @note 補間は Oklab のみ。描画はシェーダーで行うため、検索や比較に使う
+namespace preset_eval {
+
+struct Oklab {
+    float x, y, z;  // L, a, b
+};
+
+/// @brief RGBA の色を Oklab に変換する。不透明度は無視する
+Oklab rgba2Oklab(uint32_t rgba);
+
+/// @brief シェーダーの smoothstep と同じ。幅が 0 の場合は中間点で切り替える
+float smoothStep(float lower, float upper, float x) noexcept;
+
+/// @brief [0, 1] を等間隔に out.size() 点標本化した Oklab の色を求める。中間点とぼかし幅はシェーダーと同じ方法で反映する
+/// @note 色がない場合は何も書き込まない
+void sampleOklab(const preset::GradientPreset& preset, std::span<Oklab> out);
+
+}  // namespace preset_eval
+
+#endif  // !PRESET_EVAL_H
@@ -0,0 +1,150 @@
+#include "preset_hash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace preset_hash {
+
+namespace {
+float quantize(const float value) noexcept
+{
+    return std::round(value * QUANTIZATION_STEPS) / QUANTIZATION_STEPS;
+}
+
+int32_t quantizedInt(const float value) noexcept
+{
+    return static_cast<int32_t>(std::lround(value * QUANTIZATION_STEPS));
+}
+
+// FNV-1a
+class Hasher {
+public:
+    void add(const uint64_t value) noexcept
+    {
+        for (int32_t i = 0; i < 8; ++i) {
+            m_hash ^= (value >> (i * 8)) & 0xff;
+            m_hash *= 0x100000001b3ull;
+        }
+    }
+
+    [[nodiscard]] uint64_t value() const noexcept { return m_hash; }
+
+private:
+    uint64_t m_hash = 0xcbf29ce484222325ull;
+};
+}  // namespace
+
+preset::GradientPreset canonicalize(preset::GradientPreset preset)
+{
+    const size_t count = std::min(preset.colors.size(), preset.positions.size());
+    preset.colors.resize(count);
+    preset.positions.resize(count);
+    preset.midpoints.resize(count > 0 ? count - 1 : 0, 0.5f);
+
+    // 中間点は直前のマーカーに属するものとして一緒に並べ替える
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&preset](const uint32_t a, const uint32_t b) {
+        return preset.positions[a] < preset.positions[b];
+    });
+
+    if (!std::is_sorted(order.begin(), order.end())) {
+        preset::GradientPreset sorted = preset;
+        for (size_t i = 0; i < count; ++i) {
+            sorted.colors[i]    = preset.colors[order[i]];
+            sorted.positions[i] = preset.positions[order[i]];
+            if (i + 1 < count) sorted.midpoints[i] = order[i] + 1 < count ? preset.midpoints[order[i]] : 0.5f;
+        }
+        preset = std::move(sorted);
+    }
+
+    for (float& position : preset.positions) position = quantize(std::clamp(position, 0.0f, 1.0f));
+    for (float& midpoint : preset.midpoints) midpoint = quantize(std::clamp(midpoint, 0.0f, 1.0f));
+    preset.blur_width = quantize(std::max(preset.blur_width, 0.0f));
+    return preset;
+}
+
+uint64_t contentHash(const preset::GradientPreset& canonical) noexcept
+{
+    Hasher hasher;
+    hasher.add(canonical.colors.size());
+    for (const uint32_t color : canonical.colors) hasher.add(color);
+    for (const float position : canonical.positions) hasher.add(static_cast<uint32_t>(quantizedInt(position)));
+    for (const float midpoint : canonical.midpoints) hasher.add(static_cast<uint32_t>(quantizedInt(midpoint)));
+    hasher.add(static_cast<uint32_t>(quantizedInt(canonical.blur_width)));
+    hasher.add(static_cast<uint32_t>(canonical.color_space));
+    hasher.add(static_cast<uint32_t>(canonical.interpolation_path));
+    return hasher.value();
+}
+
+bool isSameContent(const preset::GradientPreset& a, const preset::GradientPreset& b) noexcept
+{
+    return a.colors == b.colors &&
+           a.positions == b.positions &&
+           a.midpoints == b.midpoints &&
+           a.blur_width == b.blur_width &&
+           a.color_space == b.color_space &&
+           a.interpolation_path == b.interpolation_path;
+}
+
+void PresetDedupIndex::sync(const preset_file::GradientPresetFile& file)
+{
+    if (m_file == &file && m_revision == file.revision) return;
+
+    m_file     = &file;
+    m_revision = file.revision;
+    m_hash_to_index.clear();
+    m_names.clear();
+    m_copy_counters.clear();
+
+    m_hash_to_index.reserve(file.presets.size());
+    m_names.reserve(file.presets.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(file.presets.size()); ++i) insert(file.presets[i], i);
+}
+
+std::optional<uint32_t> PresetDedupIndex::findDuplicate(const preset::GradientPreset& canonical) const
+{
+    if (!m_file) return std::nullopt;
+
+    // ハッシュが衝突している可能性があるため内容も比較する
+    auto [first, last] = m_hash_to_index.equal_range(contentHash(canonical));
+    for (auto it = first; it != last; ++it) {
+        if (isSameContent(canonicalize(m_file->presets[it->second]), canonical)) return it->second;
+    }
+    return std::nullopt;
+}
+
+std::string PresetDedupIndex::uniqueName(const std::string& name)
+{
+    if (!m_names.contains(name)) return name;
+
+    uint32_t& counter = m_copy_counters[name];
+    while (true) {
+        // 1 つ目は従来どおり "_copy" のみを付ける
+        std::string candidate = name + "_copy";
+        if (counter > 0) candidate += std::to_string(counter + 1);
+        ++counter;
+        if (!m_names.contains(candidate)) return candidate;
+    }
+}
+
+void PresetDedupIndex::add(const preset_file::GradientPresetFile& file)
+{
+    // 前回の同期以降に他の変更があった場合は、次の sync() で作り直す
+    if (m_file != &file || m_revision + 1 != file.revision || file.presets.empty()) {
+        m_file = nullptr;
+        return;
+    }
+    insert(file.presets.back(), static_cast<uint32_t>(file.presets.size() - 1));
+    m_revision = file.revision;
+}
+
+void PresetDedupIndex::insert(const preset::GradientPreset& preset, const uint32_t index)
+{
+    m_hash_to_index.emplace(contentHash(canonicalize(preset)), index);
+    m_names.insert(preset.name);
+}
+
+}  // namespace preset_hash
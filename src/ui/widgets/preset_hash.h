@@ -0,0 +1,64 @@
+#ifndef PRESET_HASH_H
+#define PRESET_HASH_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gradient_preset.h"
+
+/// @brief プリセットの正規化と内容のハッシュ
+/// @note 名前はハッシュに含めない。見た目が同じグラデーションは名前が異なっても重複とみなす
+namespace preset_hash {
+
+// 位置・中間点・ぼかし幅を丸める細かさ。1 / QUANTIZATION_STEPS 単位に揃える
+inline constexpr float QUANTIZATION_STEPS = 10000.0f;
+
+/// @brief プリセットを正規化する
+/// @note マーカーを位置の順に並べ、位置と中間点を [0, 1] に収めて丸める。
+///       中間点の数はマーカーの数 - 1 に揃え、足りない場合は 0.5 で補う
+preset::GradientPreset canonicalize(preset::GradientPreset preset);
+
+/// @brief 正規化したプリセットの内容から 64 ビットのハッシュを求める
+uint64_t contentHash(const preset::GradientPreset& canonical) noexcept;
+
+/// @brief 正規化したプリセット同士の内容が等しいか。名前は比較しない
+bool isSameContent(const preset::GradientPreset& a, const preset::GradientPreset& b) noexcept;
+
+/// @brief 内容の重複と名前の衝突を定数時間で調べるためのインデックス
+/// @note プリセットファイルの revision が変わったら sync() で作り直す。
+///       自身で追加した場合は add() で更新するため作り直さない
+class PresetDedupIndex {
+public:
+    /// @brief プリセットファイルに合わせてインデックスを作り直す。変更がなければ何もしない
+    void sync(const preset_file::GradientPresetFile& file);
+
+    /// @brief 内容が同じプリセットを探す
+    /// @param canonical canonicalize() 済みのプリセット
+    [[nodiscard]] std::optional<uint32_t> findDuplicate(const preset::GradientPreset& canonical) const;
+
+    /// @brief 既存のプリセットと重複しない名前を求める
+    /// @note 重複する場合は "_copy", "_copy2", "_copy3", ... を付ける。試した番号は記録するため、同じ名前で繰り返し呼んでも毎回数え直さない
+    [[nodiscard]] std::string uniqueName(const std::string& name);
+
+    /// @brief file の末尾に追加したプリセットを登録する
+    void add(const preset_file::GradientPresetFile& file);
+
+private:
+    const preset_file::GradientPresetFile* m_file = nullptr;
+    uint64_t m_revision                           = 0;
+
+    std::unordered_multimap<uint64_t, uint32_t> m_hash_to_index;
+    std::unordered_set<std::string> m_names;
+    std::unordered_map<std::string, uint32_t> m_copy_counters;  // 元の名前ごとに次に試す番号
+
+    void insert(const preset::GradientPreset& preset, uint32_t index);
+};
+
+}  // namespace preset_hash
+
+#endif  // !PRESET_HASH_H
@@ -0,0 +1,833 @@
+#include "preset_import.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "preset_import_detail.h"
+
+namespace preset_import {
+
+using detail::ParseError;
+using detail::Stop;
+
+namespace {
+std::string toLower(std::string_view str)
+{
+    std::string lower(str);
+    for (char& c : lower) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return lower;
+}
+
+std::string_view trim(std::string_view str)
+{
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.front()))) str.remove_prefix(1);
+    while (!str.empty() && std::isspace(static_cast<unsigned char>(str.back()))) str.remove_suffix(1);
+    return str;
+}
+
+std::optional<float> parseNumber(std::string_view str)
+{
+    str = trim(str);
+    if (!str.empty() && str.front() == '+') str.remove_prefix(1);
+    float value    = 0.0f;
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+    if (ec != std::errc() || ptr != str.data() + str.size() || !std::isfinite(value)) return std::nullopt;
+    return value;
+}
+
+// 空白で区切る。括弧の中の空白では区切らない
+std::vector<std::string_view> splitWhitespace(std::string_view str)
+{
+    std::vector<std::string_view> tokens;
+    int32_t depth = 0;
+    size_t start  = std::string_view::npos;
+    for (size_t i = 0; i <= str.size(); ++i) {
+        const char c        = i < str.size() ? str[i] : ' ';
+        const bool is_space = std::isspace(static_cast<unsigned char>(c)) && depth == 0;
+        if (c == '(') ++depth;
+        if (c == ')') depth = std::max(depth - 1, 0);
+        if (is_space) {
+            if (start != std::string_view::npos) tokens.push_back(str.substr(start, i - start));
+            start = std::string_view::npos;
+        } else if (start == std::string_view::npos) {
+            start = i;
+        }
+    }
+    return tokens;
+}
+
+// 括弧の外にある delimiter で区切る
+std::vector<std::string_view> splitTopLevel(std::string_view str, const char delimiter)
+{
+    std::vector<std::string_view> parts;
+    int32_t depth = 0;
+    size_t start  = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (str[i] == '(') ++depth;
+        if (str[i] == ')') depth = std::max(depth - 1, 0);
+        if (str[i] == delimiter && depth == 0) {
+            parts.push_back(trim(str.substr(start, i - start)));
+            start = i + 1;
+        }
+    }
+    parts.push_back(trim(str.substr(start)));
+    return parts;
+}
+
+uint32_t floatRgba2u32(const float r, const float g, const float b, const float a)
+{
+    auto to_byte = [](const float v) { return static_cast<uint32_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f)); };
+    return (to_byte(r) << 24) | (to_byte(g) << 16) | (to_byte(b) << 8) | to_byte(a);
+}
+
+float componentOf(const uint32_t rgba, const int32_t shift)
+{
+    return static_cast<float>((rgba >> shift) & 0xFF);
+}
+
+uint32_t lerpRgba(const uint32_t a, const uint32_t b, const float t)
+{
+    uint32_t out = 0;
+    for (int32_t shift = 0; shift < 32; shift += 8) {
+        const float v = componentOf(a, shift) + (componentOf(b, shift) - componentOf(a, shift)) * t;
+        out |= static_cast<uint32_t>(std::lround(std::clamp(v, 0.0f, 255.0f))) << shift;
+    }
+    return out;
+}
+
+float rgbaDistanceSquared(const uint32_t a, const uint32_t b)
+{
+    float sum = 0.0f;
+    for (int32_t shift = 0; shift < 32; shift += 8) {
+        const float diff = componentOf(a, shift) - componentOf(b, shift);
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// 各成分が 0 - 1 の HSV を RGBA に変換する
+uint32_t hsv2u32Rgba(float h, const float s, const float v, const float a)
+{
+    h             = std::fmod(std::fmod(h, 1.0f) + 1.0f, 1.0f) * 6.0f;
+    const int i   = static_cast<int>(h) % 6;
+    const float f = h - std::floor(h);
+    const float p = v * (1.0f - s);
+    const float q = v * (1.0f - s * f);
+    const float t = v * (1.0f - s * (1.0f - f));
+    switch (i) {
+        case 0: return floatRgba2u32(v, t, p, a);
+        case 1: return floatRgba2u32(q, v, p, a);
+        case 2: return floatRgba2u32(p, v, t, a);
+        case 3: return floatRgba2u32(p, q, v, a);
+        case 4: return floatRgba2u32(t, p, v, a);
+        default: return floatRgba2u32(v, p, q, a);
+    }
+}
+
+uint32_t hsl2u32Rgba(const float h, const float s, const float l, const float a)
+{
+    const float v  = l + s * std::min(l, 1.0f - l);
+    const float sv = v > 0.0f ? 2.0f * (1.0f - l / v) : 0.0f;
+    return hsv2u32Rgba(h, sv, v, a);
+}
+
+std::string stemOf(const std::filesystem::path& path)
+{
+    auto stem = path.stem().u8string();
+    return std::string(stem.begin(), stem.end());
+}
+
+// 小文字にした拡張子
+std::string extensionOf(const std::filesystem::path& path)
+{
+    auto ext = path.extension().u8string();
+    return toLower(std::string(ext.begin(), ext.end()));
+}
+
+// 同じ形式から複数のグラデーションを読み込んだ場合は番号を付ける
+std::string numberedName(const std::string& name, const size_t index, const size_t count)
+{
+    return count > 1 ? name + "_" + std::to_string(index + 1) : name;
+}
+}  // namespace
+
+namespace detail {
+preset::GradientPreset makePreset(std::string name, std::vector<Stop> stops)
+{
+    if (stops.empty()) throw ParseError("no color stops");
+    if (stops.size() == 1) stops.push_back({1.0f, stops.front().rgba, 0.5f});
+
+    std::stable_sort(stops.begin(), stops.end(), [](const Stop& a, const Stop& b) { return a.position < b.position; });
+
+    preset::GradientPreset preset;
+    preset.name = std::move(name);
+    preset.colors.clear();
+    preset.positions.clear();
+    preset.midpoints.clear();
+    for (size_t i = 0; i < stops.size(); ++i) {
+        preset.colors.push_back(stops[i].rgba);
+        preset.positions.push_back(std::clamp(stops[i].position, 0.0f, 1.0f));
+        if (i + 1 < stops.size()) preset.midpoints.push_back(std::clamp(stops[i].midpoint, 0.0f, 1.0f));
+    }
+    return preset;
+}
+}  // namespace detail
+
+bool isSupportedFile(const std::filesystem::path& path)
+{
+    const std::string ext = extensionOf(path);
+    return ext == ".ggr" || ext == ".grd" || ext == ".css" || ext == ".cpt" || ext == ".svg";
+}
+
+void resampleStops(preset::GradientPreset& preset, uint32_t max_stops)
+{
+    max_stops          = std::max(max_stops, 2u);
+    const size_t count = preset.colors.size();
+    if (count <= max_stops) return;
+
+    // 取り除いたマーカーは prev / next の連結から外す。両端のマーカーは取り除かない
+    std::vector<size_t> prev(count), next(count);
+    for (size_t i = 0; i < count; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+    std::vector<bool> removed(count, false);
+    std::vector<uint32_t> versions(count, 0);
+
+    // 取り除いたときに、その位置の色が両隣の補間からどれだけずれるかを誤差とする
+    auto removal_error = [&](const size_t k) {
+        const float p0   = preset.positions[prev[k]];
+        const float p1   = preset.positions[next[k]];
+        const float t    = p1 > p0 ? (preset.positions[k] - p0) / (p1 - p0) : 0.0f;
+        const float diff = rgbaDistanceSquared(lerpRgba(preset.colors[prev[k]], preset.colors[next[k]], t), preset.colors[k]);
+        // 同じ位置の色の切り替えを優先して残す
+        return p1 > p0 ? diff : diff + 1.0e6f;
+    };
+
+    // 誤差の小さい順に取り出す。両隣が変わったマーカーは versions を進め、古い候補は読み捨てる
+    struct Candidate {
+        float error;
+        size_t index;
+        uint32_t version;
+
+        bool operator>(const Candidate& other) const { return error != other.error ? error > other.error : index > other.index; }
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue;
+    for (size_t k = 1; k + 1 < count; ++k) queue.push({removal_error(k), k, 0});
+
+    for (size_t remaining = count; remaining > max_stops;) {
+        const Candidate candidate = queue.top();
+        queue.pop();
+        const size_t k = candidate.index;
+        if (removed[k] || candidate.version != versions[k]) continue;
+
+        removed[k]    = true;
+        next[prev[k]] = next[k];
+        prev[next[k]] = prev[k];
+        --remaining;
+        for (const size_t neighbor : {prev[k], next[k]}) {
+            if (neighbor == 0 || neighbor + 1 == count) continue;
+            queue.push({removal_error(neighbor), neighbor, ++versions[neighbor]});
+        }
+    }
+
+    preset::GradientPreset resampled = preset;
+    resampled.colors.clear();
+    resampled.positions.clear();
+    resampled.midpoints.clear();
+    for (size_t i = 0; i < count; i = next[i]) {
+        resampled.colors.push_back(preset.colors[i]);
+        resampled.positions.push_back(preset.positions[i]);
+        if (next[i] >= count) break;
+        // 結合した区間の中間点は中央にする
+        resampled.midpoints.push_back(next[i] == i + 1 ? preset.midpoints[i] : 0.5f);
+    }
+    preset = std::move(resampled);
+}
+
+//
+// GIMP (.ggr)
+//
+std::vector<preset::GradientPreset> parseGgr(std::istream& in, const std::string& name)
+{
+    std::string line;
+    if (!std::getline(in, line) || !trim(line).starts_with("GIMP Gradient")) throw ParseError("not a GIMP gradient");
+
+    std::string gradient_name = name;
+    if (!std::getline(in, line)) throw ParseError("unexpected end of file");
+    if (trim(line).starts_with("Name:")) {
+        gradient_name = std::string(trim(trim(line).substr(5)));
+        if (!std::getline(in, line)) throw ParseError("unexpected end of file");
+    }
+
+    const auto count = parseNumber(line);
+    if (!count || *count < 1.0f) throw ParseError("invalid segment count");
+
+    std::vector<Stop> stops;
+    std::optional<uint32_t> previous_right;
+    for (int32_t i = 0; i < static_cast<int32_t>(*count); ++i) {
+        if (!std::getline(in, line)) throw ParseError("unexpected end of file");
+        auto tokens = splitWhitespace(line);
+        if (tokens.size() < 11) throw ParseError("invalid segment");
+
+        float v[11];
+        for (size_t j = 0; j < 11; ++j) {
+            auto number = parseNumber(tokens[j]);
+            if (!number) throw ParseError("invalid segment");
+            v[j] = *number;
+        }
+        const float left = v[0], middle = v[1], right = v[2];
+        const uint32_t left_color  = floatRgba2u32(v[3], v[4], v[5], v[6]);
+        const uint32_t right_color = floatRgba2u32(v[7], v[8], v[9], v[10]);
+
+        // 前の区間の終わりと色が異なる場合は、同じ位置に 2 つのマーカーを置く
+        if (previous_right && *previous_right != left_color) stops.push_back({left, *previous_right, 0.5f});
+        const float mid = right > left ? (middle - left) / (right - left) : 0.5f;
+        stops.push_back({left, left_color, mid});
+        previous_right = right_color;
+
+        if (i + 1 == static_cast<int32_t>(*count)) stops.push_back({right, right_color, 0.5f});
+    }
+    return {detail::makePreset(gradient_name, std::move(stops))};
+}
+
+//
+// GMT (.cpt)
+//
+std::vector<preset::GradientPreset> parseCpt(std::istream& in, const std::string& name)
+{
+    bool is_hsv = false;
+
+    // 1 つの色を読む。r g b (h s v) の 3 つ、r/g/b、h-s-v、#rrggbb、グレーの 1 つのいずれか
+    auto parse_color = [&is_hsv](std::span<const std::string_view> tokens) -> std::optional<uint32_t> {
+        auto from_components = [&is_hsv](const float a, const float b, const float c) {
+            return is_hsv ? hsv2u32Rgba(a / 360.0f, b, c, 1.0f) : floatRgba2u32(a / 255.0f, b / 255.0f, c / 255.0f, 1.0f);
+        };
+        if (tokens.size() == 3) {
+            auto a = parseNumber(tokens[0]), b = parseNumber(tokens[1]), c = parseNumber(tokens[2]);
+            if (a && b && c) return from_components(*a, *b, *c);
+            return std::nullopt;
+        }
+        if (tokens.size() != 1) return std::nullopt;
+
+        std::string_view token = tokens[0];
+        if (token.starts_with('#')) {
+            uint32_t rgba = 0;
+            return parseCssColor(token, rgba) ? std::optional{rgba} : std::nullopt;
+        }
+        const char separator = token.find('/') != std::string_view::npos ? '/' : (is_hsv && token.find('-', 1) != std::string_view::npos ? '-' : '\0');
+        if (separator != '\0') {
+            auto parts = splitTopLevel(token, separator);
+            if (parts.size() != 3) return std::nullopt;
+            auto a = parseNumber(parts[0]), b = parseNumber(parts[1]), c = parseNumber(parts[2]);
+            if (a && b && c) return from_components(*a, *b, *c);
+            return std::nullopt;
+        }
+        if (auto gray = parseNumber(token)) return floatRgba2u32(*gray / 255.0f, *gray / 255.0f, *gray / 255.0f, 1.0f);
+        return std::nullopt;
+    };
+
+    struct Segment {
+        float z0, z1;
+        uint32_t c0, c1;
+    };
+    std::vector<Segment> segments;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string_view view = trim(line);
+        if (view.empty()) continue;
+        if (view.front() == '#') {
+            const std::string lower = toLower(view);
+            if (lower.find("color_model") != std::string::npos) is_hsv = lower.find("hsv") != std::string::npos;
+            continue;
+        }
+        // 背景色・前景色・NaN の色は使わない
+        if (view.front() == 'B' || view.front() == 'F' || view.front() == 'N') continue;
+
+        // 末尾の注釈 (";" 以降) とラベルを除く
+        if (auto semicolon = view.find(';'); semicolon != std::string_view::npos) view = trim(view.substr(0, semicolon));
+        auto tokens = splitWhitespace(view);
+        while (!tokens.empty() && (tokens.back() == "L" || tokens.back() == "U" || tokens.back() == "B")) tokens.pop_back();
+
+        std::optional<uint32_t> c0, c1;
+        if (tokens.size() == 8) {
+            c0 = parse_color(std::span{tokens}.subspan(1, 3));
+            c1 = parse_color(std::span{tokens}.subspan(5, 3));
+        } else if (tokens.size() == 4) {
+            c0 = parse_color(std::span{tokens}.subspan(1, 1));
+            c1 = parse_color(std::span{tokens}.subspan(3, 1));
+        } else {
+            throw ParseError("invalid color table line");
+        }
+        auto z0 = parseNumber(tokens.front());
+        auto z1 = parseNumber(tokens[tokens.size() / 2]);
+        if (!z0 || !z1 || !c0 || !c1) throw ParseError("invalid color table line");
+        segments.push_back({*z0, *z1, *c0, *c1});
+    }
+    if (segments.empty()) throw ParseError("no color table entries");
+
+    // z の範囲を 0 - 1 に正規化する
+    float z_min = segments.front().z0, z_max = segments.front().z1;
+    for (const auto& s : segments) {
+        z_min = std::min({z_min, s.z0, s.z1});
+        z_max = std::max({z_max, s.z0, s.z1});
+    }
+    const float z_range = z_max > z_min ? z_max - z_min : 1.0f;
+
+    std::vector<Stop> stops;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        const Segment& s = segments[i];
+        const float p0   = (s.z0 - z_min) / z_range;
+        const float p1   = (s.z1 - z_min) / z_range;
+        if (stops.empty() || stops.back().rgba != s.c0 || stops.back().position != p0) stops.push_back({p0, s.c0, 0.5f});
+        stops.push_back({p1, s.c1, 0.5f});
+    }
+    return {detail::makePreset(name, std::move(stops))};
+}
+
+//
+// CSS
+//
+namespace {
+struct NamedColor {
+    std::string_view name;
+    uint32_t rgba;
+};
+constexpr NamedColor NAMED_COLORS[] = {
+    {"transparent", 0x00000000},
+    {"black", 0x000000ff},
+    {"silver", 0xc0c0c0ff},
+    {"gray", 0x808080ff},
+    {"grey", 0x808080ff},
+    {"white", 0xffffffff},
+    {"maroon", 0x800000ff},
+    {"red", 0xff0000ff},
+    {"purple", 0x800080ff},
+    {"fuchsia", 0xff00ffff},
+    {"magenta", 0xff00ffff},
+    {"green", 0x008000ff},
+    {"lime", 0x00ff00ff},
+    {"olive", 0x808000ff},
+    {"yellow", 0xffff00ff},
+    {"navy", 0x000080ff},
+    {"blue", 0x0000ffff},
+    {"teal", 0x008080ff},
+    {"aqua", 0x00ffffff},
+    {"cyan", 0x00ffffff},
+    {"orange", 0xffa500ff},
+    {"pink", 0xffc0cbff},
+    {"brown", 0xa52a2aff},
+    {"gold", 0xffd700ff},
+    {"indigo", 0x4b0082ff},
+    {"violet", 0xee82eeff},
+    {"coral", 0xff7f50ff},
+    {"tomato", 0xff6347ff},
+    {"salmon", 0xfa8072ff},
+    {"crimson", 0xdc143cff},
+    {"orchid", 0xda70d6ff},
+    {"skyblue", 0x87ceebff},
+    {"turquoise", 0x40e0d0ff},
+    {"darkblue", 0x00008bff},
+    {"darkgreen", 0x006400ff},
+    {"darkred", 0x8b0000ff},
+    {"lightgray", 0xd3d3d3ff},
+    {"lightgrey", 0xd3d3d3ff},
+    {"darkgray", 0xa9a9a9ff},
+    {"darkgrey", 0xa9a9a9ff},
+};
+
+// 色の成分。% の場合は scale に対する割合として扱う
+std::optional<float> parseComponent(std::string_view str, const float scale)
+{
+    str = trim(str);
+    if (str.ends_with('%')) {
+        auto value = parseNumber(str.substr(0, str.size() - 1));
+        return value ? std::optional{*value / 100.0f} : std::nullopt;
+    }
+    auto value = parseNumber(str);
+    return value ? std::optional{*value / scale} : std::nullopt;
+}
+
+std::optional<float> parseHue(std::string_view str)
+{
+    str = trim(str);
+    float scale = 360.0f;
+    if (str.ends_with("deg")) str.remove_suffix(3);
+    else if (str.ends_with("grad")) str.remove_suffix(4), scale = 400.0f;
+    else if (str.ends_with("rad")) str.remove_suffix(3), scale = 6.28318531f;
+    else if (str.ends_with("turn")) str.remove_suffix(4), scale = 1.0f;
+    auto value = parseNumber(str);
+    return value ? std::optional{*value / scale} : std::nullopt;
+}
+
+// "a, b, c[, d]" と "a b c[ / d]" のどちらの書き方にも対応する
+std::vector<std::string_view> splitColorArguments(std::string_view args)
+{
+    if (args.find(',') != std::string_view::npos) return splitTopLevel(args, ',');
+    std::vector<std::string_view> parts;
+    auto slash = args.find('/');
+    for (auto token : splitWhitespace(args.substr(0, slash))) parts.push_back(token);
+    if (slash != std::string_view::npos) parts.push_back(trim(args.substr(slash + 1)));
+    return parts;
+}
+
+// 色の位置。% 以外の単位 (px など) は解釈できないため未指定として扱う
+std::optional<float> parseStopPosition(std::string_view str)
+{
+    str = trim(str);
+    if (str.ends_with('%')) {
+        auto value = parseNumber(str.substr(0, str.size() - 1));
+        return value ? std::optional{*value / 100.0f} : std::nullopt;
+    }
+    if (str == "0") return 0.0f;
+    return std::nullopt;
+}
+
+bool isStopPosition(std::string_view str)
+{
+    str = trim(str);
+    return !str.empty() && (std::isdigit(static_cast<unsigned char>(str.front())) || str.front() == '.' || str.front() == '-' || str.front() == '+');
+}
+
+// linear-gradient() の引数を読み込む
+std::vector<Stop> parseLinearGradientArguments(std::string_view args)
+{
+    auto parts = splitTopLevel(args, ',');
+    if (parts.empty()) throw ParseError("empty gradient");
+
+    // 方向の指定は使わない
+    const std::string first = toLower(parts.front());
+    if (first.starts_with("to ") || first.ends_with("deg") || first.ends_with("rad") || first.ends_with("turn") || first.ends_with("grad")) {
+        parts.erase(parts.begin());
+    }
+
+    struct CssStop {
+        uint32_t rgba;
+        std::optional<float> position;
+        std::optional<float> hint;  // 次の色との間の中間点の位置
+    };
+    std::vector<CssStop> css_stops;
+    for (auto part : parts) {
+        auto tokens = splitWhitespace(part);
+        if (tokens.empty()) continue;
+
+        // 位置のみの場合は中間点
+        if (tokens.size() == 1 && isStopPosition(tokens[0])) {
+            if (!css_stops.empty()) css_stops.back().hint = parseStopPosition(tokens[0]);
+            continue;
+        }
+
+        uint32_t rgba = 0;
+        if (!parseCssColor(tokens[0], rgba)) throw ParseError("invalid color: " + std::string(tokens[0]));
+        css_stops.push_back({rgba, tokens.size() > 1 ? parseStopPosition(tokens[1]) : std::nullopt, std::nullopt});
+        if (tokens.size() > 2) css_stops.push_back({rgba, parseStopPosition(tokens[2]), std::nullopt});
+    }
+    if (css_stops.empty()) throw ParseError("no color stops");
+
+    // 位置の補完 (CSS Images の仕様に従う)
+    if (!css_stops.front().position) css_stops.front().position = 0.0f;
+    if (!css_stops.back().position) css_stops.back().position = 1.0f;
+    float max_position = 0.0f;
+    for (auto& s : css_stops) {
+        if (s.position) {
+            s.position   = std::max(*s.position, max_position);
+            max_position = *s.position;
+        }
+    }
+    for (size_t i = 0; i < css_stops.size();) {
+        if (css_stops[i].position) {
+            ++i;
+            continue;
+        }
+        size_t j = i;
+        while (!css_stops[j].position) ++j;
+        const float p0 = *css_stops[i - 1].position;
+        const float p1 = *css_stops[j].position;
+        for (size_t k = i; k < j; ++k) {
+            css_stops[k].position = p0 + (p1 - p0) * static_cast<float>(k - i + 1) / static_cast<float>(j - i + 1);
+        }
+        i = j;
+    }
+
+    std::vector<Stop> stops;
+    for (size_t i = 0; i < css_stops.size(); ++i) {
+        float mid = 0.5f;
+        if (i + 1 < css_stops.size() && css_stops[i].hint) {
+            const float p0 = *css_stops[i].position;
+            const float p1 = *css_stops[i + 1].position;
+            if (p1 > p0) mid = std::clamp((*css_stops[i].hint - p0) / (p1 - p0), 0.0f, 1.0f);
+        }
+        stops.push_back({*css_stops[i].position, css_stops[i].rgba, mid});
+    }
+    return stops;
+}
+}  // namespace
+
+bool parseCssColor(std::string_view str, uint32_t& rgba)
+{
+    str                     = trim(str);
+    const std::string lower = toLower(str);
+
+    if (lower.starts_with('#')) {
+        std::string_view hex = std::string_view{lower}.substr(1);
+        if (hex.size() != 3 && hex.size() != 4 && hex.size() != 6 && hex.size() != 8) return false;
+        uint32_t value = 0;
+        auto [ptr, ec] = std::from_chars(hex.data(), hex.data() + hex.size(), value, 16);
+        if (ec != std::errc() || ptr != hex.data() + hex.size()) return false;
+
+        if (hex.size() <= 4) {
+            // 1 桁を 2 桁に広げる
+            uint32_t expanded = 0;
+            for (size_t i = 0; i < hex.size(); ++i) {
+                const uint32_t digit = (value >> ((hex.size() - 1 - i) * 4)) & 0xF;
+                expanded             = (expanded << 8) | (digit * 0x11);
+            }
+            value = expanded;
+        }
+        rgba = (hex.size() == 3 || hex.size() == 6) ? (value << 8) | 0xFF : value;
+        return true;
+    }
+
+    for (const auto& named : NAMED_COLORS) {
+        if (lower == named.name) {
+            rgba = named.rgba;
+            return true;
+        }
+    }
+
+    const auto open = lower.find('(');
+    if (open == std::string::npos || !lower.ends_with(')')) return false;
+    const std::string_view function = trim(std::string_view{lower}.substr(0, open));
+    auto args                       = splitColorArguments(std::string_view{lower}.substr(open + 1, lower.size() - open - 2));
+    if (args.size() != 3 && args.size() != 4) return false;
+
+    const std::optional<float> alpha = args.size() == 4 ? parseComponent(args[3], 1.0f) : std::optional{1.0f};
+    if (!alpha) return false;
+
+    if (function == "rgb" || function == "rgba") {
+        auto r = parseComponent(args[0], 255.0f), g = parseComponent(args[1], 255.0f), b = parseComponent(args[2], 255.0f);
+        if (!r || !g || !b) return false;
+        rgba = floatRgba2u32(*r, *g, *b, *alpha);
+        return true;
+    }
+    if (function == "hsl" || function == "hsla") {
+        auto h = parseHue(args[0]), s = parseComponent(args[1], 100.0f), l = parseComponent(args[2], 100.0f);
+        if (!h || !s || !l) return false;
+        rgba = hsl2u32Rgba(*h, std::clamp(*s, 0.0f, 1.0f), std::clamp(*l, 0.0f, 1.0f), *alpha);
+        return true;
+    }
+    return false;
+}
+
+std::vector<preset::GradientPreset> parseCss(std::istream& in, const std::string& name)
+{
+    static constexpr std::string_view KEYWORD = "linear-gradient(";
+
+    // キーワードが現れるまで読み飛ばし、対応する閉じ括弧までを 1 つのグラデーションとして読む
+    std::vector<std::vector<Stop>> gradients;
+    size_t matched = 0;
+    std::string args;
+    for (std::istreambuf_iterator<char> it{in}, end; it != end; ++it) {
+        const char c = static_cast<char>(std::tolower(static_cast<unsigned char>(*it)));
+        matched      = c == KEYWORD[matched] ? matched + 1 : (c == KEYWORD[0] ? 1 : 0);
+        if (matched < KEYWORD.size()) continue;
+        matched = 0;
+
+        args.clear();
+        int32_t depth = 1;
+        for (++it; it != end; ++it) {
+            if (*it == '(') ++depth;
+            if (*it == ')' && --depth == 0) break;
+            args.push_back(*it);
+        }
+        if (it == end) throw ParseError("unterminated linear-gradient()");
+        gradients.push_back(parseLinearGradientArguments(args));
+    }
+    if (gradients.empty()) throw ParseError("no linear-gradient() found");
+
+    std::vector<preset::GradientPreset> presets;
+    for (size_t i = 0; i < gradients.size(); ++i) {
+        presets.push_back(detail::makePreset(numberedName(name, i, gradients.size()), std::move(gradients[i])));
+    }
+    return presets;
+}
+
+//
+// SVG
+//
+namespace {
+// タグ内の属性を読む
+std::unordered_map<std::string, std::string> parseAttributes(std::string_view tag)
+{
+    std::unordered_map<std::string, std::string> attributes;
+    size_t i = 0;
+    while (i < tag.size()) {
+        while (i < tag.size() && (std::isspace(static_cast<unsigned char>(tag[i])) || tag[i] == '/')) ++i;
+        const size_t key_start = i;
+        while (i < tag.size() && tag[i] != '=' && !std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+        std::string key(tag.substr(key_start, i - key_start));
+        while (i < tag.size() && std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+        if (i >= tag.size() || tag[i] != '=') continue;
+        ++i;
+        while (i < tag.size() && std::isspace(static_cast<unsigned char>(tag[i]))) ++i;
+        if (i >= tag.size() || (tag[i] != '"' && tag[i] != '\'')) continue;
+        const char quote         = tag[i++];
+        const size_t value_start = i;
+        while (i < tag.size() && tag[i] != quote) ++i;
+        attributes[std::move(key)] = std::string(tag.substr(value_start, i - value_start));
+        ++i;
+    }
+    return attributes;
+}
+
+// style 属性から指定したプロパティの値を取り出す
+std::optional<std::string> styleProperty(const std::string& style, std::string_view property)
+{
+    for (auto declaration : splitTopLevel(style, ';')) {
+        const auto colon = declaration.find(':');
+        if (colon == std::string_view::npos) continue;
+        if (trim(declaration.substr(0, colon)) == property) return std::string(trim(declaration.substr(colon + 1)));
+    }
+    return std::nullopt;
+}
+}  // namespace
+
+std::vector<preset::GradientPreset> parseSvg(std::istream& in, const std::string& name)
+{
+    struct SvgGradient {
+        std::string id;
+        std::vector<Stop> stops;
+    };
+    std::vector<SvgGradient> gradients;
+    bool in_gradient = false;
+
+    std::string tag;
+    for (std::istreambuf_iterator<char> it{in}, end; it != end;) {
+        if (*it++ != '<') continue;
+
+        // タグを 1 つ読む。引用符の中の '>' では終わらない
+        tag.clear();
+        char quote = '\0';
+        for (; it != end; ++it) {
+            const char c = *it;
+            if (quote == '\0' && c == '>') break;
+            if (c == '"' || c == '\'') quote = quote == '\0' ? c : (quote == c ? '\0' : quote);
+            tag.push_back(c);
+            // コメントは "-->" まで読み飛ばす
+            if (tag == "!--") {
+                std::string tail;
+                for (++it; it != end; ++it) {
+                    tail.push_back(*it);
+                    if (tail.size() > 3) tail.erase(tail.begin());
+                    if (tail == "-->") break;
+                }
+                tag.clear();
+                break;
+            }
+        }
+        if (it != end) ++it;
+        if (tag.empty()) continue;
+
+        std::string_view view = tag;
+        const bool is_closing = view.starts_with('/');
+        if (is_closing) view.remove_prefix(1);
+        const size_t name_end       = view.find_first_of(" \t\r\n/");
+        const std::string element   = std::string(view.substr(0, name_end));
+        const std::string_view rest = name_end == std::string_view::npos ? std::string_view{} : view.substr(name_end);
+
+        if (element == "linearGradient") {
+            if (is_closing) {
+                in_gradient = false;
+                continue;
+            }
+            auto attributes = parseAttributes(rest);
+            gradients.push_back({attributes["id"], {}});
+            in_gradient = !view.ends_with('/');
+        } else if (element == "stop" && in_gradient && !is_closing) {
+            auto attributes          = parseAttributes(rest);
+            const std::string& style = attributes["style"];
+
+            std::string color_text   = attributes.contains("stop-color") ? attributes["stop-color"] : "black";
+            std::string opacity_text = attributes.contains("stop-opacity") ? attributes["stop-opacity"] : "1";
+            if (auto color = styleProperty(style, "stop-color")) color_text = *color;
+            if (auto opacity = styleProperty(style, "stop-opacity")) opacity_text = *opacity;
+
+            uint32_t rgba = 0;
+            if (!parseCssColor(color_text, rgba)) throw ParseError("invalid stop-color: " + color_text);
+            const float opacity = parseComponent(opacity_text, 1.0f).value_or(1.0f);
+            rgba                = (rgba & 0xFFFFFF00) | static_cast<uint32_t>(std::lround(std::clamp(opacity, 0.0f, 1.0f) * static_cast<float>(rgba & 0xFF)));
+
+            // オフセットは前のマーカーより小さくしない
+            auto& stops          = gradients.back().stops;
+            const float previous = stops.empty() ? 0.0f : stops.back().position;
+            const float offset   = std::clamp(parseComponent(attributes["offset"], 1.0f).value_or(0.0f), 0.0f, 1.0f);
+            stops.push_back({std::max(offset, previous), rgba, 0.5f});
+        }
+    }
+
+    // 他のグラデーションを参照するだけのもの (マーカーを持たないもの) は重複するため除く
+    std::erase_if(gradients, [](const SvgGradient& g) { return g.stops.empty(); });
+    if (gradients.empty()) throw ParseError("no <linearGradient> with stops found");
+
+    std::vector<preset::GradientPreset> presets;
+    for (size_t i = 0; i < gradients.size(); ++i) {
+        std::string gradient_name = gradients[i].id.empty() ? numberedName(name, i, gradients.size()) : gradients[i].id;
+        presets.push_back(detail::makePreset(std::move(gradient_name), std::move(gradients[i].stops)));
+    }
+    return presets;
+}
+
+//
+// ファイルの読み込み
+//
+ImportResult importFile(const std::filesystem::path& path, const uint32_t max_stops)
+{
+    ImportResult result;
+    result.path = path;
+
+    const std::string ext  = extensionOf(path);
+    const std::string name = stemOf(path);
+
+    std::ifstream ifs(path, std::ios::binary);
+    if (!ifs) {
+        result.error = "failed to open file";
+        return result;
+    }
+
+    try {
+        if (ext == ".ggr") {
+            result.presets = parseGgr(ifs, name);
+        } else if (ext == ".grd") {
+            result.presets = parseGrd(ifs);
+        } else if (ext == ".css") {
+            result.presets = parseCss(ifs, name);
+        } else if (ext == ".cpt") {
+            result.presets = parseCpt(ifs, name);
+        } else if (ext == ".svg") {
+            result.presets = parseSvg(ifs, name);
+        } else {
+            result.error = "unsupported file type";
+            return result;
+        }
+    } catch (const ParseError& e) {
+        result.presets.clear();
+        result.error = e.what();
+        return result;
+    }
+
+    for (auto& preset : result.presets) resampleStops(preset, max_stops);
+    return result;
+}
+
+}  // namespace preset_import
@@ -0,0 +1,47 @@
+#ifndef PRESET_IMPORT_H
+#define PRESET_IMPORT_H
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gradient_preset.h"
+
+/// @brief 他のソフトのグラデーションをプリセットに変換する
+/// @note 対応形式: GIMP (.ggr)、Photoshop (.grd)、CSS の linear-gradient() (.css)、GMT (.cpt)、SVG の <linearGradient> (.svg)。
+///       いずれもストリームから順に読み込み、ファイル全体をメモリに読み込まない
+namespace preset_import {
+
+struct ImportResult {
+    std::filesystem::path path;
+    std::vector<preset::GradientPreset> presets;
+    std::string error;  // 空なら成功
+};
+
+/// @brief 対応している拡張子か
+bool isSupportedFile(const std::filesystem::path& path);
+
+/// @brief 拡張子から形式を判別してファイルを読み込む
+/// @param max_stops マーカーの最大数。超える場合は間引く
+ImportResult importFile(const std::filesystem::path& path, uint32_t max_stops);
+
+// 各形式の読み込み。name はグラデーション名が含まれない形式で使う
+std::vector<preset::GradientPreset> parseGgr(std::istream& in, const std::string& name);
+std::vector<preset::GradientPreset> parseGrd(std::istream& in);
+std::vector<preset::GradientPreset> parseCss(std::istream& in, const std::string& name);
+std::vector<preset::GradientPreset> parseCpt(std::istream& in, const std::string& name);
+std::vector<preset::GradientPreset> parseSvg(std::istream& in, const std::string& name);
+
+/// @brief CSS の色を RGBA に変換する
+/// @return 解釈できた場合は true
+bool parseCssColor(std::string_view str, uint32_t& rgba);
+
+/// @brief マーカーが max_stops を超える場合、見た目の変化が最も小さいマーカーから順に取り除く
+void resampleStops(preset::GradientPreset& preset, uint32_t max_stops);
+
+}  // namespace preset_import
+
+#endif  // !PRESET_IMPORT_H
@@ -0,0 +1,31 @@
+#ifndef PRESET_IMPORT_DETAIL_H
+#define PRESET_IMPORT_DETAIL_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gradient_preset.h"
+
+// 各形式の読み込みで共通して使う。preset_import の実装からのみ使う
+namespace preset_import::detail {
+
+/// @brief 読み込みに失敗したときに投げる。importFile() でエラーメッセージに変換する
+class ParseError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+struct Stop {
+    float position;
+    uint32_t rgba;
+    float midpoint;  // 次のマーカーとの間の中間点
+};
+
+/// @brief マーカーを位置の順に並べてプリセットにする。マーカーが 1 つの場合は同じ色を末尾に補う
+preset::GradientPreset makePreset(std::string name, std::vector<Stop> stops);
+
+}  // namespace preset_import::detail
+
+#endif  // !PRESET_IMPORT_DETAIL_H
@@ -0,0 +1,446 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "preset_import.h"
+#include "preset_import_detail.h"
+
+// Photoshop のグラデーション (.grd, バージョン 5)
+// ファイルは "8BGR"、バージョン (u16)、ディスクリプタのバージョン (u32) に続く 1 つのディスクリプタからなる。
+// 数値はすべてビッグエンディアン
+namespace preset_import {
+
+using detail::ParseError;
+using detail::Stop;
+
+namespace {
+// 壊れたファイルで再帰が深くなりすぎないようにする
+constexpr int32_t MAX_DEPTH = 32;
+// 1 つの文字列やリストの要素数の上限。壊れたファイルで巨大な領域を確保しないようにする
+constexpr uint32_t MAX_COUNT = 1u << 20;
+
+/// @brief ディスクリプタの値。グラデーションの読み込みに必要な種類のみ保持し、それ以外は読み飛ばす
+struct Value {
+    enum class Kind { None, Object, List, Number, Text, Enum };
+
+    Kind kind = Kind::None;
+    std::string id;                                    // Object のクラス、Enum の値
+    double number = 0.0;                               // doub, UntF, long, comp, bool
+    std::string text;                                  // UTF-8
+    std::vector<std::pair<std::string, Value>> items;  // Object の要素
+    std::vector<Value> list;
+
+    [[nodiscard]] const Value* find(std::string_view key) const
+    {
+        for (const auto& [k, v] : items) {
+            if (k == key) return &v;
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] double numberOr(std::string_view key, const double fallback) const
+    {
+        const Value* v = find(key);
+        return v && v->kind == Kind::Number ? v->number : fallback;
+    }
+};
+
+class DescriptorReader {
+public:
+    explicit DescriptorReader(std::istream& in) : m_in{in} {}
+
+    void readBytes(void* out, const size_t size)
+    {
+        if (!m_in.read(static_cast<char*>(out), static_cast<std::streamsize>(size))) throw ParseError("unexpected end of file");
+    }
+
+    void skip(const uint32_t size)
+    {
+        if (!m_in.ignore(static_cast<std::streamsize>(size)) || m_in.gcount() != static_cast<std::streamsize>(size)) {
+            throw ParseError("unexpected end of file");
+        }
+    }
+
+    template <typename T>
+    T readBigEndian()
+    {
+        std::array<unsigned char, sizeof(T)> bytes;
+        readBytes(bytes.data(), bytes.size());
+        uint64_t value = 0;
+        for (unsigned char b : bytes) value = (value << 8) | b;
+        if constexpr (std::is_same_v<T, double>) {
+            return std::bit_cast<double>(value);
+        } else {
+            return static_cast<T>(value);
+        }
+    }
+
+    uint32_t readCount()
+    {
+        const uint32_t count = readBigEndian<uint32_t>();
+        if (count > MAX_COUNT) throw ParseError("invalid length");
+        return count;
+    }
+
+    std::string readOsType()
+    {
+        char type[4];
+        readBytes(type, 4);
+        return std::string(type, 4);
+    }
+
+    // 長さが 0 の場合は 4 文字の ID、それ以外は指定した長さの文字列
+    std::string readKey()
+    {
+        const uint32_t size = readCount();
+        if (size == 0) return readOsType();
+        std::string key(size, '\0');
+        readBytes(key.data(), size);
+        return key;
+    }
+
+    // UTF-16 (ビッグエンディアン) の文字列を UTF-8 にする
+    std::string readUnicode()
+    {
+        const uint32_t count = readCount();
+        std::u16string utf16(count, u'\0');
+        for (auto& c : utf16) c = readBigEndian<char16_t>();
+        while (!utf16.empty() && utf16.back() == u'\0') utf16.pop_back();
+
+        std::string utf8;
+        for (size_t i = 0; i < utf16.size(); ++i) {
+            uint32_t cp = utf16[i];
+            if (cp >= 0xD800 && cp <= 0xDBFF && i + 1 < utf16.size() && utf16[i + 1] >= 0xDC00 && utf16[i + 1] <= 0xDFFF) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (utf16[++i] - 0xDC00);
+            }
+            if (cp < 0x80) {
+                utf8.push_back(static_cast<char>(cp));
+            } else if (cp < 0x800) {
+                utf8.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+                utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else if (cp < 0x10000) {
+                utf8.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+                utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            } else {
+                utf8.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+                utf8.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+                utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+                utf8.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+            }
+        }
+        return utf8;
+    }
+
+    Value readDescriptor(const int32_t depth)
+    {
+        if (depth > MAX_DEPTH) throw ParseError("descriptor is too deep");
+
+        Value value;
+        value.kind = Value::Kind::Object;
+        readUnicode();  // 表示名
+        value.id = readKey();
+
+        const uint32_t count = readCount();
+        for (uint32_t i = 0; i < count; ++i) {
+            std::string key = readKey();
+            value.items.emplace_back(std::move(key), readValue(readOsType(), depth + 1));
+        }
+        return value;
+    }
+
+    Value readValue(const std::string& type, const int32_t depth)
+    {
+        if (depth > MAX_DEPTH) throw ParseError("descriptor is too deep");
+
+        Value value;
+        if (type == "Objc" || type == "GlbO") {
+            return readDescriptor(depth);
+        } else if (type == "VlLs") {
+            value.kind           = Value::Kind::List;
+            const uint32_t count = readCount();
+            for (uint32_t i = 0; i < count; ++i) value.list.push_back(readValue(readOsType(), depth + 1));
+        } else if (type == "doub") {
+            value.kind   = Value::Kind::Number;
+            value.number = readBigEndian<double>();
+        } else if (type == "UntF") {
+            readOsType();  // 単位
+            value.kind   = Value::Kind::Number;
+            value.number = readBigEndian<double>();
+        } else if (type == "long") {
+            value.kind   = Value::Kind::Number;
+            value.number = static_cast<int32_t>(readBigEndian<uint32_t>());
+        } else if (type == "comp") {
+            value.kind   = Value::Kind::Number;
+            value.number = static_cast<double>(static_cast<int64_t>(readBigEndian<uint64_t>()));
+        } else if (type == "bool") {
+            value.kind   = Value::Kind::Number;
+            value.number = readBigEndian<uint8_t>();
+        } else if (type == "TEXT") {
+            value.kind = Value::Kind::Text;
+            value.text = readUnicode();
+        } else if (type == "enum") {
+            readKey();  // 列挙の種類
+            value.kind = Value::Kind::Enum;
+            value.id   = readKey();
+        } else if (type == "type" || type == "GlbC") {
+            readUnicode();
+            readKey();
+        } else if (type == "UnFl") {
+            readOsType();
+            const uint32_t count = readCount();
+            for (uint32_t i = 0; i < count; ++i) readBigEndian<double>();
+        } else if (type == "alis" || type == "tdta" || type == "Pth ") {
+            skip(readCount());
+        } else if (type == "obj ") {
+            skipReference();
+        } else {
+            throw ParseError("unsupported descriptor type: " + type);
+        }
+        return value;
+    }
+
+private:
+    std::istream& m_in;
+
+    void skipReference()
+    {
+        const uint32_t count = readCount();
+        for (uint32_t i = 0; i < count; ++i) {
+            const std::string type = readOsType();
+            if (type == "prop") {
+                readUnicode(), readKey(), readKey();
+            } else if (type == "Clss") {
+                readUnicode(), readKey();
+            } else if (type == "Enmr") {
+                readUnicode(), readKey(), readKey(), readKey();
+            } else if (type == "rele") {
+                readUnicode(), readKey(), readBigEndian<uint32_t>();
+            } else if (type == "Idnt" || type == "indx") {
+                readBigEndian<uint32_t>();
+            } else if (type == "name") {
+                readUnicode(), readKey(), readUnicode();
+            } else {
+                throw ParseError("unsupported reference type: " + type);
+            }
+        }
+    }
+};
+
+uint32_t rgb2u32(const double r, const double g, const double b)
+{
+    auto to_byte = [](const double v) { return static_cast<uint32_t>(std::lround(std::clamp(v, 0.0, 255.0))); };
+    return (to_byte(r) << 24) | (to_byte(g) << 16) | (to_byte(b) << 8) | 0xFF;
+}
+
+// CIE L*a*b* (D50) を sRGB にする
+uint32_t lab2u32(const double l, const double a, const double b)
+{
+    auto f_inv = [](const double t) { return t > 6.0 / 29.0 ? t * t * t : 3.0 * (6.0 / 29.0) * (6.0 / 29.0) * (t - 4.0 / 29.0); };
+    const double fy = (l + 16.0) / 116.0;
+    const double x  = 0.9642 * f_inv(fy + a / 500.0);
+    const double y  = 1.0000 * f_inv(fy);
+    const double z  = 0.8251 * f_inv(fy - b / 200.0);
+
+    // Bradford で D65 に順応させた XYZ から リニア sRGB への変換
+    const double lr = 3.1338561 * x - 1.6168667 * y - 0.4906146 * z;
+    const double lg = -0.9787684 * x + 1.9161415 * y + 0.0334540 * z;
+    const double lb = 0.0719453 * x - 0.2289914 * y + 1.4052427 * z;
+
+    auto encode = [](const double v) {
+        const double c = std::clamp(v, 0.0, 1.0);
+        return 255.0 * (c <= 0.0031308 ? 12.92 * c : 1.055 * std::pow(c, 1.0 / 2.4) - 0.055);
+    };
+    return rgb2u32(encode(lr), encode(lg), encode(lb));
+}
+
+uint32_t colorOf(const Value& stop)
+{
+    // 前景色・背景色はファイルに含まれないため、既定の黒と白にする
+    if (const Value* type = stop.find("Type")) {
+        if (type->id == "FrgC") return 0x000000FF;
+        if (type->id == "BckC") return 0xFFFFFFFF;
+    }
+
+    const Value* color = stop.find("Clr ");
+    if (!color || color->kind != Value::Kind::Object) return 0x000000FF;
+
+    if (color->id == "HSBC") {
+        const double h = color->numberOr("H   ", 0.0) / 360.0;
+        const double s = color->numberOr("Strt", 0.0) / 100.0;
+        const double v = color->numberOr("Brgh", 0.0) / 100.0;
+        // HSV を RGB にする
+        const double h6 = std::fmod(std::fmod(h, 1.0) + 1.0, 1.0) * 6.0;
+        const double f  = h6 - std::floor(h6);
+        const double p  = v * (1.0 - s);
+        const double q  = v * (1.0 - s * f);
+        const double t  = v * (1.0 - s * (1.0 - f));
+
+        double r = v, g = t, b = p;
+        switch (static_cast<int>(h6) % 6) {
+            case 1: r = q, g = v, b = p; break;
+            case 2: r = p, g = v, b = t; break;
+            case 3: r = p, g = q, b = v; break;
+            case 4: r = t, g = p, b = v; break;
+            case 5: r = v, g = p, b = q; break;
+            default: break;
+        }
+        return rgb2u32(r * 255.0, g * 255.0, b * 255.0);
+    }
+    if (color->id == "Grsc") {
+        const double gray = 255.0 * (1.0 - color->numberOr("Gry ", 0.0) / 100.0);
+        return rgb2u32(gray, gray, gray);
+    }
+    if (color->id == "CMYC") {
+        const double k = 1.0 - color->numberOr("Blck", 0.0) / 100.0;
+        return rgb2u32(255.0 * (1.0 - color->numberOr("Cyn ", 0.0) / 100.0) * k,
+                       255.0 * (1.0 - color->numberOr("Mgnt", 0.0) / 100.0) * k,
+                       255.0 * (1.0 - color->numberOr("Ylw ", 0.0) / 100.0) * k);
+    }
+    if (color->id == "LbCC") {
+        return lab2u32(color->numberOr("Lmnc", 0.0), color->numberOr("A   ", 0.0), color->numberOr("B   ", 0.0));
+    }
+    // RGBC、およびカラーブックの色 (RGB の成分を持つ場合)
+    return rgb2u32(color->numberOr("Rd  ", 0.0), color->numberOr("Grn ", 0.0), color->numberOr("Bl  ", 0.0));
+}
+
+// Photoshop の位置は 0 - 4096、中間点は 0 - 100
+constexpr double LOCATION_SCALE = 4096.0;
+
+struct GrdStop {
+    float position;
+    float midpoint;  // 次のマーカーとの間の中間点
+    uint32_t rgba;   // 不透明度のマーカーではアルファのみ使う
+};
+
+// stops の中間点を考慮して position の値を補間する
+template <typename Mix>
+auto sampleStops(const std::vector<GrdStop>& stops, const float position, Mix mix)
+{
+    if (position <= stops.front().position) return mix(stops.front().rgba, stops.front().rgba, 0.0f);
+    for (size_t i = 0; i + 1 < stops.size(); ++i) {
+        const GrdStop& a = stops[i];
+        const GrdStop& b = stops[i + 1];
+        if (position > b.position) continue;
+        if (b.position <= a.position) return mix(b.rgba, b.rgba, 0.0f);
+
+        // 中間点で 0.5 になるよう、区間内の位置を曲げる
+        const float t   = (position - a.position) / (b.position - a.position);
+        const float mid = std::clamp(a.midpoint, 0.01f, 0.99f);
+        const float w   = std::pow(t, std::log(0.5f) / std::log(mid));
+        return mix(a.rgba, b.rgba, w);
+    }
+    return mix(stops.back().rgba, stops.back().rgba, 0.0f);
+}
+
+std::vector<GrdStop> readStops(const Value* list, const bool is_opacity)
+{
+    std::vector<GrdStop> stops;
+    if (!list || list->kind != Value::Kind::List) return stops;
+    for (const Value& item : list->list) {
+        if (item.kind != Value::Kind::Object) continue;
+        GrdStop stop{};
+        stop.position = static_cast<float>(item.numberOr("Lctn", 0.0) / LOCATION_SCALE);
+        stop.midpoint = static_cast<float>(item.numberOr("Mdpn", 50.0) / 100.0);
+        if (is_opacity) {
+            const double opacity = std::clamp(item.numberOr("Opct", 100.0) / 100.0, 0.0, 1.0);
+            stop.rgba            = static_cast<uint32_t>(std::lround(opacity * 255.0));
+        } else {
+            stop.rgba = colorOf(item);
+        }
+        stops.push_back(stop);
+    }
+    std::stable_sort(stops.begin(), stops.end(), [](const GrdStop& a, const GrdStop& b) { return a.position < b.position; });
+    return stops;
+}
+
+// 色と不透明度のマーカーを 1 つにまとめる
+preset::GradientPreset mergeStops(std::string name, const std::vector<GrdStop>& colors, std::vector<GrdStop> opacities)
+{
+    if (colors.empty()) throw ParseError("gradient has no color stops");
+    if (opacities.empty()) opacities.push_back({0.0f, 0.5f, 0xFF});
+
+    std::vector<float> positions;
+    for (const auto& s : colors) positions.push_back(s.position);
+    for (const auto& s : opacities) positions.push_back(s.position);
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    // 不透明度のマーカーが色のマーカーと同じ位置にしかない場合は、色の中間点をそのまま使う
+    const bool is_color_aligned = positions.size() == colors.size();
+
+    auto mix_color = [](const uint32_t a, const uint32_t b, const float t) {
+        uint32_t out = 0;
+        for (int32_t shift = 8; shift < 32; shift += 8) {
+            const float ca = static_cast<float>((a >> shift) & 0xFF);
+            const float cb = static_cast<float>((b >> shift) & 0xFF);
+            out |= static_cast<uint32_t>(std::lround(ca + (cb - ca) * t)) << shift;
+        }
+        return out;
+    };
+    auto mix_alpha = [](const uint32_t a, const uint32_t b, const float t) {
+        return static_cast<uint32_t>(std::lround(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t));
+    };
+
+    std::vector<Stop> stops;
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const float position = positions[i];
+        const uint32_t rgb   = sampleStops(colors, position, mix_color);
+        const uint32_t alpha = sampleStops(opacities, position, mix_alpha);
+        const float midpoint = is_color_aligned ? colors[i].midpoint : 0.5f;
+        stops.push_back({position, (rgb & 0xFFFFFF00) | (alpha & 0xFF), midpoint});
+    }
+    return detail::makePreset(std::move(name), std::move(stops));
+}
+
+// "$$$/Presets/Gradients/Name=Foreground to Background" のような名前は表示名のみ取り出す
+std::string displayName(std::string name)
+{
+    if (name.starts_with("$$$/")) {
+        if (auto eq = name.find('='); eq != std::string::npos) name = name.substr(eq + 1);
+    }
+    return name;
+}
+}  // namespace
+
+std::vector<preset::GradientPreset> parseGrd(std::istream& in)
+{
+    DescriptorReader reader{in};
+
+    char magic[4];
+    reader.readBytes(magic, 4);
+    if (std::memcmp(magic, "8BGR", 4) != 0) throw ParseError("not a Photoshop gradient");
+    const uint16_t version = reader.readBigEndian<uint16_t>();
+    if (version != 5) throw ParseError("unsupported Photoshop gradient version: " + std::to_string(version));
+    reader.readBigEndian<uint32_t>();  // ディスクリプタのバージョン (16)
+
+    const Value root = reader.readDescriptor(0);
+    const Value* list = root.find("GrdL");
+    if (!list || list->kind != Value::Kind::List) throw ParseError("gradient list not found");
+
+    std::vector<preset::GradientPreset> presets;
+    for (const Value& entry : list->list) {
+        const Value* gradient = entry.find("Grad");
+        if (!gradient || gradient->kind != Value::Kind::Object) continue;
+
+        // ノイズグラデーションはマーカーを持たないため読み込まない
+        if (const Value* form = gradient->find("GrdF"); form && form->id != "CstS") continue;
+
+        const Value* name = gradient->find("Nm  ");
+        presets.push_back(mergeStops(displayName(name ? name->text : "gradient"),
+                                     readStops(gradient->find("Clrs"), false),
+                                     readStops(gradient->find("Trns"), true)));
+    }
+    if (presets.empty()) throw ParseError("no gradients found");
+    return presets;
+}
+
+}  // namespace preset_import
@@ -0,0 +1,71 @@
+#include "preset_library.h"
+
+#include <utility>
+
+namespace gradient_editor {
+
+void PresetLibrary::start(const std::filesystem::path& path, const std::chrono::milliseconds poll_interval)
+{
+    m_manager.setPresetFilePath(path);
+    m_loader.start(path, poll_interval);
+    requestLoad();
+}
+
+void PresetLibrary::requestLoad()
+{
+    m_load_generation = m_manager.writeGeneration();
+    m_loader.requestLoad();
+}
+
+void PresetLibrary::reportError(const std::string& error)
+{
+    if (m_error_callback) m_error_callback(error);
+}
+
+bool PresetLibrary::update()
+{
+    bool is_adopted = false;
+    if (auto result = m_loader.takeResult()) {
+        if (m_manager.writeGeneration() != m_load_generation) {
+            // 読み込み中にこちらで書き込んだため、結果が古い可能性がある
+            requestLoad();
+        } else if (result->load_result.error.empty() || !m_is_loaded) {
+            // 再読み込みに失敗した場合は、表示中のプリセットを残す
+            uint64_t revision = m_file.revision;
+            m_file            = std::move(result->load_result.preset_file);
+            m_file.revision   = revision + 1;
+            m_manager.adoptLoadState(result->manager);
+            m_is_loaded = true;
+            is_adopted  = true;
+
+            // ワーカースレッドは書き込まないため、圧縮とバイナリの更新はジャーナルに追記するこちらで行う
+            auto write_result = m_manager.finishLoad(m_file, result->load_result);
+            if (!write_result.is_success) reportError(write_result.error);
+        }
+        if (!result->load_result.error.empty()) reportError(result->load_result.error);
+    }
+
+    // 自身の書き込みによる変更は無視する
+    if (m_loader.takeChanged() && !m_loader.isLoading() && m_manager.knownFileStamps() != m_manager.currentFileStamps()) {
+        requestLoad();
+    }
+    return is_adopted;
+}
+
+PresetManager::PresetWriteResult PresetLibrary::shutdown(const std::function<void(const preset_file::GradientPresetFile&)>& save_cache)
+{
+    if (!m_is_loaded) {
+        m_loader.stop();
+        return {true, {}};
+    }
+
+    if (save_cache) save_cache(m_file);
+
+    // 読み込み中のワーカーと競合しないよう止めてから、ジャーナルを本体に反映する
+    m_loader.stop();
+    auto write_result = m_manager.compact(m_file);
+    if (!write_result.is_success) reportError(write_result.error);
+    return write_result;
+}
+
+}  // namespace gradient_editor
@@ -0,0 +1,61 @@
+#ifndef PRESET_LIBRARY_H
+#define PRESET_LIBRARY_H
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "gradient_preset.h"
+#include "preset_loader.h"
+
+namespace gradient_editor {
+
+/// @brief GUI スレッドで表示・編集するプリセットと、それをワーカースレッドで読み込む PresetLoader をまとめたクラス
+/// @note 読み込み結果の差し替え (update()) と終了時の後始末 (shutdown()) を GUI に依存せずに行うため、Linux でも確かめられる
+class PresetLibrary {
+public:
+    /// @brief ワーカースレッドから呼ぶ関数を設定する。start() より前に呼ぶこと
+    void setUpdateCallback(std::move_only_function<void()> callback) { m_loader.setUpdateCallback(std::move(callback)); }
+
+    /// @brief 読み込みと書き込みのエラーを受け取る関数を設定する。update() と shutdown() を呼んだスレッドで呼ぶ
+    void setErrorCallback(std::move_only_function<void(const std::string&)> callback) { m_error_callback = std::move(callback); }
+
+    /// @brief ワーカースレッドを開始し、最初の読み込みを要求する
+    void start(const std::filesystem::path& path, std::chrono::milliseconds poll_interval = PresetLoader::DEFAULT_POLL_INTERVAL);
+
+    /// @brief 読み込みが完了していれば結果に差し替え、外部での変更を検知していれば読み込み直す。毎フレーム呼ぶ
+    /// @return 差し替えた場合は true
+    bool update();
+
+    /// @brief 終了時の後始末。save_cache を呼んでからワーカースレッドを止め、ジャーナルを本体に反映する
+    /// @note ワーカーが圧縮中のファイルを読まないよう、圧縮は必ず止めた後に行う。一度も読み込んでいない場合は止めるだけ
+    /// @param save_cache 表示中のプリセットに合わせてキャッシュを保存する関数
+    PresetManager::PresetWriteResult shutdown(const std::function<void(const preset_file::GradientPresetFile&)>& save_cache = {});
+
+    [[nodiscard]] PresetManager& manager() noexcept { return m_manager; }
+    [[nodiscard]] preset_file::GradientPresetFile& file() noexcept { return m_file; }
+    [[nodiscard]] const preset_file::GradientPresetFile& file() const noexcept { return m_file; }
+
+    [[nodiscard]] bool isLoaded() const noexcept { return m_is_loaded; }
+    [[nodiscard]] bool isLoading() const { return m_loader.isLoading(); }
+    [[nodiscard]] bool isWatching() const noexcept { return m_loader.isRunning(); }
+
+private:
+    void requestLoad();
+    void reportError(const std::string& error);
+
+    PresetManager m_manager;
+    preset_file::GradientPresetFile m_file;
+    uint64_t m_load_generation = 0;  // 読み込みを要求した時点の PresetManager::writeGeneration()
+    bool m_is_loaded           = false;
+    std::move_only_function<void(const std::string&)> m_error_callback;
+
+    // ワーカースレッドが他のメンバより先に止まるよう最後に宣言する
+    PresetLoader m_loader;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !PRESET_LIBRARY_H
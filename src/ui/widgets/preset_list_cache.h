@@ -0,0 +1,61 @@
+#ifndef PRESET_LIST_CACHE_H
+#define PRESET_LIST_CACHE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "gradient_preset.h"
+#include "preset_hash.h"
+
+namespace preset_list {
+
+/// @brief プリセット一覧の行ごとに、プリセットから変換したデータと内容のハッシュを保持するキャッシュ
+/// @note 変換は行が初めて表示されたときに 1 回だけ行う。プリセットファイルが変更されたら (revision が変わったら) すべて破棄する
+/// @tparam T 変換後のデータ (GradientData など)
+template <typename T>
+class RowCache {
+public:
+    struct Row {
+        T data{};
+        uint64_t content_hash = 0;  // サムネイルのキャッシュのキー
+        bool is_valid         = false;
+    };
+
+    /// @brief プリセットファイルに合わせる。追加・削除・入れ替え・上書きのいずれかが行われていたら、すべて変換し直す
+    /// @return 破棄した場合は true
+    bool sync(const preset_file::GradientPresetFile& file)
+    {
+        if (m_file == &file && m_revision == file.revision && m_rows.size() == file.presets.size()) return false;
+
+        m_rows.clear();
+        m_rows.resize(file.presets.size());
+        m_file     = &file;
+        m_revision = file.revision;
+        return true;
+    }
+
+    /// @brief index 番目の行を取得する。変換していない場合は decode(preset) で変換する
+    /// @note sync() の後に呼ぶこと
+    template <typename Decode>
+    const Row& get(const preset_file::GradientPresetFile& file, const uint32_t index, Decode&& decode)
+    {
+        Row& row = m_rows[index];
+        if (!row.is_valid) {
+            row.data         = decode(file.presets[index]);
+            row.content_hash = preset_hash::contentHash(preset_hash::canonicalize(file.presets[index]));
+            row.is_valid     = true;
+        }
+        return row;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_rows.size(); }
+
+private:
+    std::vector<Row> m_rows;
+    const preset_file::GradientPresetFile* m_file = nullptr;
+    uint64_t m_revision                           = 0;
+};
+
+}  // namespace preset_list
+
+#endif  // !PRESET_LIST_CACHE_H
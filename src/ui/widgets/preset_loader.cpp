@@ -0,0 +1,98 @@
+#include "preset_loader.h"
+
+#include <utility>
+
+#include "utils/common/file_watcher.h"
+
+namespace gradient_editor {
+
+void PresetLoader::start(const std::filesystem::path& path, const std::chrono::milliseconds poll_interval)
+{
+    stop();
+
+    m_path          = path;
+    m_poll_interval = poll_interval;
+    m_thread        = std::jthread([this](std::stop_token stop_token) { run(std::move(stop_token)); });
+}
+
+void PresetLoader::stop()
+{
+    if (!m_thread.joinable()) return;
+    m_thread.request_stop();
+    m_thread.join();
+
+    std::lock_guard lock(m_mutex);
+    m_is_load_requested = false;
+    m_is_loading        = false;
+}
+
+void PresetLoader::requestLoad()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_is_load_requested = true;
+        m_is_loading        = true;
+    }
+    m_cv.notify_one();
+}
+
+std::unique_ptr<PresetLoader::Result> PresetLoader::takeResult()
+{
+    std::lock_guard lock(m_mutex);
+    return std::move(m_result);
+}
+
+bool PresetLoader::takeChanged()
+{
+    std::lock_guard lock(m_mutex);
+    return std::exchange(m_is_changed, false);
+}
+
+bool PresetLoader::isLoading() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_is_loading;
+}
+
+void PresetLoader::run(std::stop_token stop_token)
+{
+    PresetManager path_resolver{m_path};
+    PollingFileWatcher watcher({m_path, path_resolver.journalPath()});
+
+    while (!stop_token.stop_requested()) {
+        bool is_load_requested = false;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait_for(lock, stop_token, m_poll_interval, [this] { return m_is_load_requested; });
+            if (stop_token.stop_requested()) break;
+            is_load_requested = std::exchange(m_is_load_requested, false);
+        }
+
+        if (!is_load_requested) {
+            if (watcher.poll()) {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_is_changed = true;
+                }
+                if (m_update_callback) m_update_callback();
+            }
+            continue;
+        }
+
+        // 読み込む前の状態を基準にする。読み込み中の変更は次の poll() で検知し、読み込み直させる
+        watcher.poll();
+
+        auto result = std::make_unique<Result>();
+        result->manager.setPresetFilePath(m_path);
+        result->load_result = result->manager.loadPresetFile();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_result     = std::move(result);
+            m_is_loading = m_is_load_requested;
+        }
+        if (m_update_callback) m_update_callback();
+    }
+}
+
+}  // namespace gradient_editor
@@ -0,0 +1,82 @@
+#ifndef PRESET_LOADER_H
+#define PRESET_LOADER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+
+#include "gradient_preset.h"
+
+namespace gradient_editor {
+
+/// @brief プリセットファイルをワーカースレッドで読み込み、外部での変更を監視するクラス
+/// @note 読み込み結果は takeResult() で受け取り、GUI スレッドで差し替える。
+///       ワーカースレッドは専用の PresetManager で読み込むだけで、ファイルには書き込まない。
+///       ジャーナルの圧縮とバイナリの更新は、結果を受け取った GUI スレッドが PresetManager::finishLoad() で行う
+class PresetLoader {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_POLL_INTERVAL{1000};
+
+    struct Result {
+        PresetManager manager;  // 読み込みに使ったインスタンス。adoptLoadState() でジャーナルの状態を引き継ぐ
+        PresetManager::PresetLoadResult load_result;
+    };
+
+    PresetLoader() = default;
+    ~PresetLoader() { stop(); }
+
+    PresetLoader(const PresetLoader&)            = delete;
+    PresetLoader& operator=(const PresetLoader&) = delete;
+
+    /// @brief 結果の準備ができたとき、または変更を検知したときにワーカースレッドから呼ぶ関数を設定する
+    /// @note start() より前に呼ぶこと。GUI スレッドを起こすために使う
+    void setUpdateCallback(std::move_only_function<void()> callback) { m_update_callback = std::move(callback); }
+
+    /// @brief ワーカースレッドを開始する。開始済みの場合は停止してから開始する
+    /// @param poll_interval プリセットファイルとジャーナルの変更を調べる間隔
+    void start(const std::filesystem::path& path, std::chrono::milliseconds poll_interval = DEFAULT_POLL_INTERVAL);
+
+    /// @brief ワーカースレッドを停止する。読み込み中の場合は完了を待つ
+    void stop();
+
+    /// @brief 読み込みを要求する。読み込み中に要求した場合は、完了後にもう一度読み込む
+    void requestLoad();
+
+    /// @brief 読み込みが完了していれば結果を取り出す
+    /// @return 完了していない場合は nullptr
+    [[nodiscard]] std::unique_ptr<Result> takeResult();
+
+    /// @brief 前回の呼び出しからファイルの変更を検知したか。呼び出すと状態は戻る
+    [[nodiscard]] bool takeChanged();
+
+    [[nodiscard]] bool isLoading() const;
+
+    /// @brief ワーカースレッドが動いているか (start() の後、stop() の前か)
+    [[nodiscard]] bool isRunning() const noexcept { return m_thread.joinable(); }
+
+private:
+    void run(std::stop_token stop_token);
+
+    std::filesystem::path m_path;
+    std::chrono::milliseconds m_poll_interval{DEFAULT_POLL_INTERVAL};
+    std::move_only_function<void()> m_update_callback;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable_any m_cv;
+    bool m_is_load_requested = false;
+    bool m_is_loading        = false;
+    bool m_is_changed        = false;
+    std::unique_ptr<Result> m_result;
+
+    // 他のメンバより先に破棄されるよう最後に宣言する
+    std::jthread m_thread;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !PRESET_LOADER_H
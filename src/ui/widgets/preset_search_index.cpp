@@ -0,0 +1,307 @@
+#include "preset_search_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "preset_eval.h"
+
+namespace preset_search {
+
+namespace {
+// 葉に含める要素の数。これ以下の範囲は分割せず総当たりで調べる
+constexpr uint32_t LEAF_SIZE = 32;
+
+char foldAscii(const char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string foldAscii(std::string_view str)
+{
+    std::string folded(str);
+    for (char& c : folded) c = foldAscii(c);
+    return folded;
+}
+
+// 正規直交な Haar 変換で、標本の並びを (平均, 粗い差分, ..., 細かい差分) の順の係数に置き換える。
+// 距離は変わらないまま大まかな形を表す係数が先頭に集まるため、距離の計算を途中で打ち切りやすくなり、
+// k-d 木も分割に効く次元を選びやすくなる
+void haarTransform(Signature& signature) noexcept
+{
+    constexpr float INV_SQRT2 = 0.70710678f;
+    Signature work            = signature;
+    for (uint32_t n = SIGNATURE_SAMPLES; n > 1; n /= 2) {
+        const uint32_t half = n / 2;
+        for (uint32_t i = 0; i < half; ++i) {
+            for (uint32_t c = 0; c < 3; ++c) {
+                const float a                = work[(2 * i) * 3 + c];
+                const float b                = work[(2 * i + 1) * 3 + c];
+                signature[i * 3 + c]         = (a + b) * INV_SQRT2;
+                signature[(half + i) * 3 + c] = (a - b) * INV_SQRT2;
+            }
+        }
+        std::copy_n(signature.begin(), half * 3, work.begin());
+    }
+}
+
+// 距離の 2 乗を求める。limit を超えた時点で打ち切る
+float distanceSquaredBounded(const Signature& a, const Signature& b, const float limit) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t d = 0; d < SIGNATURE_DIMS; d += 6) {
+        for (uint32_t e = d; e < d + 6; ++e) {
+            const float diff = a[e] - b[e];
+            sum += diff * diff;
+        }
+        if (sum >= limit) return sum;
+    }
+    return sum;
+}
+
+// 距離の大きい順に並ぶヒープで、近いものを k 個保持する
+class NearestSet {
+public:
+    explicit NearestSet(const uint32_t k) : m_k{k} { m_items.reserve(k); }
+
+    [[nodiscard]] bool isFull() const noexcept { return m_items.size() >= m_k; }
+    [[nodiscard]] float worst() const noexcept { return isFull() ? m_items.front().first : std::numeric_limits<float>::infinity(); }
+
+    void push(const float distance, const uint32_t index)
+    {
+        if (isFull()) {
+            if (distance >= m_items.front().first) return;
+            std::pop_heap(m_items.begin(), m_items.end());
+            m_items.pop_back();
+        }
+        m_items.emplace_back(distance, index);
+        std::push_heap(m_items.begin(), m_items.end());
+    }
+
+    void take(std::vector<uint32_t>& out)
+    {
+        std::sort_heap(m_items.begin(), m_items.end());
+        for (const auto& item : m_items) out.push_back(item.second);
+    }
+
+private:
+    uint32_t m_k;
+    std::vector<std::pair<float, uint32_t>> m_items;
+};
+}  // namespace
+
+Signature makeSignature(const preset::GradientPreset& preset)
+{
+    Signature signature{};
+    if (preset.colors.empty()) return signature;
+
+    std::array<preset_eval::Oklab, SIGNATURE_SAMPLES> samples;
+    preset_eval::sampleOklab(preset, samples);
+    for (uint32_t j = 0; j < SIGNATURE_SAMPLES; ++j) {
+        signature[j * 3 + 0] = samples[j].x;
+        signature[j * 3 + 1] = samples[j].y;
+        signature[j * 3 + 2] = samples[j].z;
+    }
+    haarTransform(signature);
+    return signature;
+}
+
+Signature makeSignature(const uint32_t rgba)
+{
+    const preset_eval::Oklab lab = preset_eval::rgba2Oklab(rgba);
+    Signature signature{};
+    for (uint32_t j = 0; j < SIGNATURE_SAMPLES; ++j) {
+        signature[j * 3 + 0] = lab.x;
+        signature[j * 3 + 1] = lab.y;
+        signature[j * 3 + 2] = lab.z;
+    }
+    haarTransform(signature);
+    return signature;
+}
+
+float distanceSquared(const Signature& a, const Signature& b) noexcept
+{
+    float sum = 0.0f;
+    for (uint32_t d = 0; d < SIGNATURE_DIMS; ++d) {
+        const float diff = a[d] - b[d];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+void PresetSearchIndex::clear()
+{
+    m_file     = nullptr;
+    m_revision = 0;
+    m_folded_names.clear();
+    m_name_offsets.clear();
+    m_name_order.clear();
+    m_signatures.clear();
+    m_tree.clear();
+    m_tree_positions.clear();
+    m_axes.clear();
+}
+
+void PresetSearchIndex::build(const preset_file::GradientPresetFile& file)
+{
+    clear();
+    m_file     = &file;
+    m_revision = file.revision;
+
+    const uint32_t count = static_cast<uint32_t>(file.presets.size());
+
+    // 名前
+    m_name_offsets.reserve(count + 1);
+    for (const auto& preset : file.presets) {
+        m_name_offsets.push_back(static_cast<uint32_t>(m_folded_names.size()));
+        for (const char c : preset.name) m_folded_names.push_back(foldAscii(c));
+        m_folded_names.push_back('\0');
+    }
+    m_name_offsets.push_back(static_cast<uint32_t>(m_folded_names.size()));
+
+    m_name_order.resize(count);
+    std::iota(m_name_order.begin(), m_name_order.end(), 0u);
+    std::stable_sort(m_name_order.begin(), m_name_order.end(), [this](const uint32_t a, const uint32_t b) {
+        return foldedName(a) < foldedName(b);
+    });
+
+    // 色
+    m_signatures.reserve(count);
+    for (const auto& preset : file.presets) m_signatures.push_back(makeSignature(preset));
+
+    m_tree.resize(count);
+    std::iota(m_tree.begin(), m_tree.end(), 0u);
+    m_axes.assign(count, 0);
+    buildTree(0, count);
+
+    // 葉を走査するときに連続した領域を読むよう、シグネチャを木の順に並べ替える
+    std::vector<Signature> tree_order(count);
+    m_tree_positions.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        tree_order[i]               = m_signatures[m_tree[i]];
+        m_tree_positions[m_tree[i]] = i;
+    }
+    m_signatures = std::move(tree_order);
+}
+
+std::string_view PresetSearchIndex::foldedName(const uint32_t index) const noexcept
+{
+    const uint32_t first = m_name_offsets[index];
+    const uint32_t last  = m_name_offsets[index + 1] - 1;  // 区切りの '\0' を除く
+    return {m_folded_names.data() + first, last - first};
+}
+
+void PresetSearchIndex::buildTree(const uint32_t lo, const uint32_t hi)
+{
+    if (hi - lo <= LEAF_SIZE) return;
+
+    // 値の広がりが最も大きい次元で分割する
+    Signature min_values = m_signatures[m_tree[lo]];
+    Signature max_values = min_values;
+    for (uint32_t i = lo + 1; i < hi; ++i) {
+        const Signature& s = m_signatures[m_tree[i]];
+        for (uint32_t d = 0; d < SIGNATURE_DIMS; ++d) {
+            min_values[d] = std::min(min_values[d], s[d]);
+            max_values[d] = std::max(max_values[d], s[d]);
+        }
+    }
+    uint8_t axis = 0;
+    for (uint32_t d = 1; d < SIGNATURE_DIMS; ++d) {
+        if (max_values[d] - min_values[d] > max_values[axis] - min_values[axis]) axis = static_cast<uint8_t>(d);
+    }
+
+    const uint32_t mid = lo + (hi - lo) / 2;
+    std::nth_element(m_tree.begin() + lo, m_tree.begin() + mid, m_tree.begin() + hi, [this, axis](const uint32_t a, const uint32_t b) {
+        return m_signatures[a][axis] < m_signatures[b][axis];
+    });
+    m_axes[mid] = axis;
+
+    buildTree(lo, mid);
+    buildTree(mid + 1, hi);
+}
+
+void PresetSearchIndex::findByPrefix(std::string_view query, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    const std::string folded = foldAscii(query);
+
+    auto it = std::lower_bound(m_name_order.begin(), m_name_order.end(), std::string_view{folded}, [this](const uint32_t index, std::string_view q) {
+        return foldedName(index) < q;
+    });
+    for (; it != m_name_order.end() && foldedName(*it).starts_with(folded); ++it) out.push_back(*it);
+}
+
+void PresetSearchIndex::findByName(std::string_view query, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    const std::string folded = foldAscii(query);
+    if (folded.empty() || folded.find('\0') != std::string::npos) return;
+
+    std::vector<uint32_t> substring_matches;
+    const std::string_view names{m_folded_names};
+    auto offset_it = m_name_offsets.begin();
+    for (size_t pos = names.find(folded); pos != std::string_view::npos;) {
+        // 見つかった位置を含む名前を求め、次の名前から検索を続ける
+        offset_it            = std::upper_bound(offset_it, m_name_offsets.end(), static_cast<uint32_t>(pos));
+        const uint32_t index = static_cast<uint32_t>(offset_it - m_name_offsets.begin()) - 1;
+        if (m_name_offsets[index] == pos) {
+            out.push_back(index);
+        } else {
+            substring_matches.push_back(index);
+        }
+        pos = names.find(folded, m_name_offsets[index + 1]);
+    }
+    out.insert(out.end(), substring_matches.begin(), substring_matches.end());
+}
+
+void PresetSearchIndex::findSimilar(const Signature& query, const uint32_t k, std::vector<uint32_t>& out) const
+{
+    out.clear();
+    if (k == 0 || m_tree.empty()) return;
+
+    NearestSet nearest{k};
+
+    // 再帰の代わりに明示的なスタックで k-d 木をたどる
+    struct Range {
+        uint32_t lo, hi;
+        float bound;  // この範囲までの距離の下限
+    };
+    std::vector<Range> stack;
+    stack.push_back({0, static_cast<uint32_t>(m_tree.size()), 0.0f});
+
+    while (!stack.empty()) {
+        const Range range = stack.back();
+        stack.pop_back();
+        if (range.bound >= nearest.worst()) continue;
+
+        if (range.hi - range.lo <= LEAF_SIZE) {
+            for (uint32_t i = range.lo; i < range.hi; ++i) {
+                nearest.push(distanceSquaredBounded(query, m_signatures[i], nearest.worst()), m_tree[i]);
+            }
+            continue;
+        }
+
+        const uint32_t mid = range.lo + (range.hi - range.lo) / 2;
+        nearest.push(distanceSquaredBounded(query, m_signatures[mid], nearest.worst()), m_tree[mid]);
+
+        const uint8_t axis    = m_axes[mid];
+        const float diff      = query[axis] - m_signatures[mid][axis];
+        const float far_bound = std::max(range.bound, diff * diff);
+        const Range lower{range.lo, mid, diff < 0.0f ? range.bound : far_bound};
+        const Range upper{mid + 1, range.hi, diff < 0.0f ? far_bound : range.bound};
+
+        // 近い側を先に調べるよう、後に積む
+        if (diff < 0.0f) {
+            stack.push_back(upper);
+            stack.push_back(lower);
+        } else {
+            stack.push_back(lower);
+            stack.push_back(upper);
+        }
+    }
+
+    nearest.take(out);
+}
+
+}  // namespace preset_search
@@ -0,0 +1,77 @@
+#ifndef PRESET_SEARCH_INDEX_H
+#define PRESET_SEARCH_INDEX_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gradient_preset.h"
+
+namespace preset_search {
+
+// シグネチャとしてグラデーションを標本化する点の数
+inline constexpr uint32_t SIGNATURE_SAMPLES = 8;
+inline constexpr uint32_t SIGNATURE_DIMS    = SIGNATURE_SAMPLES * 3;
+
+/// @brief 等間隔に標本化した Oklab の色 (L, a, b) を並べた固定長のベクトル
+/// @note 不透明度は考慮しない
+using Signature = std::array<float, SIGNATURE_DIMS>;
+
+/// @brief プリセットのシグネチャを求める。中間点とぼかし幅はシェーダーと同じ方法で反映する
+Signature makeSignature(const preset::GradientPreset& preset);
+
+/// @brief 単色のシグネチャを求める
+Signature makeSignature(uint32_t rgba);
+
+/// @brief シグネチャ間の距離の 2 乗
+float distanceSquared(const Signature& a, const Signature& b) noexcept;
+
+/// @brief プリセットを名前と色の近さで検索するためのインデックス
+/// @note プリセットファイルが変更されたら build() で作り直す
+class PresetSearchIndex {
+public:
+    void build(const preset_file::GradientPresetFile& file);
+    void clear();
+
+    /// @brief 指定したプリセットファイルから作られたインデックスか
+    [[nodiscard]] bool isBuiltFor(const preset_file::GradientPresetFile& file) const noexcept
+    {
+        return m_file == &file && m_revision == file.revision;
+    }
+
+    [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(m_signatures.size()); }
+    [[nodiscard]] const Signature& signature(const uint32_t index) const noexcept { return m_signatures[m_tree_positions[index]]; }
+
+    /// @brief 名前が query で始まるプリセットを名前順に列挙する。大文字と小文字は区別しない
+    void findByPrefix(std::string_view query, std::vector<uint32_t>& out) const;
+
+    /// @brief 名前に query を含むプリセットを列挙する。query で始まるものを先に、それぞれプリセットの順に並べる
+    void findByName(std::string_view query, std::vector<uint32_t>& out) const;
+
+    /// @brief シグネチャが近い順に最大 k 個のプリセットを列挙する
+    void findSimilar(const Signature& query, uint32_t k, std::vector<uint32_t>& out) const;
+
+private:
+    const preset_file::GradientPresetFile* m_file = nullptr;
+    uint64_t m_revision                           = 0;
+
+    // 小文字にした名前を '\0' 区切りで連結したもの。部分一致の検索はこの文字列を 1 回走査するだけで済む
+    std::string m_folded_names;
+    std::vector<uint32_t> m_name_offsets;  // 各名前の先頭の位置。末尾に番兵を置く
+    std::vector<uint32_t> m_name_order;    // 名前順に並べたインデックス
+
+    // k-d 木。m_tree[lo, hi) の中央の要素を節とし、m_axes に分割に使った次元を持つ
+    std::vector<Signature> m_signatures;     // 木の順に並べたシグネチャ
+    std::vector<uint32_t> m_tree;            // 木の順に並べたプリセットのインデックス
+    std::vector<uint32_t> m_tree_positions;  // プリセットのインデックスから木の中の位置への対応
+    std::vector<uint8_t> m_axes;
+
+    [[nodiscard]] std::string_view foldedName(uint32_t index) const noexcept;
+    void buildTree(uint32_t lo, uint32_t hi);
+};
+
+}  // namespace preset_search
+
+#endif  // !PRESET_SEARCH_INDEX_H
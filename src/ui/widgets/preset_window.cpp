@@ -3,12 +3,16 @@
 #include <algorithm>
 #include <iostream>
 #include <ranges>
+#include <unordered_set>
 
 #include "IconsMaterialSymbols.h"
 #include "gradient_widget.h"
 #include "imgui.h"
 #include "preset_controller.h"
 #include "utils/aviutl2/config2_utils.h"
+#include "utils/common/frame_arena.h"
+#include "utils/common/frame_profiler.h"
+#include "utils/imgui/imgui_utils.h"
 
 namespace gradient_editor {
 void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::GradientPresetFile& file)
@@ -16,6 +20,14 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse;
     ImGui::Begin("PresetWindow", is_open, window_flags);
 
+    if (m_is_loading) {
+        m_is_clicked_preset = false;
+        ImGui::TextDisabled("%s", aul2::tr(L"読み込み中..."));
+        ImGui::End();
+        return;
+    }
+    syncGradientCache(file);
+
     float input_width{ImGui::GetContentRegionAvail().x};
     ImGuiStyle& style = ImGui::GetStyle();
     input_width -= ImGui::GetFrameHeight();
@@ -40,16 +52,16 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
     }
 
     if (ImGui::Button(ICON_MS_SAVE "##overwrite")) {
-        ImGui::OpenPopup((aul2::tr(L"上書き保存") + "###Overwrite confirmation").c_str());
+        ImGui::OpenPopup(aul2::tr(L"上書き保存", "###Overwrite confirmation"));
     }
 
     // 上書き確認ダイアログ
     ImVec2 center = ImGui::GetMainViewport()->GetCenter();
     ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
     ImGuiWindowFlags modal_flags = ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoMove;
-    if (ImGui::BeginPopupModal((aul2::tr(L"上書き保存") + "###Overwrite confirmation").c_str(), nullptr, modal_flags)) {
+    if (ImGui::BeginPopupModal(aul2::tr(L"上書き保存", "###Overwrite confirmation"), nullptr, modal_flags)) {
         std::string replace_preset_name = file.presets[m_selected_preset_index].name;
-        ImGui::Text(aul2::tr(L"プリセット \"%s\" を現在のグラデーションで \"%s\" として上書きしますか?").c_str(), replace_preset_name.c_str(), m_preset_name);
+        ImGui::Text(aul2::tr(L"プリセット \"%s\" を現在のグラデーションで \"%s\" として上書きしますか?"), replace_preset_name.c_str(), m_preset_name);
         ImGui::Separator();
 
         // 中央に配置
@@ -58,14 +70,14 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
         float off       = (avail - btn_width) * 0.5f;
         if (off > 0.0f) ImGui::SetCursorPosX(ImGui::GetCursorPosX() + off);
 
-        if (ImGui::Button((aul2::tr(L"はい") + "###Yes").c_str(), ImVec2(120, 0))) {
+        if (ImGui::Button(aul2::tr(L"はい", "###Yes"), ImVec2(120, 0))) {
             auto preset = PresetController::gradient2preset(m_target_gradient_data);
             PresetController::overwritePreset(manager, file, preset, m_preset_name, m_selected_preset_index);
             ImGui::CloseCurrentPopup();
         }
         ImGui::SetItemDefaultFocus();
         ImGui::SameLine();
-        if (ImGui::Button((aul2::tr(L"いいえ") + "###No").c_str(), ImVec2(120, 0))) {
+        if (ImGui::Button(aul2::tr(L"いいえ", "###No"), ImVec2(120, 0))) {
             ImGui::CloseCurrentPopup();
         }
         ImGui::EndPopup();
@@ -74,7 +86,7 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
     ImGui::PopStyleVar();
 
     if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal | ImGuiHoveredFlags_NoSharedDelay)) {
-        ImGui::SetTooltip(aul2::tr(L"上書き保存").c_str(), ImGui::GetStyle().HoverDelayNormal);
+        ImGui::SetTooltip(aul2::tr(L"上書き保存"), ImGui::GetStyle().HoverDelayNormal);
     }
     ImGui::SameLine(0.0f, 0.0f);
 
@@ -83,12 +95,26 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
     // if (exist_same_preset_name) ImGui::BeginDisabled(true);
     if (ImGui::Button(ICON_MS_LIBRARY_ADD "##add")) {
         auto preset = PresetController::gradient2preset(m_target_gradient_data);
-        PresetController::addPreset(manager, file, preset, m_preset_name);
+        auto result = PresetController::addPreset(manager, file, m_dedup_index, preset, m_preset_name);
+        if (result.duplicate_index) {
+            // 同じグラデーションが保存済みの場合は、そのプリセットを選択する
+            m_selected_preset_index = *result.duplicate_index;
+            std::snprintf(m_preset_name, sizeof(m_preset_name), "%s", file.presets[m_selected_preset_index].name.c_str());
+        }
     }
     // if (exist_same_preset_name) ImGui::EndDisabled();
     ImGui::PopStyleVar();
     if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal | ImGuiHoveredFlags_NoSharedDelay)) {
-        ImGui::SetTooltip(aul2::tr(L"新規保存").c_str(), ImGui::GetStyle().HoverDelayNormal);
+        ImGui::SetTooltip(aul2::tr(L"新規保存"), ImGui::GetStyle().HoverDelayNormal);
+    }
+
+    // 検索欄
+    ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - ImGui::GetFrameHeight());
+    ImGui::InputTextWithHint("##PresetSearch", aul2::tr(ICON_MS_SEARCH " ", L"検索"), m_search_query, IM_ARRAYSIZE(m_search_query));
+    ImGui::SameLine(0.0f, 0.0f);
+    imgui_utils::pushToggleButton(ICON_MS_PALETTE "##similar", &m_sort_by_similarity, ImVec2(ImGui::GetFrameHeight(), 0.0f));
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal | ImGuiHoveredFlags_NoSharedDelay)) {
+        ImGui::SetTooltip(aul2::tr(L"現在のグラデーションに近い順に表示"), ImGui::GetStyle().HoverDelayNormal);
     }
 
     m_is_clicked_preset = false;
@@ -98,74 +124,180 @@ void PresetWindow::render(bool* is_open, PresetManager& manager, preset_file::Gr
     ImGui::End();
 }
 
+void PresetWindow::syncGradientCache(const preset_file::GradientPresetFile& file)
+{
+    if (!m_gradient_cache.sync(file)) return;
+
+    // 再読み込みでプリセットが減った場合に備える
+    if (m_selected_preset_index >= file.presets.size()) m_selected_preset_index = 0;
+}
+
+const preset_list::RowCache<gradient_editor::GradientData>::Row& PresetWindow::getPresetRow(const preset_file::GradientPresetFile& file, const uint32_t index)
+{
+    return m_gradient_cache.get(file, index, &PresetController::preset2gradient);
+}
+
+void PresetWindow::loadThumbnailCache(const std::filesystem::path& path)
+{
+    m_thumbnail_cache.load(path, CustomUI::thumbnailRendererId());
+}
+
+void PresetWindow::saveThumbnailCache(const std::filesystem::path& path, const preset_file::GradientPresetFile& file)
+{
+    if (!m_thumbnail_cache.isDirty()) return;
+
+    std::unordered_set<uint64_t> live_hashes;
+    live_hashes.reserve(file.presets.size());
+    for (const auto& preset : file.presets) live_hashes.insert(preset_hash::contentHash(preset_hash::canonicalize(preset)));
+    m_thumbnail_cache.save(path, [&live_hashes](const uint64_t hash) { return live_hashes.contains(hash); });
+}
+
+bool PresetWindow::updateVisiblePresets(const preset_file::GradientPresetFile& file)
+{
+    const bool has_query = m_search_query[0] != '\0';
+    if (!has_query && !m_sort_by_similarity) {
+        m_search_index.clear();
+        m_visible_indices.clear();
+        return false;
+    }
+
+    bool is_changed = !m_search_index.isBuiltFor(file);
+    if (is_changed) m_search_index.build(file);
+
+    // 編集中のグラデーションは毎フレーム渡されるため、シグネチャが変わったときのみ検索し直す
+    preset_search::Signature signature{};
+    if (m_sort_by_similarity) signature = preset_search::makeSignature(PresetController::gradient2preset(m_target_gradient_data));
+
+    is_changed |= m_visible_query != m_search_query || m_visible_sorted != m_sort_by_similarity || m_visible_signature != signature;
+    if (!is_changed) return true;
+
+    m_visible_query     = m_search_query;
+    m_visible_sorted    = m_sort_by_similarity;
+    m_visible_signature = signature;
+
+    if (!has_query) {
+        m_search_index.findSimilar(signature, SIMILAR_PRESET_COUNT, m_visible_indices);
+        return true;
+    }
+
+    m_search_index.findByName(m_visible_query, m_visible_indices);
+    if (m_sort_by_similarity) {
+        // 名前で絞り込んだ結果を色の近い順に並べる
+        frame_arena::Vector<std::pair<float, uint32_t>> distances{&frame_arena::get()};
+        distances.reserve(m_visible_indices.size());
+        for (const uint32_t index : m_visible_indices) {
+            distances.emplace_back(preset_search::distanceSquared(signature, m_search_index.signature(index)), index);
+        }
+        std::stable_sort(distances.begin(), distances.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (size_t i = 0; i < distances.size(); ++i) m_visible_indices[i] = distances[i].second;
+    }
+    return true;
+}
+
 void PresetWindow::renderPresetList(PresetManager& manager, preset_file::GradientPresetFile& file)
 {
+    frame_profiler::ScopedZone zone{"PresetWindow::renderPresetList"};
+
+    syncGradientCache(file);
+
+    const uint32_t preset_count = static_cast<uint32_t>(file.presets.size());
+
+    // 検索中は該当するプリセットのみ表示する
+    const bool is_filtered   = updateVisiblePresets(file);
+    const uint32_t row_count = is_filtered ? static_cast<uint32_t>(m_visible_indices.size()) : preset_count;
+
+    // 初回のみ先頭のプリセットを選択する
+    if (!m_is_init && preset_count > 0) {
+        m_is_clicked_preset     = true;
+        m_selected_preset_index = 0;
+        m_selected_gradient     = getPresetRow(file, 0).data;
+        std::snprintf(m_preset_name, sizeof(m_preset_name), "%s", file.presets[0].name.c_str());
+        m_is_init = true;
+    }
+
+    // 行の高さ。ボタンの描画時と同じ FramePadding で求める
+    ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(ImGui::GetStyle().FrameBorderSize, ImGui::GetStyle().FrameBorderSize));
+    const float row_height = ImGui::GetFrameHeight() * 1.5f;
+    ImGui::PopStyleVar();
+
     bool is_delete        = false;
     uint32_t delete_index = 0;
-    for (const auto& [i, preset] : file.presets | std::views::enumerate) {
-        ImGui::PushID(static_cast<int>(i));
-
-        // プリセットからグラデーションのデータを得る
-        gradient_editor::GradientData gradient = PresetController::preset2gradient(preset);
-
-        // プリセットを描画
-        ImGui::PushStyleVarY(ImGuiStyleVar_ItemSpacing, 0.0f);
-        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(ImGui::GetStyle().FrameBorderSize, ImGui::GetStyle().FrameBorderSize));
-        ImVec2 gradient_size = ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetFrameHeight() * 1.5f);
-
-        // プリセットが押されたとき または初回のみ
-        if (CustomUI::drawGradientButton(preset.name, gradient_size, gradient) || (!m_is_init)) {
-            m_is_clicked_preset     = true;
-            m_selected_preset_index = static_cast<uint32_t>(i);                              // 選択中のインデックスを更新
-            m_selected_gradient     = gradient;                                              // 選択中のグラデーションを更新
-            std::snprintf(m_preset_name, sizeof(m_preset_name), "%s", preset.name.c_str());  // プリセット名を更新
-            if (!m_is_init) m_is_init = true;
-        }
+    bool is_swap          = false;
+    uint32_t swap_index_1 = 0;
+    uint32_t swap_index_2 = 0;
 
-        if (m_is_clicked_preset) {
-        }
+    // 表示範囲内の行のみ描画する
+    ImGuiListClipper clipper;
+    clipper.Begin(static_cast<int>(row_count), row_height);
+    while (clipper.Step()) {
+        for (uint32_t row = static_cast<uint32_t>(clipper.DisplayStart); row < static_cast<uint32_t>(clipper.DisplayEnd); ++row) {
+            const uint32_t i   = is_filtered ? m_visible_indices[row] : row;
+            const auto& preset = file.presets[i];
+            ImGui::PushID(static_cast<int>(i));
 
-        ImGui::PopStyleVar(2);
+            // プリセットからグラデーションのデータを得る
+            const auto& row                               = getPresetRow(file, i);
+            const gradient_editor::GradientData& gradient = row.data;
 
-        // 名前表示
-        if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNone)) {
-            ImGui::SetTooltip(preset.name.c_str());
-        }
+            // プリセットを描画
+            ImGui::PushStyleVarY(ImGuiStyleVar_ItemSpacing, 0.0f);
+            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(ImGui::GetStyle().FrameBorderSize, ImGui::GetStyle().FrameBorderSize));
+            ImVec2 gradient_size = ImVec2(ImGui::GetContentRegionAvail().x, row_height);
 
-        // 右クリックメニュー
-        if (ImGui::BeginPopupContextItem()) {
-            // 削除メニュー
-            if (ImGui::Selectable(aul2::tr(L"削除").c_str())) {
-                is_delete    = true;
-                delete_index = static_cast<uint32_t>(i);
-                ImGui::CloseCurrentPopup();
+            // プリセットが押されたとき。サムネイルは内容が変わるまで再描画せず、以前の起動で描画したものがあればそれを使う
+            if (CustomUI::drawGradientButton(preset.name, gradient_size, i, row.content_hash, gradient, &m_thumbnail_cache)) {
+                m_is_clicked_preset     = true;
+                m_selected_preset_index = i;                                                     // 選択中のインデックスを更新
+                m_selected_gradient     = gradient;                                              // 選択中のグラデーションを更新
+                std::snprintf(m_preset_name, sizeof(m_preset_name), "%s", preset.name.c_str());  // プリセット名を更新
             }
-            ImGui::EndPopup();
-        }
 
-        // この要素がドラッグ開始された場合
-        if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceNoPreviewTooltip)) {
-            ImGui::SetDragDropPayload("GRADIENT_PRESET", &i, sizeof(uint32_t));
-            ImGui::EndDragDropSource();
-        }
+            ImGui::PopStyleVar(2);
 
-        // この要素の上にドラッグ中のカーソルがあるか
-        if (ImGui::BeginDragDropTarget()) {
-            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("GRADIENT_PRESET")) {
-                // データの整合性チェック
-                IM_ASSERT(payload->DataSize == sizeof(uint32_t));
+            // 名前表示
+            if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNone)) {
+                ImGui::SetTooltip(preset.name.c_str());
+            }
 
-                // ドラッグ元のインデックスを取り出す
-                uint32_t payload_index = *(const uint32_t*)payload->Data;
+            // 右クリックメニュー
+            if (ImGui::BeginPopupContextItem()) {
+                // 削除メニュー
+                if (ImGui::Selectable(aul2::tr(L"削除"))) {
+                    is_delete    = true;
+                    delete_index = i;
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::EndPopup();
+            }
 
-                PresetController::swapPreset(manager, file, static_cast<uint32_t>(i), payload_index);
+            // この要素がドラッグ開始された場合。検索中は並びが異なるため入れ替えない
+            if (!is_filtered && ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceNoPreviewTooltip)) {
+                ImGui::SetDragDropPayload("GRADIENT_PRESET", &i, sizeof(uint32_t));
+                ImGui::EndDragDropSource();
+            }
+
+            // この要素の上にドラッグ中のカーソルがあるか
+            if (!is_filtered && ImGui::BeginDragDropTarget()) {
+                if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("GRADIENT_PRESET")) {
+                    // データの整合性チェック
+                    IM_ASSERT(payload->DataSize == sizeof(uint32_t));
+
+                    // ドラッグ元のインデックスを取り出す
+                    is_swap      = true;
+                    swap_index_1 = i;
+                    swap_index_2 = *(const uint32_t*)payload->Data;
+                }
+                ImGui::EndDragDropTarget();
             }
-            ImGui::EndDragDropTarget();
-        }
 
-        ImGui::PopID();
+            ImGui::PopID();
+        }
     }
 
+    // 描画中にプリセットファイルを変更しないよう、一覧の描画後に反映する
+    if (is_swap) {
+        PresetController::swapPreset(manager, file, swap_index_1, swap_index_2);
+    }
     if (is_delete) {
         PresetController::deletePreset(manager, file, delete_index);
     }
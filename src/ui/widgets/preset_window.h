@@ -1,8 +1,19 @@
 #ifndef PRESET_WINDOW_H
 #define PRESET_WINDOW_H
 
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "gradient_data.h"
 #include "gradient_preset.h"
+#include "preset_controller.h"
+#include "preset_hash.h"
+#include "preset_list_cache.h"
+#include "preset_search_index.h"
+#include "thumbnail_disk_cache.h"
 
 namespace gradient_editor {
 
@@ -15,15 +26,59 @@ public:
     [[nodiscard]] gradient_editor::GradientData getTargetGradientData() const noexcept { return m_selected_gradient; }
     void setTargetGradientData(const gradient_editor::GradientData& data) noexcept { m_target_gradient_data = data; }
 
+    /// @brief 読み込み中はプリセット一覧の代わりにメッセージを表示する
+    void setLoading(const bool is_loading) noexcept { m_is_loading = is_loading; }
+    [[nodiscard]] bool isLoading() const noexcept { return m_is_loading; }
+
+    /// @brief 他のソフトのグラデーションから変換したプリセットをまとめて追加する
+    PresetController::ImportPresetsResult importPresets(PresetManager& manager, preset_file::GradientPresetFile& file, std::vector<preset::GradientPreset> presets)
+    {
+        return PresetController::importPresets(manager, file, m_dedup_index, std::move(presets));
+    }
+
+    /// @brief サムネイルのディスクキャッシュを読み込む。プリセットの読み込みの完了を待たずに呼んでよい
+    void loadThumbnailCache(const std::filesystem::path& path);
+
+    /// @brief サムネイルのディスクキャッシュを保存する。file にないプリセットのサムネイルは保存しない
+    /// @note 前回の読み込みから新たに描画したサムネイルがない場合は何もしない
+    void saveThumbnailCache(const std::filesystem::path& path, const preset_file::GradientPresetFile& file);
+
 private:
     bool m_is_init           = false;
     char m_preset_name[32]   = "";
     bool m_is_clicked_preset = false;
+    bool m_is_loading        = false;
     gradient_editor::GradientData m_selected_gradient;
     uint32_t m_selected_preset_index = 0;
 
     gradient_editor::GradientData m_target_gradient_data;
 
+    // プリセットから変換したグラデーションのキャッシュ。プリセットファイルが変更されたときに破棄する
+    preset_list::RowCache<gradient_editor::GradientData> m_gradient_cache;
+
+    void syncGradientCache(const preset_file::GradientPresetFile& file);
+    const preset_list::RowCache<gradient_editor::GradientData>::Row& getPresetRow(const preset_file::GradientPresetFile& file, const uint32_t index);
+
+    thumbnail_cache::ThumbnailDiskCache m_thumbnail_cache;
+
+    // 新規保存・インポート時の重複の検出に使う
+    preset_hash::PresetDedupIndex m_dedup_index;
+
+    // 検索。インデックスは検索中のみ作成し、プリセットファイルが変更されたら作り直す
+    static constexpr uint32_t SIMILAR_PRESET_COUNT = 50;  // 色の近さで並べるときに表示する数
+
+    char m_search_query[64]   = "";
+    bool m_sort_by_similarity = false;
+    preset_search::PresetSearchIndex m_search_index;
+    std::vector<uint32_t> m_visible_indices;  // 検索結果として表示するプリセットのインデックス
+    std::string m_visible_query;
+    bool m_visible_sorted = false;
+    preset_search::Signature m_visible_signature{};
+
+    /// @brief 検索結果を更新する
+    /// @return 検索中の場合は true
+    bool updateVisiblePresets(const preset_file::GradientPresetFile& file);
+
     void renderPresetList(PresetManager& manager, preset_file::GradientPresetFile& file);
 };
 
@@ -0,0 +1,78 @@
+#include "profiler_window.h"
+
+#include <fstream>
+#include <string>
+
+#include "core/app_state.h"
+#include "imgui.h"
+#include "utils/aviutl2/config2_utils.h"
+
+namespace gradient_editor {
+
+void ProfilerWindow::render(bool* is_open, const std::filesystem::path& trace_path)
+{
+    ImGui::SetNextWindowSize(ImVec2(420.0f, 240.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("ProfilerWindow", is_open, ImGuiWindowFlags_NoDocking)) {
+        ImGui::End();
+        return;
+    }
+
+    // 毎フレーム並べ替えると計測に影響するため、一定の間隔で集計し直す
+    const int64_t now_ns = frame_profiler::nowNs();
+    if (now_ns - m_last_update_ns >= UPDATE_PERIOD_NS) {
+        const auto events = frame_profiler::collect(now_ns - WINDOW_NS);
+        m_stats           = frame_profiler::summarize(events);
+        m_last_update_ns  = now_ns;
+    }
+
+    if (ImGui::Button(aul2::tr(L"トレースを書き出す"))) {
+        exportTrace(trace_path);
+    }
+
+    constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("##ProfilerStats", 6, table_flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("zone", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("p50 [ms]");
+        ImGui::TableSetupColumn("p95 [ms]");
+        ImGui::TableSetupColumn("p99 [ms]");
+        ImGui::TableSetupColumn("max [ms]");
+        ImGui::TableHeadersRow();
+        for (const auto& stats : m_stats) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(stats.name.data(), stats.name.data() + stats.name.size());
+            ImGui::TableNextColumn();
+            ImGui::Text("%zu", stats.count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p50_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p95_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.p99_ms);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", stats.max_ms);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+bool ProfilerWindow::exportTrace(const std::filesystem::path& trace_path) const
+{
+    // リングバッファに残っているすべての区間を書き出す
+    const auto events = frame_profiler::collect();
+    std::ofstream ofs(trace_path, std::ios::binary | std::ios::trunc);
+    if (ofs) frame_profiler::writeChromeTrace(ofs, events);
+    if (!ofs) {
+        g_app_state.log.error(L"failed to write trace: {}", trace_path.wstring());
+        return false;
+    }
+
+    g_app_state.log.info(L"wrote {} zones to {}", events.size(), trace_path.wstring());
+    return true;
+}
+
+}  // namespace gradient_editor
@@ -0,0 +1,31 @@
+#ifndef PROFILER_WINDOW_H
+#define PROFILER_WINDOW_H
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "utils/common/frame_profiler.h"
+
+namespace gradient_editor {
+
+/// @brief プロファイラで記録した処理時間のパーセンタイルを表示するウィンドウ
+/// @note 表示している間だけ記録を有効にする
+class ProfilerWindow {
+public:
+    static constexpr int64_t WINDOW_NS        = 2'000'000'000;  // 集計する期間
+    static constexpr int64_t UPDATE_PERIOD_NS = 500'000'000;    // 集計し直す間隔
+
+    /// @param trace_path 「トレースを書き出す」で書き出すファイル
+    void render(bool* is_open, const std::filesystem::path& trace_path);
+
+private:
+    bool exportTrace(const std::filesystem::path& trace_path) const;
+
+    std::vector<frame_profiler::ZoneStats> m_stats;
+    int64_t m_last_update_ns = 0;
+};
+
+}  // namespace gradient_editor
+
+#endif  // !PROFILER_WINDOW_H
@@ -0,0 +1,142 @@
+#include "thumbnail_disk_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace thumbnail_cache {
+
+bool ThumbnailDiskCache::isValidSize(const int32_t width, const int32_t height) noexcept
+{
+    return width > 0 && height > 0 && width <= UINT16_MAX && height <= UINT16_MAX;
+}
+
+bool ThumbnailDiskCache::load(const std::filesystem::path& path, const uint64_t renderer_id)
+{
+    m_renderer_id = renderer_id;
+    m_entries.clear();
+    m_file_bytes.clear();
+    m_is_dirty = false;
+
+    // ファイル全体を 1 回で読み込む
+    std::ifstream ifs(path, std::ios::binary | std::ios::ate);
+    if (!ifs) return false;
+    const std::streamoff file_size = ifs.tellg();
+    if (file_size < static_cast<std::streamoff>(sizeof(Header))) return false;
+    m_file_bytes.resize(static_cast<size_t>(file_size));
+    ifs.seekg(0);
+    if (!ifs.read(reinterpret_cast<char*>(m_file_bytes.data()), file_size)) {
+        m_file_bytes.clear();
+        return false;
+    }
+
+    Header header;
+    std::memcpy(&header, m_file_bytes.data(), sizeof(Header));
+    const uint64_t entries_end = sizeof(Header) + uint64_t{header.entry_count} * sizeof(Entry);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+        header.renderer_id != renderer_id || entries_end > m_file_bytes.size()) {
+        m_file_bytes.clear();
+        return false;
+    }
+
+    m_entries.reserve(header.entry_count);
+    for (uint32_t i = 0; i < header.entry_count; ++i) {
+        Entry entry;
+        std::memcpy(&entry, m_file_bytes.data() + sizeof(Header) + i * sizeof(Entry), sizeof(Entry));
+        const uint64_t pixel_size = uint64_t{entry.width} * entry.height * 4;
+        if (entry.width == 0 || entry.height == 0 || entry.pixel_offset < entries_end ||
+            entry.pixel_offset > m_file_bytes.size() || pixel_size > m_file_bytes.size() - entry.pixel_offset) {
+            // 壊れたファイルは使わない
+            m_entries.clear();
+            m_file_bytes.clear();
+            return false;
+        }
+
+        const Key key{entry.content_hash, (uint32_t{entry.width} << 16) | entry.height};
+        m_entries[key].pixels = std::span<const std::byte>{m_file_bytes.data() + entry.pixel_offset, static_cast<size_t>(pixel_size)};
+    }
+    return true;
+}
+
+std::span<const std::byte> ThumbnailDiskCache::find(const uint64_t content_hash, const int32_t width, const int32_t height)
+{
+    if (!isValidSize(width, height)) return {};
+    auto it = m_entries.find({content_hash, (static_cast<uint32_t>(width) << 16) | static_cast<uint32_t>(height)});
+    if (it == m_entries.end()) return {};
+    it->second.last_use = ++m_use_counter;
+    return it->second.pixels;
+}
+
+void ThumbnailDiskCache::store(const uint64_t content_hash, const int32_t width, const int32_t height, std::vector<std::byte> pixels)
+{
+    if (!isValidSize(width, height) || pixels.size() != static_cast<size_t>(width) * height * 4) return;
+
+    CachedPixels& cached = m_entries[{content_hash, (static_cast<uint32_t>(width) << 16) | static_cast<uint32_t>(height)}];
+    cached.owned         = std::move(pixels);
+    cached.pixels        = cached.owned;
+    cached.last_use      = ++m_use_counter;
+    m_is_dirty           = true;
+}
+
+bool ThumbnailDiskCache::save(const std::filesystem::path& path, const std::function<bool(uint64_t)>& is_live)
+{
+    // 内容ごとに最後に使ったサイズを残す
+    std::unordered_map<uint64_t, const std::pair<const Key, CachedPixels>*> latest;
+    for (const auto& item : m_entries) {
+        if (!is_live(item.first.content_hash)) continue;
+        auto [it, inserted] = latest.try_emplace(item.first.content_hash, &item);
+        if (!inserted && item.second.last_use > it->second->second.last_use) it->second = &item;
+    }
+
+    std::vector<const std::pair<const Key, CachedPixels>*> items;
+    items.reserve(latest.size());
+    for (const auto& [hash, item] : latest) items.push_back(item);
+    std::sort(items.begin(), items.end(), [](const auto* a, const auto* b) { return a->second.last_use > b->second.last_use; });
+    uint64_t pixel_bytes = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        pixel_bytes += items[i]->second.pixels.size();
+        if (pixel_bytes > MAX_PIXEL_BYTES) {
+            items.resize(i);
+            break;
+        }
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version     = VERSION;
+    header.renderer_id = m_renderer_id;
+    header.entry_count = static_cast<uint32_t>(items.size());
+
+    std::vector<std::byte> bytes(sizeof(Header) + items.size() * sizeof(Entry));
+    std::memcpy(bytes.data(), &header, sizeof(Header));
+    size_t entry_offset = sizeof(Header);
+    for (const auto* item : items) {
+        const Entry entry{
+            .content_hash = item->first.content_hash,
+            .width        = static_cast<uint16_t>(item->first.size >> 16),
+            .height       = static_cast<uint16_t>(item->first.size & 0xFFFF),
+            .pixel_offset = static_cast<uint32_t>(bytes.size()),
+        };
+        std::memcpy(bytes.data() + entry_offset, &entry, sizeof(Entry));
+        entry_offset += sizeof(Entry);
+        bytes.insert(bytes.end(), item->second.pixels.begin(), item->second.pixels.end());
+    }
+
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!ofs) return false;
+        ofs.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!ofs) return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) return false;
+    m_is_dirty = false;
+    return true;
+}
+
+}  // namespace thumbnail_cache
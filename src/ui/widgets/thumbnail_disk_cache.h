@@ -0,0 +1,94 @@
+#ifndef THUMBNAIL_DISK_CACHE_H
+#define THUMBNAIL_DISK_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+/// @brief プリセットのサムネイルのピクセルをファイルに保存し、次回の起動時に描画せずに表示するためのキャッシュ
+/// @note レイアウト (すべてリトルエンディアン、4 バイト境界):
+///       Header | Entry[entry_count] | RGBA8 のピクセル
+///       キーはプリセットの内容のハッシュ (preset_hash::contentHash()) とピクセルサイズ。名前は含めないため、名前の変更や並べ替えでは無効にならない
+namespace thumbnail_cache {
+
+inline constexpr char MAGIC[4]    = {'G', 'E', 'T', 'C'};
+inline constexpr uint32_t VERSION = 1;
+inline constexpr char EXTENSION[] = ".thumbnails";
+
+// 保存するピクセルの合計の上限。起動時の読み込みに時間がかからないよう、超える場合は最近使ったものから残す
+inline constexpr uint64_t MAX_PIXEL_BYTES = 16ull << 20;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint64_t renderer_id;  // 描画に使ったシェーダーの識別子。一致しない場合はファイル全体を使わない
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+struct Entry {
+    uint64_t content_hash;
+    uint16_t width;
+    uint16_t height;
+    uint32_t pixel_offset;  // ファイルの先頭からのオフセット
+};
+
+static_assert(sizeof(Header) == 24);
+static_assert(sizeof(Entry) == 16);
+
+class ThumbnailDiskCache {
+public:
+    /// @brief キャッシュファイルを 1 回の読み込みでメモリに読み込む
+    /// @param renderer_id 現在のシェーダーの識別子。ファイルのものと異なる場合は読み込まない
+    /// @return 読み込めなかった場合は false。キャッシュは空になる
+    bool load(const std::filesystem::path& path, uint64_t renderer_id);
+
+    /// @brief サムネイルのピクセルを探す
+    /// @return 見つからない場合は空。見つかった場合は width * height * 4 バイトの RGBA8
+    [[nodiscard]] std::span<const std::byte> find(uint64_t content_hash, int32_t width, int32_t height);
+
+    /// @brief 描画したサムネイルのピクセルを登録する
+    void store(uint64_t content_hash, int32_t width, int32_t height, std::vector<std::byte> pixels);
+
+    /// @brief 前回の読み込み・保存から変更があったか
+    [[nodiscard]] bool isDirty() const noexcept { return m_is_dirty; }
+
+    /// @brief キャッシュファイルを書き出す
+    /// @param is_live プリセットファイルに存在する内容のハッシュか。存在しないものは保存しない
+    /// @note 同じ内容で複数のサイズがある場合は、最後に使ったサイズのみ保存する。合計は MAX_PIXEL_BYTES までにする
+    bool save(const std::filesystem::path& path, const std::function<bool(uint64_t)>& is_live);
+
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+
+private:
+    struct Key {
+        uint64_t content_hash;
+        uint32_t size;  // (width << 16) | height
+
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept { return std::hash<uint64_t>{}(key.content_hash ^ (uint64_t{key.size} * 0x9E3779B97F4A7C15ull)); }
+    };
+    struct CachedPixels {
+        std::span<const std::byte> pixels;  // m_file_bytes または owned を指す
+        std::vector<std::byte> owned;       // このセッションで描画したもの
+        uint64_t last_use = 0;
+    };
+
+    static bool isValidSize(int32_t width, int32_t height) noexcept;
+
+    uint64_t m_renderer_id = 0;
+    std::vector<std::byte> m_file_bytes;
+    std::unordered_map<Key, CachedPixels, KeyHash> m_entries;
+    uint64_t m_use_counter = 0;
+    bool m_is_dirty        = false;
+};
+
+}  // namespace thumbnail_cache
+
+#endif  // !THUMBNAIL_DISK_CACHE_H
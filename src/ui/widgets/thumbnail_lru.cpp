@@ -0,0 +1,74 @@
+#include "thumbnail_lru.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace thumbnail_cache {
+
+ThumbnailLru::ThumbnailLru(const size_t capacity)
+    : m_capacity{std::max<size_t>(capacity, 1)}
+{
+    m_entries.reserve(m_capacity);
+    m_index.reserve(m_capacity);
+}
+
+ThumbnailLru::Slot ThumbnailLru::acquire(const uint64_t key, const uint64_t content_hash, const int32_t width, const int32_t height)
+{
+    uint32_t index = NONE;
+    if (auto it = m_index.find(key); it != m_index.end()) {
+        index = it->second;
+        unlink(index);
+    } else if (m_entries.size() >= m_capacity) {
+        // 最も長く使われていないもののスロットを引き継ぐ。ノードを付け替えるため、ハッシュテーブルの確保は起きない
+        index = m_tail;
+        unlink(index);
+        auto node  = m_index.extract(m_entries[index].key);
+        node.key() = key;
+        m_index.insert(std::move(node));
+        m_entries[index].key      = key;
+        m_entries[index].is_valid = false;
+    } else {
+        index = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back(Entry{.key = key});
+        m_index.emplace(key, index);
+    }
+    pushFront(index);
+
+    Entry& entry      = m_entries[index];
+    const bool is_hit = entry.is_valid && entry.content_hash == content_hash && entry.width == width && entry.height == height;
+    entry.content_hash = content_hash;
+    entry.width        = width;
+    entry.height       = height;
+    entry.is_valid     = true;
+    return {.index = index, .needs_render = !is_hit};
+}
+
+void ThumbnailLru::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+    m_head = NONE;
+    m_tail = NONE;
+}
+
+void ThumbnailLru::unlink(const uint32_t index) noexcept
+{
+    Entry& entry = m_entries[index];
+    if (entry.prev != NONE) m_entries[entry.prev].next = entry.next;
+    if (entry.next != NONE) m_entries[entry.next].prev = entry.prev;
+    if (m_head == index) m_head = entry.next;
+    if (m_tail == index) m_tail = entry.prev;
+    entry.prev = NONE;
+    entry.next = NONE;
+}
+
+void ThumbnailLru::pushFront(const uint32_t index) noexcept
+{
+    Entry& entry = m_entries[index];
+    entry.next   = m_head;
+    if (m_head != NONE) m_entries[m_head].prev = index;
+    m_head = index;
+    if (m_tail == NONE) m_tail = index;
+}
+
+}  // namespace thumbnail_cache
@@ -0,0 +1,57 @@
+#ifndef THUMBNAIL_LRU_H
+#define THUMBNAIL_LRU_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace thumbnail_cache {
+
+/// @brief 表示中のサムネイルの容量付きの LRU
+/// @note テクスチャなどの実体は持たず、スロット番号で呼び出し側の配列の要素を指す。
+///       容量を超えた場合は最も長く使われていないもののスロットを新しいキーに渡すため、スロット番号は capacity 未満に収まる
+class ThumbnailLru {
+public:
+    explicit ThumbnailLru(size_t capacity);
+
+    struct Slot {
+        uint32_t index    = 0;      // 呼び出し側の配列のインデックス
+        bool needs_render = false;  // 新規、スロットの引き継ぎ、内容かサイズの変更のいずれかで、描画し直す必要がある
+    };
+
+    /// @brief key のサムネイルのスロットを取得し、最近使ったものにする
+    /// @param content_hash 内容のハッシュ。前回と異なる場合は描画し直す
+    Slot acquire(uint64_t key, uint64_t content_hash, int32_t width, int32_t height);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+    struct Entry {
+        uint64_t key          = 0;
+        uint64_t content_hash = 0;
+        int32_t width         = 0;
+        int32_t height        = 0;
+        bool is_valid         = false;
+        uint32_t prev         = NONE;  // より最近使ったもの
+        uint32_t next         = NONE;  // より長く使われていないもの
+    };
+
+    size_t m_capacity;
+    std::vector<Entry> m_entries;                   // スロット番号 -> エントリ
+    std::unordered_map<uint64_t, uint32_t> m_index;  // キー -> スロット番号
+    uint32_t m_head = NONE;                          // 最近使ったもの
+    uint32_t m_tail = NONE;                          // 最も長く使われていないもの
+
+    void unlink(uint32_t index) noexcept;
+    void pushFront(uint32_t index) noexcept;
+};
+
+}  // namespace thumbnail_cache
+
+#endif  // !THUMBNAIL_LRU_H
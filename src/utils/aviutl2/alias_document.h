@@ -0,0 +1,224 @@
+#ifndef ALIAS_DOCUMENT_H
+#define ALIAS_DOCUMENT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alias_parser.h"
+
+namespace alias_parser {
+
+/// @brief オブジェクトのエイリアス全体を元の文字列を参照したまま索引付けするクラス
+/// @note [Object], [Object.N] のセクションと key=v1,v2,... の行をコピーせずに保持する。
+///       parse() に渡した文字列は、このクラスを使い終わるまで有効である必要がある。
+///       索引はすべて平坦な配列で持ち、再度 parse() しても確保済みの領域を使い回すため、
+///       同程度の大きさのエイリアスを繰り返し解析・変更する間はヒープ確保が起きない
+class AliasDocument {
+public:
+    struct Section {
+        std::string_view name;         // [] を除いたセクション名
+        std::string_view effect_name;  // effect.name の値。ない場合は空
+        uint32_t first_key = 0;        // m_keys の中でのこのセクションのキーの範囲
+        uint32_t key_count = 0;
+    };
+
+    /// @brief エイリアス全体を解析する。前回の解析結果は破棄される
+    /// @param alias エイリアス文字列全体
+    void parse(std::string_view alias)
+    {
+        clear();
+
+        size_t start = 0;
+        while (start < alias.size()) {
+            auto lf       = alias.find('\n', start);
+            size_t end    = lf == std::string_view::npos ? alias.size() : lf;
+            size_t next   = lf == std::string_view::npos ? alias.size() : lf + 1;
+            size_t cr_end = (end > start && alias[end - 1] == '\r') ? end - 1 : end;
+
+            Line line;
+            line.raw = alias.substr(start, cr_end - start);
+            line.eol = alias.substr(cr_end, next - cr_end);
+            addLine(line);
+
+            start = next;
+        }
+        finishSection();
+    }
+
+    /// @brief 解析結果を破棄する。確保済みの領域 (変更後の値の文字列を含む) は次の parse() で使い回す
+    void clear() noexcept
+    {
+        m_lines.clear();
+        m_sections.clear();
+        m_keys.clear();
+        m_patched_lines.clear();
+    }
+
+    /// @brief セクション名からセクションを取得する
+    /// @param name [] を除いたセクション名 (例: "Object", "Object.0")
+    [[nodiscard]] const Section* findSection(std::string_view name) const noexcept
+    {
+        for (const auto& section : m_sections) {
+            if (section.name == name) return &section;
+        }
+        return nullptr;
+    }
+
+    /// @brief effect.name が一致する index 番目のセクションを取得する
+    /// @param effect_name エフェクト名 (UTF-8)
+    /// @param effect_index 同名のエフェクトの中でのインデックス
+    [[nodiscard]] const Section* findEffectSection(std::string_view effect_name, const uint32_t effect_index) const noexcept
+    {
+        if (effect_name.empty()) return nullptr;
+        uint32_t index = 0;
+        for (const auto& section : m_sections) {
+            if (section.effect_name == effect_name && index++ == effect_index) return &section;
+        }
+        return nullptr;
+    }
+
+    /// @brief 設定値を取得する。setValue() で変更済みの場合は変更後の値を返す
+    [[nodiscard]] std::optional<std::string_view> getValue(const Section& section, std::string_view key) const
+    {
+        const uint32_t line_index = findLine(section, key);
+        if (line_index == NO_LINE) return std::nullopt;
+        if (isPatched(line_index)) return m_patch_values[line_index];
+        return m_lines[line_index].value;
+    }
+
+    /// @brief 設定値を変更する。元の文字列は書き換えず、変更した行だけを保持する
+    /// @return キーが存在しない場合は false
+    bool setValue(const Section& section, std::string_view key, std::string_view value)
+    {
+        const uint32_t line_index = findLine(section, key);
+        if (line_index == NO_LINE) return false;
+
+        if (m_patch_values.size() < m_lines.size()) m_patch_values.resize(m_lines.size());
+        if (!isPatched(line_index)) m_patched_lines.push_back(line_index);
+        m_patch_values[line_index].assign(value);
+        m_lines[line_index].is_patched = true;
+        return true;
+    }
+
+    /// @brief key=v1,v2,... の index 番目の値のみを変更する
+    /// @return キーが存在しない場合は false
+    bool setToken(const Section& section, std::string_view key, const uint32_t index, std::string_view replacement)
+    {
+        auto current = getValue(section, key);
+        if (!current) return false;
+
+        m_token_buffer.clear();
+        appendReplacedNthToken(m_token_buffer, *current, index, replacement);
+        return setValue(section, key, m_token_buffer);
+    }
+
+    /// @brief 変更した行を変更順に列挙する
+    /// @param func (キー, 変更後の値) を受け取る関数
+    template <typename F>
+    void forEachPatch(F&& func) const
+    {
+        for (uint32_t line_index : m_patched_lines) {
+            func(m_lines[line_index].key, std::string_view{m_patch_values[line_index]});
+        }
+    }
+
+    [[nodiscard]] bool hasPatches() const noexcept { return !m_patched_lines.empty(); }
+
+    void clearPatches()
+    {
+        for (uint32_t line_index : m_patched_lines) m_lines[line_index].is_patched = false;
+        m_patched_lines.clear();
+    }
+
+    /// @brief エイリアス全体を out の末尾に書き出す。変更した行以外は元の文字列をそのまま使う
+    void serialize(std::string& out) const
+    {
+        for (size_t i = 0; i < m_lines.size(); ++i) {
+            const Line& line = m_lines[i];
+            if (line.is_patched) {
+                out.append(line.key);
+                out.push_back('=');
+                out.append(m_patch_values[i]);
+            } else {
+                out.append(line.raw);
+            }
+            out.append(line.eol);
+        }
+    }
+
+private:
+    struct Line {
+        std::string_view raw;  // 改行を除いた行全体
+        std::string_view eol;  // 改行 (\r\n, \n, または空)
+        std::string_view key;
+        std::string_view value;
+        bool is_patched = false;
+    };
+
+    struct KeyEntry {
+        std::string_view key;
+        uint32_t line_index;
+    };
+
+    static constexpr std::string_view EFFECT_NAME_KEY = "effect.name";
+    static constexpr uint32_t NO_LINE                 = UINT32_MAX;
+
+    std::vector<Line> m_lines;
+    std::vector<Section> m_sections;
+    std::vector<KeyEntry> m_keys;             // セクションごとにキーで整列した、キー -> 行番号
+    std::vector<std::string> m_patch_values;  // 行番号 -> 変更後の値。clear() しても文字列の領域は残す
+    std::vector<uint32_t> m_patched_lines;
+    std::string m_token_buffer;
+
+    [[nodiscard]] bool isPatched(const uint32_t line_index) const noexcept { return m_lines[line_index].is_patched; }
+
+    [[nodiscard]] uint32_t findLine(const Section& section, std::string_view key) const noexcept
+    {
+        const auto first = m_keys.begin() + section.first_key;
+        const auto last  = first + section.key_count;
+        const auto it    = std::lower_bound(first, last, key, [](const KeyEntry& entry, std::string_view k) { return entry.key < k; });
+        return it != last && it->key == key ? it->line_index : NO_LINE;
+    }
+
+    // 直前のセクションのキーを整列する。同じキーが複数ある場合は最初の行が見つかるよう、行番号の順にする
+    void finishSection() noexcept
+    {
+        if (m_sections.empty()) return;
+        Section& section  = m_sections.back();
+        section.key_count = static_cast<uint32_t>(m_keys.size()) - section.first_key;
+        std::sort(m_keys.begin() + section.first_key, m_keys.end(), [](const KeyEntry& a, const KeyEntry& b) {
+            return a.key < b.key || (a.key == b.key && a.line_index < b.line_index);
+        });
+    }
+
+    void addLine(Line line)
+    {
+        uint32_t line_index = static_cast<uint32_t>(m_lines.size());
+
+        if (line.raw.size() >= 2 && line.raw.front() == '[' && line.raw.back() == ']') {
+            // セクションの開始
+            finishSection();
+            Section& section  = m_sections.emplace_back();
+            section.name      = line.raw.substr(1, line.raw.size() - 2);
+            section.first_key = static_cast<uint32_t>(m_keys.size());
+        } else if (auto eq = line.raw.find('='); eq != std::string_view::npos && !m_sections.empty()) {
+            // key=value の行
+            line.key   = line.raw.substr(0, eq);
+            line.value = line.raw.substr(eq + 1);
+
+            m_keys.push_back({line.key, line_index});
+            Section& section = m_sections.back();
+            if (line.key == EFFECT_NAME_KEY && section.effect_name.empty()) section.effect_name = line.value;
+        }
+
+        m_lines.push_back(line);
+    }
+};
+
+}  // namespace alias_parser
+
+#endif  // !ALIAS_DOCUMENT_H
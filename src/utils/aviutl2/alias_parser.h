@@ -2,38 +2,81 @@
 #define ALIAS_PARSER_H
 
 #include <algorithm>
-#include <regex>
-#include <sstream>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
 namespace alias_parser {
+/// @brief エイリアスから指定したセクションの値を取得する。コピーは行わない
+/// @param src エイリアス文字列 1 行分
+/// @param index 取得したい値があるセクションのインデックス
+/// @return 指定したセクションの値の文字列。セクション数を超える場合は最初の値。src を参照する
+inline std::string_view getNthTokenView(std::string_view src, const uint32_t index)
+{
+    size_t start = 0;
+    for (uint32_t current = 0; current < index; ++current) {
+        auto pos = src.find(',', start);
+        if (pos == std::string_view::npos) {
+            // セクション数を超える場合は最初の値を返す
+            return src.substr(0, src.find(','));
+        }
+        start = pos + 1;
+    }
+    return src.substr(start, src.find(',', start) - start);
+}
+
 /// @brief エイリアスから指定したセクションの値を文字列で取得する
 /// @param src エイリアス文字列 1 行分
 /// @param index 取得したい値があるセクションのインデックス
 /// @return 指定したセクションの値の文字列
 inline std::string getNthToken(std::string_view src, const uint32_t index)
 {
-    uint32_t start   = 0;
-    uint32_t current = 0;
+    return std::string{getNthTokenView(src, index)};
+}
 
-    while (true) {
+/// @brief first 番目から last 番目までのセクションの値をすべて同じ値に置換した 1 行分を out の末尾に追加する。out の容量が足りていればヒープ確保は起きない
+/// @param out 置換後のエイリアス文字列 1 行分を追加するバッファ
+/// @param src エイリアス文字列 1 行分
+/// @param first 置換したい最初のセクションのインデックス。セクション数を超える場合は replacement のみの 1 値になる
+/// @param last 置換したい最後のセクションのインデックス。セクション数を超える場合は最後のセクションまで置換する
+/// @param replacement 置換に使う値の文字列
+inline void appendReplacedTokenRange(std::string& out, std::string_view src, const uint32_t first, const uint32_t last, std::string_view replacement)
+{
+    size_t start = 0;
+    for (uint32_t current = 0; current < first; ++current) {
         auto pos = src.find(',', start);
-        if (current == index) {
-            return std::string(
-                pos == std::string_view::npos
-                    ? src.substr(start)
-                    : src.substr(start, pos - start));
+        if (pos == std::string_view::npos) {
+            out.append(replacement);
+            return;
         }
-        if (pos == std::string_view::npos) break;
-        start = static_cast<uint32_t>(pos) + 1u;
-        ++current;
+        start = pos + 1;
     }
 
-    auto first = src.find(',');
-    return std::string(first == std::string_view::npos ? src : src.substr(0, first));
+    // 置換する値の前までをそのまま追加する
+    out.append(src.substr(0, start));
+    for (uint32_t current = first;; ++current) {
+        out.append(replacement);
+        auto end = src.find(',', start);
+        if (end == std::string_view::npos) return;
+        if (current >= last) {
+            // 置換する値の後ろはカンマを含めてそのまま追加する
+            out.append(src.substr(end));
+            return;
+        }
+        out.push_back(',');
+        start = end + 1;
+    }
 }
 
+/// @brief 指定したセクションの値を置換した 1 行分を out の末尾に追加する。out の容量が足りていればヒープ確保は起きない
+/// @param out 置換後のエイリアス文字列 1 行分を追加するバッファ
+/// @param src エイリアス文字列 1 行分
+/// @param index 置換したい値のあるセクションのインデックス。セクション数を超える場合は replacement のみの 1 値になる
+/// @param replacement 置換に使う値の文字列
+inline void appendReplacedNthToken(std::string& out, std::string_view src, const uint32_t index, std::string_view replacement)
+{
+    appendReplacedTokenRange(out, src, index, index, replacement);
+}
 
 /// @brief 指定したセクションの値を置換する
 /// @param src エイリアス文字列 1 行分
@@ -42,42 +85,9 @@ inline std::string getNthToken(std::string_view src, const uint32_t index)
 /// @return 置換後のエイリアス文字列 1 行分
 inline std::string replaceNthToken(std::string_view src, const uint32_t index, std::string_view replacement)
 {
-    uint32_t start   = 0;
-    uint32_t current = 0;
-    std::string result{};
-
-    auto slice = [](const std::string& s, const int32_t first, const int32_t end) {
-        return s.substr(first, std::abs(end - first) + 1);
-    };
-
-    while (true) {
-        auto pos = src.find(',', start);
-        if (current == index) {
-            // 最後の要素ならカンマを付けない
-            if (pos == std::string_view::npos) {
-                result += std::string{replacement};
-                break;
-            }
-            result += std::string{replacement} + ",";
-            start = static_cast<uint32_t>(pos) + 1;
-            ++current;
-            continue;
-        }
-
-        if (pos == std::string_view::npos) {
-            if (index >= current + 1) {
-                result = std::string{replacement};
-            } else {
-                result += slice(std::string{src}, start, static_cast<int32_t>(std::ssize(src)) - 1);
-            }
-            break;
-        }
-
-        result += slice(std::string{src}, start, static_cast<int32_t>(pos));
-        start = static_cast<uint32_t>(pos) + 1;
-        ++current;
-    }
-
+    std::string result;
+    result.reserve(src.size() + replacement.size());
+    appendReplacedNthToken(result, src, index, replacement);
     return result;
 }
 
@@ -88,14 +98,21 @@ inline std::string replaceNthToken(std::string_view src, const uint32_t index, s
 inline int32_t getFrameCount(std::string_view alias)
 {
     int32_t count{2};  // デフォルトは開始と終了の 2
-    // [Object] セクションにある frame= 行と一致する
-    std::regex re(R"(\[Object\][\s\S]*?\r?\n(frame=.*))");
-    std::string s{alias};
-    std::smatch m;
-    if (std::regex_search(s, m, re)) {
-        std::string frame_line = m[1].str();
-        count                  = static_cast<int32_t>(std::count(frame_line.begin(), frame_line.end(), ',')) + 1;
-    }
+
+    constexpr std::string_view OBJECT_SECTION = "[Object]";
+    constexpr std::string_view FRAME_KEY      = "\nframe=";
+
+    // [Object] 以降で最初に行頭に現れる frame= 行を探す
+    auto object_pos = alias.find(OBJECT_SECTION);
+    if (object_pos == std::string_view::npos) return count;
+
+    auto frame_pos = alias.find(FRAME_KEY, object_pos + OBJECT_SECTION.size());
+    if (frame_pos == std::string_view::npos) return count;
+
+    // 行末 (\r または \n) までのカンマを数える
+    std::string_view frame_line = alias.substr(frame_pos + 1);
+    frame_line                  = frame_line.substr(0, frame_line.find_first_of("\r\n"));
+    count                       = static_cast<int32_t>(std::ranges::count(frame_line, ',')) + 1;
     return count;
 }
 }  // namespace alias_parser
@@ -2,18 +2,43 @@
 #define CONFIG2_UTILS_H
 
 #include <string>
+#include <string_view>
 
 #include "config2_utils.h"
 #include "core/app_state.h"
-#include "utils/common/str_conv.h"
+#include "translation_cache.h"
 
 namespace aul2 {
-inline std::string tr(const wchar_t* key)
+
+/// @brief ホストの翻訳を返す。設定を受け取る前は nullptr
+inline const wchar_t* translate(const wchar_t* key)
+{
+    if (!gradient_editor::g_app_state.config) return nullptr;
+    return gradient_editor::g_app_state.config->translate(gradient_editor::g_app_state.config, key);
+}
+
+inline TranslationCache& translationCache()
+{
+    static TranslationCache cache{translate};
+    return cache;
+}
+
+/// @brief 翻訳した文字列を返す。ポインタは言語が変わるまで有効
+inline const char* tr(const wchar_t* key)
+{
+    return translationCache().get({}, key, {});
+}
+
+/// @brief 翻訳した文字列の後ろに suffix ("###ID" や書式など) を付けた文字列を返す
+inline const char* tr(const wchar_t* key, const std::string_view suffix)
+{
+    return translationCache().get({}, key, suffix);
+}
+
+/// @brief 翻訳した文字列の前後に prefix (アイコンなど) と suffix を付けた文字列を返す
+inline const char* tr(const std::string_view prefix, const wchar_t* key, const std::string_view suffix = {})
 {
-    if (!gradient_editor::g_app_state.config) {
-        return {};
-    }
-    return str_conv::wideCharToMultiByte(gradient_editor::g_app_state.config->translate(gradient_editor::g_app_state.config, key));
+    return translationCache().get(prefix, key, suffix);
 }
 
 inline uint32_t getColor(const std::string& name)
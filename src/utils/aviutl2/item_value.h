@@ -0,0 +1,91 @@
+#ifndef ITEM_VALUE_H
+#define ITEM_VALUE_H
+
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "utils/common/str_conv.h"
+
+// 設定項目の値と文字列の変換。SDK のヘッダーに依存しないため、プラグイン以外 (テストなど) からも使える
+namespace plugin2_utils {
+
+/// @brief 設定値を文字列に変換する際に使う固定長のバッファ。変換時にヒープ確保を行わない
+struct ValueBuffer {
+    char data[64]{};
+    size_t size{0};
+
+    [[nodiscard]] std::string_view view() const noexcept { return {data, size}; }
+};
+
+/// @brief 設定値を文字列に変換する。整数と浮動小数点数は buf に書き込み、文字列はそのまま参照する
+/// @tparam T 変換する値の型
+/// @param buf 変換結果を書き込むバッファ
+/// @param value 変換する値
+/// @param default_value 変換に失敗した場合に代わりに使う値
+/// @param base value が整数の場合の出力基数。2進数から36進数まで
+/// @param fmt value が浮動小数点数の場合の出力フォーマット
+/// @return 変換後の文字列。buf または value を参照する
+template <typename T>
+std::string_view formatItemValue(ValueBuffer& buf, const T& value, const T& default_value, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
+{
+    char* first = std::begin(buf.data);
+    char* last  = std::end(buf.data);
+    std::to_chars_result res{first, std::errc::value_too_large};
+
+    if constexpr (std::integral<T>) {
+        if (base >= 2 && base <= 36) {
+            res = std::to_chars(first, last, value, base);
+            if (res.ec != std::errc()) res = std::to_chars(first, last, default_value, base);
+        }
+    } else if constexpr (std::floating_point<T>) {
+        res = std::to_chars(first, last, value, fmt);
+        if (res.ec != std::errc()) res = std::to_chars(first, last, default_value, fmt);
+    } else if constexpr (std::constructible_from<std::string_view, const T&>) {
+        return std::string_view{value};
+    } else {
+        return std::string_view{default_value};
+    }
+
+    if (res.ec != std::errc()) {
+        buf.data[0] = '0';
+        buf.size    = 1;
+    } else {
+        buf.size = static_cast<size_t>(res.ptr - first);
+    }
+    return buf.view();
+}
+
+/// @brief get_object_item_value() で取得した値の文字列をデフォルト値の型 T に変換する
+/// @tparam T デフォルト値の型
+/// @param token 値の文字列 (セクション 1 つ分)
+/// @param default_value 変換に失敗した場合に返される値
+/// @param base 整数の基数。2進数から36進数まで
+/// @param fmt 浮動小数点数のフォーマット指定
+template <typename T>
+T parseItemValue(std::string_view token, const T default_value, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
+{
+    if constexpr (std::integral<T>) {
+        return str_conv::charsToInt(token, default_value, base);
+    } else if constexpr (std::floating_point<T>) {
+        return str_conv::charsToFloatingPoint(token, default_value, fmt);
+    } else if constexpr (std::constructible_from<T, const char*>) {
+        return T{token};
+    }
+}
+
+/// @brief set_object_item_value() に渡す 1 行分を組み立てるためのバッファ。確保済みの領域をスレッドごとに使い回す
+inline std::string& itemLineBuffer()
+{
+    thread_local std::string buffer;
+    buffer.clear();
+    return buffer;
+}
+
+}  // namespace plugin2_utils
+
+#endif  // !ITEM_VALUE_H
@@ -1,6 +1,7 @@
 #ifndef LOGGER_WRAPPER_H
 #define LOGGER_WRAPPER_H
 
+#include <atomic>
 #include <format>
 #include <string>
 #include <utility>
@@ -10,87 +11,127 @@
 #include <windows.h>
 
 #include "aviutl2_sdk.h"
+#include "utils/common/async_log.h"
 
+/// @brief AviUtl2 のログ出力をバックグラウンドのスレッドで行うラッパー
+/// @note レベルで除外されるログは整形しない。ホストの呼び出しとワイド文字列への変換はバックグラウンドのスレッドで行う
 class LoggerWrapper {
 public:
+    using LogLevel = async_log::LogLevel;
+
     LoggerWrapper() = default;
 
     explicit LoggerWrapper(LOG_HANDLE* log_handle)
-        : m_log_handle(log_handle)
     {
+        setLogHandle(log_handle);
     }
 
-    void setLogHandle(LOG_HANDLE* logHandle) noexcept { m_log_handle = logHandle; }
+    ~LoggerWrapper() { stop(); }
 
-    [[nodiscard]] LOG_HANDLE* getLogHandle() const noexcept { return m_log_handle; }
+    LoggerWrapper(const LoggerWrapper&)            = delete;
+    LoggerWrapper& operator=(const LoggerWrapper&) = delete;
 
-    // log
-    template <typename... Args>
-    void log(std::wstring_view fmt, Args... args) const
+    /// @brief 出力先を設定し、出力するスレッドを開始する。設定前のログは開始後に出力する
+    void setLogHandle(LOG_HANDLE* logHandle)
     {
-        m_log_handle->log(m_log_handle, std::vformat(fmt, std::make_wformat_args(args...)).c_str());
+        m_logger.stop();
+        m_log_handle = logHandle;
+        if (m_log_handle) m_logger.start([this](const async_log::LogRecord& record) { write(record); });
     }
 
-    template <typename... Args>
-    void log(std::string_view fmt, Args... args) const
+    [[nodiscard]] LOG_HANDLE* getLogHandle() const noexcept { return m_log_handle; }
+
+    /// @brief 積まれているログをすべて出力してからスレッドを停止する。プラグインの終了時に呼ぶ
+    void stop() { m_logger.stop(); }
+
+    /// @brief 出力を待つ
+    void flush() { m_logger.flush(); }
+
+    /// @brief 実行時に出力する最低のレベルを設定する
+    void setMinLevel(const LogLevel level) noexcept { m_min_level.store(level, std::memory_order_relaxed); }
+
+    template <LogLevel Level>
+    [[nodiscard]] bool isEnabled() const noexcept
     {
-        m_log_handle->log(m_log_handle, toWideString(std::vformat(fmt, std::make_format_args(args...))).c_str());
+        if constexpr (Level < async_log::COMPILE_TIME_MIN_LEVEL) {
+            return false;
+        } else {
+            return Level >= m_min_level.load(std::memory_order_relaxed);
+        }
     }
 
+    // log
+    template <typename... Args>
+    void log(std::wstring_view fmt, const Args&... args) { push<LogLevel::Log>(fmt, args...); }
+
+    template <typename... Args>
+    void log(std::string_view fmt, const Args&... args) { push<LogLevel::Log>(fmt, args...); }
+
     // info
     template <typename... Args>
-    void info(std::wstring_view fmt, Args... args) const
-    {
-        m_log_handle->info(m_log_handle, std::vformat(fmt, std::make_wformat_args(args...)).c_str());
-    }
+    void info(std::wstring_view fmt, const Args&... args) { push<LogLevel::Info>(fmt, args...); }
 
     template <typename... Args>
-    void info(std::string_view fmt, Args... args) const
-    {
-        m_log_handle->info(m_log_handle, toWideString(std::vformat(fmt, std::make_format_args(args...))).c_str());
-    }
+    void info(std::string_view fmt, const Args&... args) { push<LogLevel::Info>(fmt, args...); }
 
     // warn
     template <typename... Args>
-    void warn(std::wstring_view fmt, Args... args) const
-    {
-        m_log_handle->warn(m_log_handle, std::vformat(fmt, std::make_wformat_args(args...)).c_str());
-    }
+    void warn(std::wstring_view fmt, const Args&... args) { push<LogLevel::Warn>(fmt, args...); }
 
     template <typename... Args>
-    void warn(std::string_view fmt, Args... args) const
-    {
-        m_log_handle->warn(m_log_handle, toWideString(std::vformat(fmt, std::make_format_args(args...))).c_str());
-    }
+    void warn(std::string_view fmt, const Args&... args) { push<LogLevel::Warn>(fmt, args...); }
 
     // error
     template <typename... Args>
-    void error(std::wstring_view fmt, Args... args) const
-    {
-        m_log_handle->error(m_log_handle, std::vformat(fmt, std::make_wformat_args(args...)).c_str());
-    }
+    void error(std::wstring_view fmt, const Args&... args) { push<LogLevel::Error>(fmt, args...); }
 
     template <typename... Args>
-    void error(std::string_view fmt, Args... args) const
-    {
-        m_log_handle->error(m_log_handle, toWideString(std::vformat(fmt, std::make_format_args(args...))).c_str());
-    }
+    void error(std::string_view fmt, const Args&... args) { push<LogLevel::Error>(fmt, args...); }
 
     // verbose
     template <typename... Args>
-    void verbose(std::wstring_view fmt, Args... args) const
+    void verbose(std::wstring_view fmt, const Args&... args) { push<LogLevel::Verbose>(fmt, args...); }
+
+    template <typename... Args>
+    void verbose(std::string_view fmt, const Args&... args) { push<LogLevel::Verbose>(fmt, args...); }
+
+private:
+    template <LogLevel Level, typename Fmt, typename... Args>
+    void push(const Fmt fmt, const Args&... args)
     {
-        m_log_handle->verbose(m_log_handle, std::vformat(fmt, std::make_wformat_args(args...)).c_str());
+        if constexpr (Level >= async_log::COMPILE_TIME_MIN_LEVEL) {
+            // 除外されるログは整形しない
+            if (!isEnabled<Level>()) return;
+            m_logger.push(async_log::formatRecord(Level, fmt, args...));
+        }
     }
 
-    template <typename... Args>
-    void verbose(std::string_view fmt, Args... args) const
+    // バックグラウンドのスレッドから呼ばれる
+    void write(const async_log::LogRecord& record) const
     {
-        m_log_handle->verbose(m_log_handle, toWideString(std::vformat(fmt, std::make_format_args(args...))).c_str());
+        const std::wstring wide_text = record.is_wide ? std::wstring{} : toWideString(record.text);
+        const wchar_t* text          = record.is_wide ? record.wide_text.c_str() : wide_text.c_str();
+        switch (record.level) {
+            case LogLevel::Verbose:
+                m_log_handle->verbose(m_log_handle, text);
+                break;
+            case LogLevel::Log:
+                m_log_handle->log(m_log_handle, text);
+                break;
+            case LogLevel::Info:
+                m_log_handle->info(m_log_handle, text);
+                break;
+            case LogLevel::Warn:
+                m_log_handle->warn(m_log_handle, text);
+                break;
+            case LogLevel::Error:
+                m_log_handle->error(m_log_handle, text);
+                break;
+        }
     }
 
-private:
     LOG_HANDLE* m_log_handle = nullptr;
+    std::atomic<LogLevel> m_min_level{LogLevel::Verbose};
 
     // ログのエンコードが Shift_JIS なのでデフォルトのコードページは CP_ACP (ANSIコードページ) にする
     [[nodiscard]] static std::wstring toWideString(std::string_view str, uint32_t code_page = CP_ACP)
@@ -116,6 +157,9 @@ private:
 
         return result;
     }
+
+    // 他のメンバより先に破棄されるよう最後に宣言する
+    async_log::AsyncLogger m_logger;
 };
 
 #endif  // LOGGER_WRAPPER_H
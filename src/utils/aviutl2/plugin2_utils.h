@@ -4,13 +4,39 @@
 #include <concepts>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <system_error>
 
 #include "alias_parser.h"
 #include "aviutl2_sdk.h"
+#include "item_value.h"
+#include "utils/common/frame_profiler.h"
 #include "utils/common/str_conv.h"
 
 namespace plugin2_utils {
 
+/// @brief setObjectItemValue() の "<エフェクト名>:<インデックス>" を組み立て済みの文字列で指定する版
+/// @param effect_with_index "<エフェクト名>:<インデックス>" の文字列
+template <typename T>
+void setObjectItemValue(const EDIT_SECTION* edit, const OBJECT_HANDLE object, const wchar_t* effect_name, const wchar_t* effect_with_index, const wchar_t* item_name, const T& value, T default_value, const uint32_t section_index = 0, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
+{
+    if (!effect_with_index || !item_name) return;
+    if (edit->count_object_effect(object, effect_name) <= 0) return;
+
+    auto ret_ptr = edit->get_object_item_value(object, effect_with_index, item_name);
+    if (!ret_ptr) {
+        return;
+    }
+
+    ValueBuffer value_buf;
+    std::string_view set_value_str = formatItemValue(value_buf, value, default_value, base, fmt);
+
+    // key=value1,valu2,value3... のとき、引数 index に基づいていずれかの値のみを置き換える
+    std::string& replaced_str = itemLineBuffer();
+    alias_parser::appendReplacedNthToken(replaced_str, ret_ptr, section_index, set_value_str);
+    edit->set_object_item_value(object, effect_with_index, item_name, replaced_str.c_str());
+}
+
 /// @brief get_object_item_value() で値を設定する際のデフォルト値やセクションの指定、基数変換などできるようにしたもの。設定値は内部で文字列に変換してから設定する。
 /// @tparam T セットする値の型
 /// @param edit 編集セクション構造体
@@ -26,29 +52,24 @@ namespace plugin2_utils {
 template <typename T>
 void setObjectItemValue(const EDIT_SECTION* edit, const OBJECT_HANDLE object, const wchar_t* effect_name, const uint32_t effect_index, const wchar_t* item_name, const T& value, T default_value, const uint32_t section_index = 0, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
 {
-    if (edit->count_object_effect(object, effect_name) <= 0) return;
-
     std::wstring effect_with_index = std::wstring{effect_name} + L":" + str_conv::intToWchars(effect_index, "0");
-    auto ret_ptr                   = edit->get_object_item_value(object, effect_with_index.c_str(), item_name);
-    if (!ret_ptr) {
-        return;
-    }
-    std::string ret_str = ret_ptr;
+    setObjectItemValue(edit, object, effect_name, effect_with_index.c_str(), item_name, value, default_value, section_index, base, fmt);
+}
+
+/// @brief getObjectItemValue() の "<エフェクト名>:<インデックス>" を組み立て済みの文字列で指定する版
+/// @param effect_with_index "<エフェクト名>:<インデックス>" の文字列
+template <typename T>
+T getObjectItemValue(const EDIT_SECTION* edit, const OBJECT_HANDLE object, const wchar_t* effect_name, const wchar_t* effect_with_index, const wchar_t* item_name, const T default_value, const uint32_t section_index = 0, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
+{
+    if (!effect_with_index || !item_name) return default_value;
+    if (edit->count_object_effect(object, effect_name) <= 0) return default_value;
 
-    std::string set_value_str{};
-    if constexpr (std::integral<T>) {
-        set_value_str = str_conv::intToChars(value, str_conv::intToChars(default_value, "0", base), base);
-    } else if constexpr (std::floating_point<T>) {
-        set_value_str = str_conv::floatingPointToChars(value, str_conv::floatingPointToChars(default_value, "0", fmt), fmt);
-    } else if constexpr (std::constructible_from<T, const char*>) {
-        set_value_str = std::string{value};
-    } else {
-        set_value_str = default_value;
+    auto ret_ptr = edit->get_object_item_value(object, effect_with_index, item_name);
+    if (!ret_ptr) {
+        return default_value;
     }
 
-    // key=value1,valu2,value3... のとき、引数 index に基づいていずれかの値のみを置き換える
-    std::string replaced_str = alias_parser::replaceNthToken(ret_str, section_index, set_value_str);
-    edit->set_object_item_value(object, effect_with_index.c_str(), item_name, replaced_str.c_str());
+    return parseItemValue(alias_parser::getNthTokenView(ret_ptr, section_index), default_value, base, fmt);
 }
 
 /// @brief get_object_item_value() で値を取得する際のデフォルト値やセクションの指定、基数変換などできるようにしたもの。設定値は内部でデフォルト値の型 T に変換してから返す。
@@ -66,24 +87,8 @@ void setObjectItemValue(const EDIT_SECTION* edit, const OBJECT_HANDLE object, co
 template <typename T>
 T getObjectItemValue(const EDIT_SECTION* edit, const OBJECT_HANDLE object, const wchar_t* effect_name, const uint32_t effect_index, const wchar_t* item_name, const T default_value, const uint32_t section_index = 0, const int32_t base = 10, const std::chars_format fmt = std::chars_format::general)
 {
-    if (edit->count_object_effect(object, effect_name) <= 0) return default_value;
-
     std::wstring effect_with_index = std::wstring{effect_name} + L":" + str_conv::intToWchars(effect_index, "0");
-    auto ret_ptr                   = edit->get_object_item_value(object, effect_with_index.c_str(), item_name);
-    if (!ret_ptr) {
-        return default_value;
-    }
-
-    std::string ret_str = ret_ptr;
-    ret_str             = alias_parser::getNthToken(ret_str, section_index);
-
-    if constexpr (std::integral<T>) {
-        return str_conv::charsToInt(ret_str, default_value, base);
-    } else if constexpr (std::floating_point<T>) {
-        return str_conv::charsToFloatingPoint(ret_str, default_value, fmt);
-    } else if constexpr (std::constructible_from<T, const char*>) {
-        return std::string{ret_str};
-    }
+    return getObjectItemValue(edit, object, effect_name, effect_with_index.c_str(), item_name, default_value, section_index, base, fmt);
 }
 
 /// @brief キャプチャ付きのラムダ式を call_edit_section_param() に渡すためのヘルパー関数
@@ -95,6 +100,7 @@ template <typename F>
 bool call_edit_lambda(bool (*api_func)(void*, void (*)(void*, EDIT_SECTION*)), F&& lambda)
 {
     auto callback_shim = [](void* param, EDIT_SECTION* edit) {
+        frame_profiler::ScopedZone zone{"call_edit_section_param"};
         auto* func = static_cast<std::remove_reference_t<F>*>(param);
         (*func)(edit);
     };
@@ -0,0 +1,97 @@
+#ifndef TRANSLATION_CACHE_H
+#define TRANSLATION_CACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "utils/common/str_conv.h"
+
+namespace aul2 {
+
+/// @brief 翻訳した文字列を UTF-8 に変換して保持するキャッシュ
+/// @note 初回の呼び出しでのみ translate() と変換を行い、以降はメモリの確保なしで同じポインタを返す。
+///       ラベルの "###ID" や書式のように前後に付ける文字列も含めて保持する。GUI スレッドからのみ使うこと
+class TranslationCache {
+public:
+    /// @brief key の翻訳を返す関数。翻訳できない場合は nullptr
+    using TranslateFunction = const wchar_t* (*)(const wchar_t* key);
+
+    explicit TranslationCache(TranslateFunction translate)
+        : m_translate{translate}
+    {
+    }
+
+    /// @brief prefix + 翻訳した key + suffix を返す
+    /// @return clear() されるまで有効なポインタ
+    const char* get(const std::string_view prefix, const wchar_t* key, const std::string_view suffix)
+    {
+        const KeyView view{prefix, key, suffix};
+        if (auto it = m_entries.find(view); it != m_entries.end()) return it->second.c_str();
+
+        std::string text{prefix};
+        if (const wchar_t* translated = m_translate(key)) text += str_conv::wideCharToMultiByte(translated);
+        text += suffix;
+        auto [it, inserted] = m_entries.emplace(Key{std::string{prefix}, std::wstring{key}, std::string{suffix}}, std::move(text));
+        return it->second.c_str();
+    }
+
+    /// @brief 言語が変わっていればキャッシュを破棄する。フレームの先頭で呼ぶ
+    /// @note 前のフレームで返したポインタは無効になる
+    void refresh()
+    {
+        const wchar_t* probe = m_translate(PROBE_KEY);
+        if (!probe || m_probe == probe) return;
+        m_probe = probe;
+        m_entries.clear();
+    }
+
+    void clear() { m_entries.clear(); }
+
+    [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+
+private:
+    // 言語の変更を検出するために翻訳を比べるキー
+    static constexpr const wchar_t* PROBE_KEY = L"表示";
+
+    struct KeyView {
+        std::string_view prefix;
+        std::wstring_view key;
+        std::string_view suffix;
+
+        bool operator==(const KeyView&) const = default;
+    };
+    struct Key {
+        std::string prefix;
+        std::wstring key;
+        std::string suffix;
+
+        operator KeyView() const noexcept { return {prefix, key, suffix}; }
+    };
+    // 検索時に Key を作らないよう、KeyView で検索できるようにする
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const KeyView& view) const noexcept
+        {
+            size_t hash = std::hash<std::wstring_view>{}(view.key);
+            hash ^= std::hash<std::string_view>{}(view.prefix) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<std::string_view>{}(view.suffix) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+        size_t operator()(const Key& key) const noexcept { return (*this)(static_cast<KeyView>(key)); }
+    };
+    struct KeyEqual {
+        using is_transparent = void;
+        bool operator()(const KeyView& a, const KeyView& b) const noexcept { return a == b; }
+    };
+
+    std::unordered_map<Key, std::string, KeyHash, KeyEqual> m_entries;  // ノードベースのため、追加しても既存の文字列は移動しない
+    TranslateFunction m_translate;
+    std::wstring m_probe;
+};
+
+}  // namespace aul2
+
+#endif  // !TRANSLATION_CACHE_H
@@ -0,0 +1,242 @@
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include "mpsc_queue.h"
+
+/// @brief ログを呼び出し元のスレッドで整形し、出力はバックグラウンドのスレッドで行う仕組み
+/// @note 出力先 (Sink) は関数で受け取るため、プラットフォームに依存しない
+namespace async_log {
+
+enum class LogLevel : uint8_t {
+    Verbose = 0,
+    Log,
+    Info,
+    Warn,
+    Error,
+};
+
+// コンパイル時に除外するレベル。LOG_MIN_LEVEL 未満のログは整形のコードも生成しない
+#ifdef LOG_MIN_LEVEL
+inline constexpr LogLevel COMPILE_TIME_MIN_LEVEL = static_cast<LogLevel>(LOG_MIN_LEVEL);
+#else
+inline constexpr LogLevel COMPILE_TIME_MIN_LEVEL = LogLevel::Verbose;
+#endif
+
+struct LogRecord {
+    LogLevel level = LogLevel::Log;
+    bool is_wide   = false;
+    std::string text;        // is_wide が false の場合
+    std::wstring wide_text;  // is_wide が true の場合
+
+    bool sameMessage(const LogRecord& other) const noexcept
+    {
+        return level == other.level && is_wide == other.is_wide && text == other.text && wide_text == other.wide_text;
+    }
+};
+
+/// @brief 整形済みのレコードを作る
+template <typename... Args>
+LogRecord formatRecord(const LogLevel level, const std::string_view fmt, const Args&... args)
+{
+    return {.level = level, .is_wide = false, .text = std::vformat(fmt, std::make_format_args(args...))};
+}
+
+template <typename... Args>
+LogRecord formatRecord(const LogLevel level, const std::wstring_view fmt, const Args&... args)
+{
+    return {.level = level, .is_wide = true, .wide_text = std::vformat(fmt, std::make_wformat_args(args...))};
+}
+
+/// @brief 同じメッセージが続く場合はまとめ、1 秒あたりの出力数を制限する
+/// @note 時刻は引数で受け取るため、実際の時計に依存せずに動作を確かめられる
+class RateLimiter {
+public:
+    using Clock     = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Sink      = std::function<void(const LogRecord&)>;
+
+    static constexpr uint32_t DEFAULT_MAX_PER_SECOND = 100;
+    static constexpr std::chrono::seconds WINDOW{1};
+
+    explicit RateLimiter(const uint32_t max_per_second = DEFAULT_MAX_PER_SECOND)
+        : m_max_per_second{max_per_second}
+    {
+    }
+
+    /// @brief レコードを出力するか判断し、出力する場合は sink に渡す
+    void process(LogRecord record, const TimePoint now, const Sink& sink)
+    {
+        if (m_last && m_last->sameMessage(record)) {
+            ++m_repeat_count;
+            return;
+        }
+        flushRepeats(sink);
+
+        if (now - m_window_start >= WINDOW) {
+            flushDropped(sink);
+            m_window_start = now;
+            m_window_count = 0;
+        }
+        if (m_window_count >= m_max_per_second) {
+            ++m_dropped_count;
+            return;
+        }
+        ++m_window_count;
+        sink(record);
+        m_last = std::move(record);
+    }
+
+    /// @brief 前回から WINDOW 以上経っていれば、まとめた繰り返しと制限で捨てた数を出力する。定期的に呼ぶ
+    void flush(const TimePoint now, const Sink& sink)
+    {
+        if (now - m_last_flush < WINDOW) return;
+        m_last_flush = now;
+        flushRepeats(sink);
+        if (now - m_window_start >= WINDOW) flushDropped(sink);
+    }
+
+    /// @brief まとめた繰り返しと制限で捨てた数をすぐに出力する
+    void flushAll(const Sink& sink)
+    {
+        flushRepeats(sink);
+        flushDropped(sink);
+    }
+
+private:
+    void flushRepeats(const Sink& sink)
+    {
+        if (m_repeat_count == 0) return;
+        sink(formatRecord(m_last->level, "last message repeated {} times", m_repeat_count));
+        m_repeat_count = 0;
+    }
+
+    void flushDropped(const Sink& sink)
+    {
+        if (m_dropped_count == 0) return;
+        sink(formatRecord(LogLevel::Warn, "{} log messages were dropped by the rate limit", m_dropped_count));
+        m_dropped_count = 0;
+    }
+
+    uint32_t m_max_per_second;
+    std::optional<LogRecord> m_last;  // 最後に出力したレコード
+    uint64_t m_repeat_count  = 0;
+    uint64_t m_dropped_count = 0;
+    TimePoint m_window_start{};
+    TimePoint m_last_flush{};
+    uint32_t m_window_count = 0;
+};
+
+/// @brief MpscQueue に積んだレコードをバックグラウンドのスレッドで RateLimiter を通して出力する
+class AsyncLogger {
+public:
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};  // 繰り返しのまとめを出力する間隔
+
+    using Sink = RateLimiter::Sink;
+
+    AsyncLogger() = default;
+    ~AsyncLogger() { stop(); }
+
+    AsyncLogger(const AsyncLogger&)            = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    /// @brief 出力先を設定してスレッドを開始する。開始済みの場合は停止してから開始する
+    void start(Sink sink, const uint32_t max_per_second = RateLimiter::DEFAULT_MAX_PER_SECOND)
+    {
+        stop();
+        m_sink    = std::move(sink);
+        m_limiter = RateLimiter{max_per_second};
+        m_thread  = std::jthread([this](std::stop_token stop_token) { run(stop_token); });
+    }
+
+    /// @brief 積まれているレコードをすべて出力してからスレッドを停止する
+    void stop()
+    {
+        if (!m_thread.joinable()) return;
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    [[nodiscard]] bool isRunning() const noexcept { return m_thread.joinable(); }
+
+    /// @brief レコードを積む。どのスレッドから呼んでもよい
+    void push(LogRecord record)
+    {
+        m_queue.push(std::move(record));
+        m_pushed_count.fetch_add(1);
+        if (m_is_waiting.load()) {
+            // 待機に入る途中のスレッドに通知を取りこぼさせないよう、ロックを取ってから通知する
+            { std::lock_guard lock(m_mutex); }
+            m_cv.notify_one();
+        }
+    }
+
+    /// @brief push() 済みのレコードがすべて出力されるまで待つ
+    void flush()
+    {
+        const uint64_t target = m_pushed_count.load(std::memory_order_acquire);
+        uint64_t processed    = m_processed_count.load(std::memory_order_acquire);
+        while (processed < target && isRunning()) {
+            m_cv.notify_one();
+            m_processed_count.wait(processed, std::memory_order_acquire);
+            processed = m_processed_count.load(std::memory_order_acquire);
+        }
+    }
+
+private:
+    void run(std::stop_token stop_token)
+    {
+        while (true) {
+            drain();
+            m_limiter.flush(RateLimiter::Clock::now(), m_sink);
+            if (stop_token.stop_requested()) break;
+
+            // 繰り返しのまとめを出力するため、積まれなくても FLUSH_INTERVAL ごとに起きる
+            std::unique_lock lock(m_mutex);
+            m_is_waiting.store(true);
+            const uint64_t processed = m_processed_count.load();
+            m_cv.wait_for(lock, stop_token, FLUSH_INTERVAL, [&] { return m_pushed_count.load() != processed; });
+            m_is_waiting.store(false);
+        }
+        drain();
+        m_limiter.flushAll(m_sink);
+    }
+
+    void drain()
+    {
+        while (auto record = m_queue.pop()) {
+            m_limiter.process(std::move(*record), RateLimiter::Clock::now(), m_sink);
+            m_processed_count.fetch_add(1, std::memory_order_release);
+            m_processed_count.notify_all();
+        }
+    }
+
+    MpscQueue<LogRecord> m_queue;
+    Sink m_sink;
+    RateLimiter m_limiter;
+    std::atomic<uint64_t> m_pushed_count{0};
+    std::atomic<uint64_t> m_processed_count{0};
+    std::atomic<bool> m_is_waiting{false};  // スレッドが通知を待っているか
+    std::mutex m_mutex;
+    std::condition_variable_any m_cv;
+
+    // 他のメンバより先に破棄されるよう最後に宣言する
+    std::jthread m_thread;
+};
+
+}  // namespace async_log
+
+#endif  // !ASYNC_LOG_H
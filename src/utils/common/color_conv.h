@@ -1,6 +1,7 @@
 ﻿#ifndef COLOR_CONV_H
 #define COLOR_CONV_H
 
+#include <cmath>
 #include <cstdint>
 
 namespace color_conv {
@@ -66,6 +67,32 @@ constexpr uint32_t u32Rgba2u32Abgr(const uint32_t rgba)
     return (a << 24) | (b << 16) | (g << 8) | r;
 }
 
+/// @brief sRGB の成分をリニアに変換する
+inline float srgb2Linear(const float x)
+{
+    return x <= 0.04045f ? x / 12.92f : std::pow((x + 0.055f) / 1.055f, 2.4f);
+}
+
+/// @brief リニア sRGB を Oklab に変換する
+/// @note 参考: https://bottosson.github.io/posts/oklab/#converting-from-linear-srgb-to-oklab
+template <typename Vec3>
+Vec3 linear2Oklab(const Vec3& rgb)
+{
+    float l = 0.4122214708f * rgb.x + 0.5363325363f * rgb.y + 0.0514459929f * rgb.z;
+    float m = 0.2119034982f * rgb.x + 0.6806995451f * rgb.y + 0.1073969566f * rgb.z;
+    float s = 0.0883024619f * rgb.x + 0.2817188376f * rgb.y + 0.6299787005f * rgb.z;
+
+    float l_ = std::cbrt(l);
+    float m_ = std::cbrt(m);
+    float s_ = std::cbrt(s);
+
+    return Vec3{
+        0.2104542553f * l_ + 0.7936177850f * m_ - 0.0040720468f * s_,
+        1.9779984951f * l_ - 2.4285922050f * m_ + 0.4505937099f * s_,
+        0.0259040371f * l_ + 0.7827717662f * m_ - 0.8086757660f * s_,
+    };
+}
+
 }  // namespace color_conv
 
 #endif  // !COLOR_CONV_H
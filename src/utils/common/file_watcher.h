@@ -0,0 +1,70 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <cstdint>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+/// @brief ファイルの更新日時とサイズを定期的に調べて変更を検知するクラス
+/// @note 変更の通知を受け取る仕組みに依存しないため、ネットワークドライブ上のファイルにも使える。
+///       poll() を呼んだスレッドでのみ状態を更新するため、1 つのスレッドから呼ぶこと
+class PollingFileWatcher {
+public:
+    PollingFileWatcher() = default;
+
+    explicit PollingFileWatcher(std::vector<std::filesystem::path> paths)
+    {
+        setPaths(std::move(paths));
+    }
+
+    /// @brief 監視するファイルを設定する。現在の状態を基準にする
+    void setPaths(std::vector<std::filesystem::path> paths)
+    {
+        m_paths = std::move(paths);
+        m_stamps.clear();
+        for (const auto& path : m_paths) m_stamps.push_back(stampOf(path));
+    }
+
+    /// @brief 前回の呼び出し (または setPaths()) から変更があったか調べる
+    /// @return いずれかのファイルが作成・削除・変更された場合は true
+    bool poll()
+    {
+        bool is_changed = false;
+        for (size_t i = 0; i < m_paths.size(); ++i) {
+            Stamp stamp = stampOf(m_paths[i]);
+            if (stamp != m_stamps[i]) {
+                m_stamps[i] = stamp;
+                is_changed  = true;
+            }
+        }
+        return is_changed;
+    }
+
+private:
+    struct Stamp {
+        bool exists    = false;
+        uintmax_t size = 0;
+        std::filesystem::file_time_type time{};
+
+        bool operator==(const Stamp&) const = default;
+    };
+
+    static Stamp stampOf(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        Stamp stamp;
+        stamp.size = std::filesystem::file_size(path, ec);
+        if (ec) return {};
+        stamp.time = std::filesystem::last_write_time(path, ec);
+        if (ec) return {};
+        stamp.exists = true;
+        return stamp;
+    }
+
+    std::vector<std::filesystem::path> m_paths;
+    std::vector<Stamp> m_stamps;
+};
+
+#endif  // !FILE_WATCHER_H
@@ -0,0 +1,79 @@
+#ifndef FONT_FILE_H
+#define FONT_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+#include "mapped_file.h"
+
+/// @brief フォントファイル (TrueType / OpenType / TrueType Collection) をコピーせずに扱うための関数とクラス
+namespace font_file {
+
+namespace detail {
+inline uint32_t readU32BE(const std::span<const std::byte> data, const size_t offset) noexcept
+{
+    return (std::to_integer<uint32_t>(data[offset]) << 24) | (std::to_integer<uint32_t>(data[offset + 1]) << 16) |
+           (std::to_integer<uint32_t>(data[offset + 2]) << 8) | std::to_integer<uint32_t>(data[offset + 3]);
+}
+}  // namespace detail
+
+/// @brief フォントファイルに含まれるフェイスの数を返す
+/// @return フォントファイルとして読めない場合は 0。TTC でない場合は 1
+[[nodiscard]] inline uint32_t faceCount(const std::span<const std::byte> data) noexcept
+{
+    // sfnt のテーブルディレクトリ (12 バイト) か TTC のヘッダー (12 バイト + オフセット) が必要
+    if (data.size() < 12) return 0;
+
+    const uint32_t tag = detail::readU32BE(data, 0);
+    if (tag == 0x00010000 || tag == 0x74727565 /* true */ || tag == 0x4F54544F /* OTTO */) return 1;
+    if (tag != 0x74746366 /* ttcf */) return 0;
+
+    const uint32_t num_fonts = detail::readU32BE(data, 8);
+    if (num_fonts == 0 || num_fonts > (data.size() - 12) / 4) return 0;
+    for (uint32_t i = 0; i < num_fonts; ++i) {
+        const uint32_t offset = detail::readU32BE(data, 12 + size_t{i} * 4);
+        if (offset > data.size() - 12) return 0;
+    }
+    return num_fonts;
+}
+
+/// @brief メモリマップしたフォントファイル
+/// @note ImGui にはバッファの所有権を渡さずに bytes() を参照させる (ImFontConfig::FontDataOwnedByAtlas = false)。
+///       動的なフォントアトラスはグリフを使う時にフォントデータを読むため、フォントアトラスより長く保持すること
+class MappedFont {
+public:
+    /// @brief フォントファイルをメモリマップする
+    /// @param face_index TTC の場合に使うフェイスの番号
+    /// @return ファイルを開けない場合、フォントファイルでない場合、face_index がない場合は false
+    bool open(const std::filesystem::path& path, const uint32_t face_index = 0)
+    {
+        close();
+        if (!m_file.open(path)) return false;
+        if (face_index >= faceCount(m_file.bytes())) {
+            m_file.close();
+            return false;
+        }
+        m_face_index = face_index;
+        return true;
+    }
+
+    void close() noexcept
+    {
+        m_file.close();
+        m_face_index = 0;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_file.isOpen(); }
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return m_file.bytes(); }
+    [[nodiscard]] uint32_t faceIndex() const noexcept { return m_face_index; }
+
+private:
+    MappedFile m_file;
+    uint32_t m_face_index = 0;
+};
+
+}  // namespace font_file
+
+#endif  // !FONT_FILE_H
@@ -10,9 +10,11 @@
 #include <dwrite.h>
 #include <wrl/client.h>
 
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string>
-#include <vector>
 
 #include "imgui.h"
 
@@ -20,8 +22,14 @@
 
 using Microsoft::WRL::ComPtr;
 
-// フォント名からフォントのデータを取得する関数
-std::vector<unsigned char> getFontDataByName(const std::wstring& font_name)
+struct SystemFontFile {
+    std::filesystem::path path;
+    uint32_t face_index = 0;  // TTC の場合のフェイスの番号
+};
+
+// フォント名からフォントファイルのパスを取得する関数
+// ファイルは読み込まない。font_file::MappedFont でメモリマップして使う
+std::optional<SystemFontFile> findSystemFontFile(const std::wstring& font_name)
 {
     ComPtr<IDWriteFactory> factory;
     DWriteCreateFactory(DWRITE_FACTORY_TYPE_SHARED, __uuidof(IDWriteFactory), &factory);
@@ -33,7 +41,7 @@ std::vector<unsigned char> getFontDataByName(const std::wstring& font_name)
     BOOL exists;
     collection->FindFamilyName(font_name.c_str(), &index, &exists);
 
-    if (!exists) return {};  // 見つからない場合
+    if (!exists) return std::nullopt;  // 見つからない場合
 
     ComPtr<IDWriteFontFamily> family;
     collection->GetFontFamily(index, &family);
@@ -52,7 +60,7 @@ std::vector<unsigned char> getFontDataByName(const std::wstring& font_name)
     // フォントファイル情報の取得
     UINT32 number_of_files = 0;
     font_face->GetFiles(&number_of_files, nullptr);
-    if (number_of_files == 0) return {};
+    if (number_of_files == 0) return std::nullopt;
 
     ComPtr<IDWriteFontFile> font_file;
     font_face->GetFiles(&number_of_files, &font_file);
@@ -62,33 +70,21 @@ std::vector<unsigned char> getFontDataByName(const std::wstring& font_name)
 
     // ローカルファイル用ローダーか確認
     ComPtr<IDWriteLocalFontFileLoader> local_loader;
-    if (FAILED(loader.As(&local_loader))) return {};
+    if (FAILED(loader.As(&local_loader))) return std::nullopt;
 
     const void* font_file_reference_key;
     UINT32 font_file_reference_key_size;
     font_file->GetReferenceKey(&font_file_reference_key, &font_file_reference_key_size);
 
-    ComPtr<IDWriteFontFileStream> stream;
-    loader->CreateStreamFromKey(
-        font_file_reference_key,
-        font_file_reference_key_size,
-        &stream
-    );
-
-    UINT64 file_size;
-    stream->GetFileSize(&file_size);
-
-    // メモリへの読み込み
-    std::vector<unsigned char> buffer(static_cast<size_t>(file_size));
-    const void* fragment_start;
-    void* context;
-    stream->ReadFileFragment(&fragment_start, 0, file_size, &context);
-
-    memcpy(buffer.data(), fragment_start, buffer.size());
+    // ファイルのパスの取得
+    UINT32 path_length = 0;
+    if (FAILED(local_loader->GetFilePathLengthFromKey(font_file_reference_key, font_file_reference_key_size, &path_length))) return std::nullopt;
 
-    stream->ReleaseFileFragment(context);
+    std::wstring path(path_length + 1, L'\0');
+    if (FAILED(local_loader->GetFilePathFromKey(font_file_reference_key, font_file_reference_key_size, path.data(), path_length + 1))) return std::nullopt;
+    path.resize(path_length);
 
-    return buffer;
+    return SystemFontFile{.path = std::move(path), .face_index = font_face->GetIndex()};
 }
 
 #endif  // !FONT_LOADER_H
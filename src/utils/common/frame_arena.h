@@ -0,0 +1,110 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+/// @brief 1 フレームの間だけ使う一時的なオブジェクトのためのアリーナ
+/// @note フレームの先頭 (App::renderFrame()) で reset() し、確保はポインタを進めるだけで行う。
+///       確保した領域はフレームをまたいで保持しないこと。GUI スレッドからのみ使う
+namespace frame_arena {
+
+class Arena final : public std::pmr::memory_resource {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+    explicit Arena(const size_t capacity = DEFAULT_CAPACITY)
+        : m_buffer{std::make_unique<std::byte[]>(capacity)}
+        , m_capacity{capacity}
+    {
+    }
+
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override { releaseOverflow(); }
+
+    /// @brief すべての領域を解放する
+    /// @note 前のフレームで容量が足りなかった場合は、そのフレームの使用量が収まるように広げる
+    void reset()
+    {
+        releaseOverflow();
+        if (m_frame_bytes > m_capacity) {
+            m_capacity = std::bit_ceil(m_frame_bytes);
+            m_buffer   = std::make_unique<std::byte[]>(m_capacity);
+        }
+        m_peak_bytes  = std::max(m_peak_bytes, m_frame_bytes);
+        m_offset      = 0;
+        m_frame_bytes = 0;
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] size_t frameBytes() const noexcept { return m_frame_bytes; }  // このフレームで確保した量
+    [[nodiscard]] size_t peakBytes() const noexcept { return std::max(m_peak_bytes, m_frame_bytes); }
+    [[nodiscard]] size_t overflowCount() const noexcept { return m_overflow.size(); }  // このフレームで容量を超えて確保した数
+
+private:
+    struct OverflowBlock {
+        void* pointer;
+        size_t alignment;
+    };
+
+    void* do_allocate(const size_t bytes, const size_t alignment) override
+    {
+        m_frame_bytes += bytes;
+
+        void* pointer    = m_buffer.get() + m_offset;
+        size_t available = m_capacity - m_offset;
+        if (std::align(alignment, bytes, pointer, available)) {
+            m_offset = m_capacity - available + bytes;
+            return pointer;
+        }
+
+        // 容量を超えた分はヒープから確保し、reset() で解放する
+        m_overflow.reserve(m_overflow.size() + 1);
+        void* block = ::operator new(bytes, std::align_val_t{alignment});
+        m_overflow.push_back({block, alignment});
+        return block;
+    }
+
+    // 個別には解放せず、reset() でまとめて解放する
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void releaseOverflow() noexcept
+    {
+        for (const auto& block : m_overflow) ::operator delete(block.pointer, std::align_val_t{block.alignment});
+        m_overflow.clear();
+    }
+
+    std::unique_ptr<std::byte[]> m_buffer;
+    size_t m_capacity    = 0;
+    size_t m_offset      = 0;
+    size_t m_frame_bytes = 0;
+    size_t m_peak_bytes  = 0;
+    std::vector<OverflowBlock> m_overflow;
+};
+
+/// @brief GUI スレッドのアリーナ
+inline Arena& get()
+{
+    static Arena arena;
+    return arena;
+}
+
+// アリーナから確保するコンテナ。frame_arena::String s{&frame_arena::get()} のように使う
+using String = std::pmr::string;
+
+template <typename T>
+using Vector = std::pmr::vector<T>;
+
+}  // namespace frame_arena
+
+#endif  // !FRAME_ARENA_H
@@ -0,0 +1,164 @@
+#include "frame_profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "json.hpp"
+
+namespace frame_profiler {
+
+namespace {
+
+// 登録したリングバッファはスレッドの終了後も残し、記録を読めるようにする
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ZoneRing>> rings;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+// nowTicks() を ns に換算するための基準。最初に記録したスレッドを登録する時に決める
+struct TickAnchor {
+    int64_t ticks;
+    int64_t ns;
+};
+
+const TickAnchor& tickAnchor()
+{
+    static const TickAnchor anchor{nowTicks(), nowNs()};
+    return anchor;
+}
+
+// 基準からの経過時間で 1 tick あたりの ns を求める。経過時間が長いほど正確になる
+double nsPerTick()
+{
+#ifdef FRAME_PROFILER_USE_TSC
+    const TickAnchor& anchor = tickAnchor();
+    const int64_t ticks      = nowTicks() - anchor.ticks;
+    const int64_t ns         = nowNs() - anchor.ns;
+    return ticks > 0 && ns > 0 ? static_cast<double>(ns) / static_cast<double>(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+// ソート済みの所要時間から最近傍順位法でパーセンタイルを求める
+double percentileMs(const std::vector<int64_t>& sorted_ns, const double percentile)
+{
+    const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted_ns.size())));
+    return static_cast<double>(sorted_ns[std::clamp<size_t>(rank, 1, sorted_ns.size()) - 1]) / 1e6;
+}
+
+}  // namespace
+
+void ZoneRing::collect(std::vector<ZoneEvent>& out, const int64_t since_ticks) const
+{
+    const uint64_t head  = m_head.load(std::memory_order_acquire);
+    const uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+    for (uint64_t i = first; i < head; ++i) {
+        const Slot& slot        = m_slots[i & (CAPACITY - 1)];
+        const uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != i * 2 + 2) continue;  // 読んでいる間に上書きされた
+
+        ZoneEvent event{
+            .name      = slot.name.load(std::memory_order_relaxed),
+            .start_ns  = slot.start_ticks.load(std::memory_order_relaxed),
+            .end_ns    = slot.end_ticks.load(std::memory_order_relaxed),
+            .thread_id = m_thread_id,
+        };
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        if (event.end_ns >= since_ticks) out.push_back(event);
+    }
+}
+
+namespace detail {
+
+ZoneRing& registerThreadRing()
+{
+    tickAnchor();
+
+    Registry& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    reg.rings.push_back(std::make_unique<ZoneRing>(static_cast<uint32_t>(reg.rings.size())));
+    return *reg.rings.back();
+}
+
+}  // namespace detail
+
+std::vector<ZoneEvent> collect(const int64_t since_ns)
+{
+    // リングバッファには nowTicks() の値で記録されているため、ns に換算する
+    const TickAnchor& anchor  = tickAnchor();
+    const double ns_per_tick  = nsPerTick();
+    const auto to_ns          = [&](const int64_t ticks) { return anchor.ns + static_cast<int64_t>(static_cast<double>(ticks - anchor.ticks) * ns_per_tick); };
+    const int64_t since_ticks = since_ns == INT64_MIN ? INT64_MIN : anchor.ticks + static_cast<int64_t>(static_cast<double>(since_ns - anchor.ns) / ns_per_tick);
+
+    std::vector<ZoneEvent> events;
+    {
+        Registry& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        for (const auto& ring : reg.rings) ring->collect(events, since_ticks);
+    }
+    for (auto& event : events) {
+        event.start_ns = to_ns(event.start_ns);
+        event.end_ns   = to_ns(event.end_ns);
+    }
+    std::sort(events.begin(), events.end(), [](const ZoneEvent& a, const ZoneEvent& b) { return a.start_ns < b.start_ns; });
+    return events;
+}
+
+std::vector<ZoneStats> summarize(const std::span<const ZoneEvent> events)
+{
+    // 同じ名前でも翻訳単位ごとにポインタが異なる場合があるため、文字列で分類する
+    std::map<std::string_view, std::vector<int64_t>> durations;
+    for (const auto& event : events) durations[event.name].push_back(event.end_ns - event.start_ns);
+
+    std::vector<ZoneStats> stats;
+    stats.reserve(durations.size());
+    for (auto& [name, values] : durations) {
+        std::sort(values.begin(), values.end());
+        stats.push_back({
+            .name   = name,
+            .count  = values.size(),
+            .p50_ms = percentileMs(values, 50.0),
+            .p95_ms = percentileMs(values, 95.0),
+            .p99_ms = percentileMs(values, 99.0),
+            .max_ms = static_cast<double>(values.back()) / 1e6,
+        });
+    }
+    return stats;
+}
+
+void writeChromeTrace(std::ostream& os, const std::span<const ZoneEvent> events)
+{
+    // 時刻はマイクロ秒。最初の区間の開始を 0 にする
+    const int64_t origin_ns = events.empty() ? 0 : events.front().start_ns;
+
+    nlohmann::ordered_json trace_events = nlohmann::ordered_json::array();
+    for (const auto& event : events) {
+        trace_events.push_back({
+            {"name", event.name},
+            {"ph", "X"},
+            {"ts", static_cast<double>(event.start_ns - origin_ns) / 1e3},
+            {"dur", static_cast<double>(event.end_ns - event.start_ns) / 1e3},
+            {"pid", 1},
+            {"tid", event.thread_id},
+        });
+    }
+
+    nlohmann::ordered_json json;
+    json["traceEvents"]     = std::move(trace_events);
+    json["displayTimeUnit"] = "ms";
+    os << json.dump();
+}
+
+}  // namespace frame_profiler
@@ -0,0 +1,165 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FRAME_PROFILER_USE_TSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+/// @brief 処理ごとの時間を計測するプロファイラ
+/// @note ScopedZone で囲んだ区間をスレッドごとのリングバッファに記録する。記録はロックを取らず、
+///       無効の間は時刻も取得しない。記録した区間は collect() で取り出し、Chrome の trace_event 形式で書き出せる
+namespace frame_profiler {
+
+struct ZoneEvent {
+    const char* name   = nullptr;  // 静的な文字列 (文字列リテラル)
+    int64_t start_ns   = 0;        // steady_clock の時刻 [ns]
+    int64_t end_ns     = 0;        // steady_clock の時刻 [ns]
+    uint32_t thread_id = 0;        // 記録したスレッドの番号 (最初に記録した順)
+};
+
+struct ZoneStats {
+    std::string_view name;
+    size_t count  = 0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+/// @brief 1 つのスレッドが書き込み、任意のスレッドが読み込むリングバッファ
+/// @note 満杯になると古いものから上書きする。読み込み中に上書きされた要素はスロットごとのシーケンス番号で検出して捨てる
+class ZoneRing {
+public:
+    static constexpr size_t CAPACITY = 4096;  // 2 のべき乗
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0);
+
+    explicit ZoneRing(const uint32_t thread_id)
+        : m_thread_id{thread_id}
+    {
+    }
+
+    /// @brief 区間を記録する。所有するスレッドからのみ呼ぶこと
+    /// @param start_ticks, end_ticks nowTicks() の値
+    void push(const char* name, const int64_t start_ticks, const int64_t end_ticks) noexcept
+    {
+        const uint64_t head = m_head.load(std::memory_order_relaxed);
+        Slot& slot          = m_slots[head & (CAPACITY - 1)];
+        slot.sequence.store(head * 2 + 1, std::memory_order_relaxed);  // 書き込み中
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start_ticks.store(start_ticks, std::memory_order_relaxed);
+        slot.end_ticks.store(end_ticks, std::memory_order_relaxed);
+        slot.sequence.store(head * 2 + 2, std::memory_order_release);
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /// @brief 記録されている区間のうち、since_ticks 以降に終了したものを out に追加する
+    /// @note 時刻は nowTicks() の値のまま追加する
+    void collect(std::vector<ZoneEvent>& out, int64_t since_ticks) const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 偶数なら書き込み済み。(書き込んだ位置 + 1) * 2
+        std::atomic<const char*> name{nullptr};
+        std::atomic<int64_t> start_ticks{0};
+        std::atomic<int64_t> end_ticks{0};
+    };
+
+    uint32_t m_thread_id;
+    std::atomic<uint64_t> m_head{0};  // 次に書き込む位置 (書き込んだ総数)
+    std::array<Slot, CAPACITY> m_slots;
+};
+
+namespace detail {
+inline std::atomic<bool> g_is_enabled{false};
+
+/// @brief 呼び出したスレッドのリングバッファを登録する
+ZoneRing& registerThreadRing();
+
+// 区間ごとに関数を呼ばないよう、登録したリングバッファをヘッダーでキャッシュする
+inline constinit thread_local ZoneRing* t_ring = nullptr;
+
+/// @brief 呼び出したスレッドのリングバッファ。初回の呼び出しで登録する
+inline ZoneRing& threadRing()
+{
+    ZoneRing* ring = t_ring;
+    if (!ring) [[unlikely]] {
+        ring   = &registerThreadRing();
+        t_ring = ring;
+    }
+    return *ring;
+}
+}  // namespace detail
+
+inline void setEnabled(const bool is_enabled) noexcept { detail::g_is_enabled.store(is_enabled, std::memory_order_relaxed); }
+[[nodiscard]] inline bool isEnabled() noexcept { return detail::g_is_enabled.load(std::memory_order_relaxed); }
+
+[[nodiscard]] inline int64_t nowNs() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief 区間の記録に使う時刻
+/// @note x64 では steady_clock (QueryPerformanceCounter など) より安い TSC を読み、collect() で ns に換算する。
+///       それ以外では nowNs() と同じ
+[[nodiscard]] inline int64_t nowTicks() noexcept
+{
+#ifdef FRAME_PROFILER_USE_TSC
+    return static_cast<int64_t>(__rdtsc());
+#else
+    return nowNs();
+#endif
+}
+
+/// @brief スコープの開始から終了までを 1 つの区間として記録する
+/// @param name 区間の名前。記録したものは後から参照するため、静的な文字列を渡すこと
+class ScopedZone {
+public:
+    explicit ScopedZone(const char* name) noexcept
+        : m_name{isEnabled() ? name : nullptr}
+        , m_start_ticks{m_name ? nowTicks() : 0}
+    {
+    }
+
+    ~ScopedZone()
+    {
+        if (m_name) detail::threadRing().push(m_name, m_start_ticks, nowTicks());
+    }
+
+    ScopedZone(const ScopedZone&)            = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+    const char* m_name;
+    int64_t m_start_ticks;
+};
+
+/// @brief すべてのスレッドで記録された区間のうち、since_ns 以降に終了したものを開始時刻順に取り出す
+/// @note 記録を消さないため、何度呼んでもよい
+[[nodiscard]] std::vector<ZoneEvent> collect(int64_t since_ns = INT64_MIN);
+
+/// @brief 区間の名前ごとに所要時間のパーセンタイルを求める
+/// @return 名前順
+[[nodiscard]] std::vector<ZoneStats> summarize(std::span<const ZoneEvent> events);
+
+/// @brief Chrome の trace_event 形式 (chrome://tracing や Perfetto で開ける JSON) で書き出す
+void writeChromeTrace(std::ostream& os, std::span<const ZoneEvent> events);
+
+}  // namespace frame_profiler
+
+#endif  // !FRAME_PROFILER_H
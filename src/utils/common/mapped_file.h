@@ -0,0 +1,117 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#ifdef _WIN32
+// clang-format off
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+// clang-format on
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// @brief 読み取り専用でメモリマップしたファイル
+/// @note ファイルの内容はコピーせず、data() が指す領域はこのオブジェクトが破棄されるまで有効
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    /// @brief ファイルをメモリマップする。開いていたファイルは閉じられる
+    /// @return 失敗した場合、または空のファイルの場合は false
+    bool open(const std::filesystem::path& path)
+    {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        ::CloseHandle(file);  // マッピングが参照を保持するため閉じてよい
+        if (!mapping) return false;
+
+        void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);  // ビューが参照を保持するため閉じてよい
+        if (!view) return false;
+
+        m_data = static_cast<const std::byte*>(view);
+        m_size = static_cast<size_t>(size.QuadPart);
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (view == MAP_FAILED) return false;
+
+        m_data = static_cast<const std::byte*>(view);
+        m_size = static_cast<size_t>(st.st_size);
+#endif
+        return true;
+    }
+
+    void close() noexcept
+    {
+        if (!m_data) return;
+#ifdef _WIN32
+        ::UnmapViewOfFile(m_data);
+#else
+        ::munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_data != nullptr; }
+    [[nodiscard]] const std::byte* data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept { return {m_data, m_size}; }
+
+private:
+    const std::byte* m_data = nullptr;
+    size_t m_size           = 0;
+
+    void swap(MappedFile& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+};
+
+#endif  // !MAPPED_FILE_H
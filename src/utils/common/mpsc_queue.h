@@ -0,0 +1,84 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/// @brief 複数のスレッドが push() し、1 つのスレッドが pop() する連結リストのキュー
+/// @note D. Vyukov の intrusive MPSC キュー。push() はロックを取らず、待つこともない。
+///       番兵の要素を持つため、T はデフォルト構築できること
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() = default;
+    ~MpscQueue()
+    {
+        while (pop()) {
+        }
+    }
+
+    MpscQueue(const MpscQueue&)            = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value)
+    {
+        Node* node  = new Node;
+        node->value = std::move(value);
+        pushNode(node);
+    }
+
+    /// @brief 先頭の要素を取り出す。消費するスレッドからのみ呼ぶこと
+    /// @return 空の場合、または他のスレッドが push() の途中の場合は std::nullopt
+    std::optional<T> pop()
+    {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (!next) return std::nullopt;
+            m_tail = next;
+            tail   = next;
+            next   = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_tail = next;
+            return takeValue(tail);
+        }
+
+        // 最後の要素を取り出すため、番兵を後ろに付ける
+        if (tail != m_head.load(std::memory_order_acquire)) return std::nullopt;
+        pushNode(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            return takeValue(tail);
+        }
+        return std::nullopt;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void pushNode(Node* node) noexcept
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    static T takeValue(Node* node)
+    {
+        T value = std::move(node->value);
+        delete node;
+        return value;
+    }
+
+    Node m_stub;
+    std::atomic<Node*> m_head{&m_stub};  // 最後に追加した要素
+    Node* m_tail = &m_stub;              // 次に取り出す要素
+};
+
+#endif  // !MPSC_QUEUE_H
@@ -8,22 +8,99 @@
 #include <string_view>
 #include <system_error>
 
+#ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#endif
 
 namespace str_conv {
 
+#ifdef _WIN32
+inline constexpr uint32_t CODE_PAGE_UTF8 = CP_UTF8;
+#else
+// Windows 以外では UTF-8 と wchar_t (UTF-32) の変換のみ行う。code_page は無視する
+inline constexpr uint32_t CODE_PAGE_UTF8 = 65001;
+
+namespace detail {
+/// @brief UTF-8 を 1 文字読み、コードポイントを返す。不正な並びの場合は U+FFFD を返し 1 バイト進める
+inline char32_t decodeUtf8(std::string_view str, size_t& pos) noexcept
+{
+    const auto byte_at = [&](const size_t i) { return static_cast<unsigned char>(str[i]); };
+    const unsigned char lead = byte_at(pos);
+
+    size_t length     = 0;
+    char32_t code     = 0;
+    char32_t min_code = 0;
+    if (lead < 0x80) {
+        ++pos;
+        return lead;
+    } else if ((lead & 0xE0) == 0xC0) {
+        length = 2, code = lead & 0x1F, min_code = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3, code = lead & 0x0F, min_code = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4, code = lead & 0x07, min_code = 0x10000;
+    }
+    if (length == 0 || pos + length > str.size()) {
+        ++pos;
+        return U'\uFFFD';
+    }
+    for (size_t i = 1; i < length; ++i) {
+        const unsigned char trail = byte_at(pos + i);
+        if ((trail & 0xC0) != 0x80) {
+            ++pos;
+            return U'\uFFFD';
+        }
+        code = (code << 6) | (trail & 0x3F);
+    }
+    if (code < min_code || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+        ++pos;
+        return U'\uFFFD';
+    }
+    pos += length;
+    return code;
+}
+
+inline void encodeUtf8(std::string& out, const char32_t code)
+{
+    if (code < 0x80) {
+        out += static_cast<char>(code);
+    } else if (code < 0x800) {
+        out += static_cast<char>(0xC0 | (code >> 6));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < 0x10000) {
+        out += static_cast<char>(0xE0 | (code >> 12));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (code >> 18));
+        out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (code & 0x3F));
+    }
+}
+}  // namespace detail
+#endif
+
 /// @brief マルチバイト文字(UTF-8等)をワイド文字(UTF-16)に変換する
 /// @param str マルチバイト文字列
-/// @param code_page コードページ (デフォルト: CP_UTF8)
+/// @param code_page コードページ (デフォルト: UTF-8)
 /// @return 変換されたワイド文字列
-inline std::wstring multiByteToWideChar(std::string_view str, uint32_t code_page = CP_UTF8)
+inline std::wstring multiByteToWideChar(std::string_view str, uint32_t code_page = CODE_PAGE_UTF8)
 {
     if (str.empty()) {
         return {};
     }
 
+#ifndef _WIN32
+    (void)code_page;
+    std::wstring result;
+    result.reserve(str.size());
+    for (size_t pos = 0; pos < str.size();) result += static_cast<wchar_t>(detail::decodeUtf8(str, pos));
+    return result;
+#else
+
     // 必要なバッファサイズを取得 (ヌル文字を含まない)
     int size_needed = ::MultiByteToWideChar(
         code_page,
@@ -48,18 +125,32 @@ inline std::wstring multiByteToWideChar(std::string_view str, uint32_t code_page
         size_needed);
 
     return result;
+#endif
 }
 
 /// @brief ワイド文字(UTF-16)をマルチバイト文字(UTF-8等)に変換する
 /// @param str ワイド文字列
-/// @param code_page コードページ (デフォルト: CP_UTF8)
+/// @param code_page コードページ (デフォルト: UTF-8)
 /// @return 変換されたマルチバイト文字列
-inline std::string wideCharToMultiByte(std::wstring_view str, uint32_t code_page = CP_UTF8)
+inline std::string wideCharToMultiByte(std::wstring_view str, uint32_t code_page = CODE_PAGE_UTF8)
 {
     if (str.empty()) {
         return {};
     }
 
+#ifndef _WIN32
+    // Windows の WC_ERR_INVALID_CHARS と同じく、変換できない文字があれば空にする
+    (void)code_page;
+    std::string result;
+    result.reserve(str.size());
+    for (const wchar_t c : str) {
+        const char32_t code = static_cast<char32_t>(c);
+        if (code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) return {};
+        detail::encodeUtf8(result, code);
+    }
+    return result;
+#else
+
     DWORD flags = 0;
     // UTF-8の場合、WC_ERR_INVALID_CHARS を指定可能 (Windows Vista以降)
     if (code_page == CP_UTF8) {
@@ -94,6 +185,7 @@ inline std::string wideCharToMultiByte(std::wstring_view str, uint32_t code_page
         nullptr);
 
     return result;
+#endif
 }
 
 /// @brief 文字列を整数型に変換する
@@ -1,5 +1,7 @@
 #include "imgui_utils.h"
 
+#include "utils/common/frame_arena.h"
+
 void imgui_utils::alignForWidth(float width, float alignment)
 {
     float avail       = ImGui::GetContentRegionAvail().x;
@@ -132,10 +134,12 @@ bool imgui_utils::pushToggleButton(const char* label, bool* v, const ImVec2& siz
     return pressed;
 }
 
-bool imgui_utils::squareIconButton(const std::string& icon, const std::string& label)
+bool imgui_utils::squareIconButton(const char* icon, const char* label)
 {
-    ImGui::PushStyleVarX(ImGuiStyleVar_FramePadding, (ImGui::GetFrameHeight() - ImGui::CalcTextSize(icon.c_str()).x) * 0.5f);
-    bool f = ImGui::Button((icon + label).data());
+    ImGui::PushStyleVarX(ImGuiStyleVar_FramePadding, (ImGui::GetFrameHeight() - ImGui::CalcTextSize(icon).x) * 0.5f);
+    frame_arena::String text{icon, &frame_arena::get()};
+    text += label;
+    bool f = ImGui::Button(text.c_str());
     ImGui::PopStyleVar();
     return f;
 }
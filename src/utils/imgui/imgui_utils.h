@@ -21,7 +21,7 @@ bool spinInt(const char* label, int* v, int step = 1, int step_fast = 100, ImGui
 bool pushToggleButton(const char* label, bool* v, const ImVec2& size = ImVec2(0, 0));
 
 // アイコンフォトント用の正方形のボタン
-bool squareIconButton(const std::string& icon, const std::string& label);
+bool squareIconButton(const char* icon, const char* label);
 }  // namespace imgui_utils
 
 #endif
@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "alloc_counter.h"
+#include "test_util.h"
+#include "utils/aviutl2/alias_document.h"
+
+namespace {
+constexpr std::string_view ALIAS =
+    "[Object]\r\nlayer=1\r\nframe=0,99,199\r\n"
+    "[Object.0]\r\neffect.name=Gradient\r\nA=1,2,3\r\nB=x\r\nA=dup\r\n"
+    "[Object.1]\r\neffect.name=Other\r\nA=other\r\n"
+    "[Object.2]\r\neffect.name=Gradient\r\nA=second\r\n";
+
+/// @brief 値の取得と、変更した行以外を元のまま書き出すこと
+void testGetSetSerialize()
+{
+    alias_parser::AliasDocument document;
+    document.parse(ALIAS);
+
+    const auto* object = document.findSection("Object");
+    CHECK(object != nullptr && document.getValue(*object, "frame") == "0,99,199");
+    CHECK(document.findSection("Object.3") == nullptr);
+
+    const auto* section = document.findEffectSection("Gradient", 0);
+    if (!CHECK(section != nullptr)) return;
+    CHECK(section->name == "Object.0");
+    CHECK(document.getValue(*section, "B") == "x");
+    CHECK(!document.getValue(*section, "C").has_value());
+
+    // 同じキーが複数ある場合は最初の行
+    CHECK(document.getValue(*section, "A") == "1,2,3");
+
+    CHECK(document.setToken(*section, "A", 1, "20"));
+    CHECK(!document.setValue(*section, "C", "0"));
+    CHECK(document.getValue(*section, "A") == "1,20,3");
+
+    std::string out;
+    document.serialize(out);
+    std::string expected{ALIAS};
+    expected.replace(expected.find("A=1,2,3"), 7, "A=1,20,3");
+    CHECK(out == expected);
+}
+
+/// @brief 同名のエフェクトはインデックスで区別すること
+void testFindEffectSectionByIndex()
+{
+    alias_parser::AliasDocument document;
+    document.parse(ALIAS);
+
+    const auto* second = document.findEffectSection("Gradient", 1);
+    CHECK(second != nullptr && second->name == "Object.2" && document.getValue(*second, "A") == "second");
+    CHECK(document.findEffectSection("Gradient", 2) == nullptr);
+    CHECK(document.findEffectSection("", 0) == nullptr);
+}
+
+/// @brief 再度解析すると前回の変更が残らないこと
+void testParseDiscardsPatches()
+{
+    alias_parser::AliasDocument document;
+    document.parse(ALIAS);
+    document.setValue(*document.findSection("Object.1"), "A", "patched");
+    CHECK(document.hasPatches());
+
+    document.parse(ALIAS);
+    CHECK(!document.hasPatches());
+    CHECK(document.getValue(*document.findSection("Object.1"), "A") == "other");
+
+    std::string out;
+    document.serialize(out);
+    CHECK(out == ALIAS);
+}
+
+/// @brief 一度同じ大きさのエイリアスを扱った後は、解析・変更・書き出しでヒープ確保が起きないこと
+void testReparseDoesNotAllocate()
+{
+    alias_parser::AliasDocument document;
+    std::string out;
+    out.reserve(ALIAS.size() * 2);
+
+    const auto run = [&](std::string_view value) {
+        document.parse(ALIAS);
+        const auto* section = document.findEffectSection("Gradient", 0);
+        document.setToken(*section, "A", 2, value);
+        document.setValue(*section, "B", value);
+        out.clear();
+        document.serialize(out);
+    };
+
+    // 1 回目で索引と変更後の値の領域を確保する
+    run("a value longer than the small string buffer");
+
+    test_util::AllocationCounter counter;
+    for (int i = 0; i < 10; ++i) run(i % 2 == 0 ? "short" : "a value longer than the small string buffer");
+    CHECK(counter.count() == 0);
+    CHECK(out.find("B=a value longer") != std::string::npos);
+}
+}  // namespace
+
+int main()
+{
+    testGetSetSerialize();
+    testFindEffectSectionByIndex();
+    testParseDiscardsPatches();
+    testReparseDoesNotAllocate();
+    return test_util::result();
+}
@@ -0,0 +1,215 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+
+#include "test_util.h"
+#include "utils/aviutl2/alias_parser.h"
+
+namespace {
+/// @brief 書き換える前の getNthToken。結果が変わっていないことを確かめる基準
+std::string referenceGetNthToken(std::string_view src, const uint32_t index)
+{
+    uint32_t start   = 0;
+    uint32_t current = 0;
+
+    while (true) {
+        auto pos = src.find(',', start);
+        if (current == index) {
+            return std::string(
+                pos == std::string_view::npos
+                    ? src.substr(start)
+                    : src.substr(start, pos - start));
+        }
+        if (pos == std::string_view::npos) break;
+        start = static_cast<uint32_t>(pos) + 1u;
+        ++current;
+    }
+
+    auto first = src.find(',');
+    return std::string(first == std::string_view::npos ? src : src.substr(0, first));
+}
+
+/// @brief 書き換える前の replaceNthToken。結果が変わっていないことを確かめる基準
+std::string referenceReplaceNthToken(std::string_view src, const uint32_t index, std::string_view replacement)
+{
+    uint32_t start   = 0;
+    uint32_t current = 0;
+    std::string result{};
+
+    auto slice = [](const std::string& s, const int32_t first, const int32_t end) {
+        return s.substr(first, std::abs(end - first) + 1);
+    };
+
+    while (true) {
+        auto pos = src.find(',', start);
+        if (current == index) {
+            // 最後の要素ならカンマを付けない
+            if (pos == std::string_view::npos) {
+                result += std::string{replacement};
+                break;
+            }
+            result += std::string{replacement} + ",";
+            start = static_cast<uint32_t>(pos) + 1;
+            ++current;
+            continue;
+        }
+
+        if (pos == std::string_view::npos) {
+            if (index >= current + 1) {
+                result = std::string{replacement};
+            } else {
+                result += slice(std::string{src}, start, static_cast<int32_t>(std::ssize(src)) - 1);
+            }
+            break;
+        }
+
+        result += slice(std::string{src}, start, static_cast<int32_t>(pos));
+        start = static_cast<uint32_t>(pos) + 1;
+        ++current;
+    }
+
+    return result;
+}
+
+/// @brief 範囲の置換は、範囲内のセクションを 1 つずつ置換した結果と一致すること
+std::string referenceReplaceTokenRange(std::string_view src, const uint32_t first, const uint32_t last, std::string_view replacement)
+{
+    std::string result = referenceReplaceNthToken(src, first, replacement);
+    const auto count   = static_cast<uint32_t>(std::ranges::count(src, ',')) + 1;
+    for (uint32_t i = first + 1; i <= last && i < count; ++i) result = referenceReplaceNthToken(result, i, replacement);
+    return result;
+}
+
+/// @brief 空の値や連続するカンマを含む 1 行分を作る
+std::string makeLine(std::mt19937& rng)
+{
+    static constexpr std::string_view CHARS = "0123456789.-a";
+    std::uniform_int_distribution<uint32_t> token_count_dist{1, 8};
+    std::uniform_int_distribution<uint32_t> token_size_dist{0, 4};
+    std::uniform_int_distribution<size_t> char_dist{0, CHARS.size() - 1};
+
+    std::string line;
+    const uint32_t token_count = token_count_dist(rng);
+    for (uint32_t i = 0; i < token_count; ++i) {
+        if (i > 0) line.push_back(',');
+        const uint32_t token_size = token_size_dist(rng);
+        for (uint32_t j = 0; j < token_size; ++j) line.push_back(CHARS[char_dist(rng)]);
+    }
+    return line;
+}
+
+/// @brief 書き換える前の getFrameCount。結果が変わっていないことを確かめる基準
+int32_t referenceGetFrameCount(std::string_view alias)
+{
+    int32_t count{2};
+    std::regex re(R"(\[Object\][\s\S]*?\r?\n(frame=.*))");
+    std::string s{alias};
+    std::smatch m;
+    if (std::regex_search(s, m, re)) {
+        std::string frame_line = m[1].str();
+        count                  = static_cast<int32_t>(std::count(frame_line.begin(), frame_line.end(), ',')) + 1;
+    }
+    return count;
+}
+
+/// @brief 行の組み合わせでエイリアスを作る。セクション、frame= 行、その他の行と改行の種類を混ぜる
+std::string makeAlias(std::mt19937& rng)
+{
+    static constexpr std::string_view LINES[] = {
+        "[Object]", "[Object.0]", "[Object.1]", "frame=0,99", "frame=0,10,20,", "frame=", "frame=5",
+        "layer=1", "effect.name=Gradient", "X=0,1,2", "frame =1,2", "xframe=1,2,3", "[Object]frame=1,2,3",
+    };
+    static constexpr std::string_view EOLS[] = {"\r\n", "\n", "\r"};
+    std::uniform_int_distribution<size_t> line_dist{0, std::size(LINES) - 1};
+    std::uniform_int_distribution<size_t> eol_dist{0, std::size(EOLS) - 1};
+    std::uniform_int_distribution<uint32_t> count_dist{0, 8};
+
+    std::string alias;
+    const uint32_t line_count = count_dist(rng);
+    for (uint32_t i = 0; i < line_count; ++i) {
+        if (i > 0) alias.append(EOLS[eol_dist(rng)]);
+        alias.append(LINES[line_dist(rng)]);
+    }
+    if (count_dist(rng) % 2 == 0) alias.append(EOLS[eol_dist(rng)]);
+    return alias;
+}
+
+void testFixedCases()
+{
+    CHECK(alias_parser::getNthTokenView("a,b,c", 1) == "b");
+    CHECK(alias_parser::getNthTokenView("a,b,c", 3) == "a");
+    CHECK(alias_parser::getNthTokenView("a,,c", 1).empty());
+    CHECK(alias_parser::getNthTokenView("", 0).empty());
+    CHECK(alias_parser::replaceNthToken("a,b,c", 2, "x") == "a,b,x");
+    CHECK(alias_parser::replaceNthToken("a,b,c", 5, "x") == "x");
+    CHECK(alias_parser::replaceNthToken("a,b,", 2, "x") == "a,b,x");
+
+    std::string out;
+    alias_parser::appendReplacedTokenRange(out, "a,b,c,d", 1, 2, "x");
+    CHECK(out == "a,x,x,d");
+    out.clear();
+    alias_parser::appendReplacedTokenRange(out, "a,b,c,d", 2, 9, "x");
+    CHECK(out == "a,b,x,x");
+
+    // getFrameCount
+    CHECK(alias_parser::getFrameCount("[Object]\r\nlayer=1\r\nframe=0,99,199\r\n[Object.0]\r\n") == 3);
+    CHECK(alias_parser::getFrameCount("[Object]\nframe=0,99\n") == 2);
+    CHECK(alias_parser::getFrameCount("[Object]\r\nframe=0,10,20,\r\n") == 4);  // 末尾のカンマも区切りとして数える
+    CHECK(alias_parser::getFrameCount("[Object]\r\nframe=0,10,20") == 3);          // 末尾に改行がない
+    CHECK(alias_parser::getFrameCount("layer=1\r\nframe=0,10,20\r\n") == 2);     // [Object] がない
+    CHECK(alias_parser::getFrameCount("frame=0,10,20\r\n[Object]\r\nlayer=1\r\n") == 2);  // [Object] より前の frame= は数えない
+    CHECK(alias_parser::getFrameCount("[Object]\r\n[Object.0]\r\nframe=0,1,2,3\r\n") == 4);  // 別のセクションの frame= も基準と同じく数える
+    CHECK(alias_parser::getFrameCount("") == 2);
+}
+
+/// @brief 様々なエイリアスで、正規表現による基準と同じフレーム数になること
+void testFrameCountMatchesRegex()
+{
+    std::mt19937 rng{20261019u};
+    for (int i = 0; i < 5000; ++i) {
+        const std::string alias = makeAlias(rng);
+        if (!CHECK(alias_parser::getFrameCount(alias) == referenceGetFrameCount(alias))) {
+            std::fprintf(stderr, "  alias=\"%s\"\n", alias.c_str());
+            break;
+        }
+    }
+}
+
+void testRandomLines()
+{
+    std::mt19937 rng{20261018u};
+    std::uniform_int_distribution<uint32_t> index_dist{0, 10};
+
+    for (int i = 0; i < 20000; ++i) {
+        const std::string src         = makeLine(rng);
+        const std::string replacement = makeLine(rng).substr(0, 3);
+        const std::string_view value  = std::string_view{replacement}.substr(0, replacement.find(','));
+        const uint32_t first          = index_dist(rng);
+        const uint32_t last           = first + index_dist(rng) % 4;
+
+        CHECK(alias_parser::getNthTokenView(src, first) == referenceGetNthToken(src, first));
+        CHECK(alias_parser::replaceNthToken(src, first, value) == referenceReplaceNthToken(src, first, value));
+
+        // 追加先に前の内容が残っていても、その後ろに追加するだけであること
+        std::string out = "prefix";
+        alias_parser::appendReplacedTokenRange(out, src, first, last, value);
+        if (!CHECK(out == "prefix" + referenceReplaceTokenRange(src, first, last, value))) {
+            std::fprintf(stderr, "  src=\"%s\" first=%u last=%u value=\"%.*s\"\n", src.c_str(), first, last, static_cast<int>(value.size()), value.data());
+            break;
+        }
+    }
+}
+}  // namespace
+
+int main()
+{
+    testFixedCases();
+    testRandomLines();
+    testFrameCountMatchesRegex();
+    return test_util::result();
+}
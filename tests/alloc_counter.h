@@ -0,0 +1,65 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/// @brief グローバルの operator new を置き換え、ヒープ確保の回数を数える
+/// @note 置き換えは実行ファイルに 1 つだけ定義できるため、テストの .cpp から 1 度だけインクルードすること
+namespace test_util {
+
+inline std::atomic<uint64_t> g_allocation_count{0};
+
+/// @brief 生成してからのヒープ確保の回数
+class AllocationCounter {
+public:
+    [[nodiscard]] uint64_t count() const noexcept { return g_allocation_count.load(std::memory_order_relaxed) - m_start; }
+
+private:
+    uint64_t m_start = g_allocation_count.load(std::memory_order_relaxed);
+};
+
+}  // namespace test_util
+
+void* operator new(const std::size_t size)
+{
+    test_util::g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    test_util::g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    // aligned_alloc() はサイズがアラインメントの倍数であること
+    const auto align   = static_cast<std::size_t>(alignment);
+    const auto rounded = std::max(align, (size + align - 1) / align * align);
+    if (void* ptr = std::aligned_alloc(align, rounded)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif  // !ALLOC_COUNTER_H
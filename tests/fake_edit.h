@@ -0,0 +1,137 @@
+#ifndef FAKE_EDIT_H
+#define FAKE_EDIT_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/constants.h"
+#include "utils/aviutl2/alias_document.h"
+#include "utils/common/str_conv.h"
+
+/// @brief ScriptItemAccess を AviUtl2 なしで動かすための、ホストの代わり
+namespace test_util {
+
+/// @brief オブジェクトの代わり。エイリアスの文字列だけを持ち、設定項目の値はエイリアスから読み書きする
+struct FakeObject {
+    std::string alias;
+};
+
+/// @brief set_object_item_value() の呼び出し 1 回分
+struct ItemWrite {
+    const FakeObject* object = nullptr;
+    std::wstring effect_key;
+    std::wstring item_name;
+    std::string value;
+};
+
+/// @brief EDIT_SECTION の代わり。ScriptItemAccess が呼ぶ関数のみを同じ名前で持ち、呼び出しを記録する
+class FakeEdit {
+public:
+    // false の場合は呼び出しを数えるだけで、記録もエイリアスの書き換えもしない (ヒープ確保を数えるテスト用)
+    bool is_recording = true;
+
+    std::vector<ItemWrite> writes;
+    uint32_t alias_call_count = 0;
+    uint32_t get_call_count   = 0;
+    uint32_t set_call_count   = 0;
+
+    const char* get_object_alias(FakeObject* object)
+    {
+        ++alias_call_count;
+        return object->alias.c_str();
+    }
+
+    int32_t count_object_effect(FakeObject*, const wchar_t*) { return 1; }
+
+    const char* get_object_item_value(FakeObject* object, const wchar_t* effect_key, const wchar_t* item_name)
+    {
+        ++get_call_count;
+        if (!is_recording) return nullptr;
+        auto value = findValue(object, effect_key, item_name);
+        if (!value) return nullptr;
+        m_value_buffer.assign(*value);
+        return m_value_buffer.c_str();
+    }
+
+    bool set_object_item_value(FakeObject* object, const wchar_t* effect_key, const wchar_t* item_name, const char* value)
+    {
+        ++set_call_count;
+        if (!is_recording) return true;
+        writes.push_back({object, effect_key, item_name, value});
+
+        // エイリアスの該当する行を書き換える
+        const auto* section = findSection(object, effect_key);
+        if (!section || !m_document.setValue(*section, str_conv::wideCharToMultiByte(item_name), value)) return false;
+        std::string alias;
+        m_document.serialize(alias);
+        object->alias = std::move(alias);
+        return true;
+    }
+
+    void clearCalls()
+    {
+        writes.clear();
+        alias_call_count = 0;
+        get_call_count   = 0;
+        set_call_count   = 0;
+    }
+
+private:
+    alias_parser::AliasDocument m_document;
+    std::string m_value_buffer;
+    std::string m_effect_alias_name;
+
+    // effect_key は "<エフェクト名>:<インデックス>"
+    const alias_parser::AliasDocument::Section* findSection(FakeObject* object, std::wstring_view effect_key)
+    {
+        const auto colon = effect_key.rfind(L':');
+        if (colon == std::wstring_view::npos) return nullptr;
+        m_effect_alias_name = str_conv::wideCharToMultiByte(std::wstring{effect_key.substr(0, colon)});
+        const auto index    = static_cast<uint32_t>(std::stoul(std::wstring{effect_key.substr(colon + 1)}));
+
+        m_document.parse(object->alias);
+        return m_document.findEffectSection(m_effect_alias_name, index);
+    }
+
+    std::optional<std::string_view> findValue(FakeObject* object, std::wstring_view effect_key, const wchar_t* item_name)
+    {
+        const auto* section = findSection(object, effect_key);
+        if (!section) return std::nullopt;
+        return m_document.getValue(*section, str_conv::wideCharToMultiByte(item_name));
+    }
+};
+
+/// @brief グラデーション編集のエフェクトを 1 つ持つオブジェクトのエイリアスを作る
+/// @param frame_count 中間点を含むセクションの区切りの数 (frame= の値の数)
+/// @param values 動く項目 (マーカー数、位置、透明度) の値。frame_count 個並べる
+inline std::string makeGradientAlias(const uint32_t frame_count, const uint32_t marker_count, std::string_view values = "0")
+{
+    const auto repeat = [&](std::string_view value) {
+        std::string line;
+        for (uint32_t i = 0; i < frame_count; ++i) {
+            if (i > 0) line.push_back(',');
+            line.append(value);
+        }
+        return line;
+    };
+
+    std::string text = "[Object]\r\nlayer=1\r\nframe=" + repeat("0") + "\r\n";
+    text += "[Object.0]\r\neffect.name=" + str_conv::wideCharToMultiByte(std::wstring{gradient_editor::EFFECT_NAMES[0]} + gradient_editor::EFFECT_GROUP_NAME) + "\r\n";
+    text += reinterpret_cast<const char*>(u8"マーカー数=") + repeat(std::to_string(marker_count)) + "\r\n";
+    for (uint32_t i = 1; i <= marker_count; ++i) {
+        const std::string id = std::to_string(i);
+        text += reinterpret_cast<const char*>(u8"位置") + id + "=" + repeat(values) + "\r\n";
+        text += reinterpret_cast<const char*>(u8"色") + id + "=ffffff\r\n";
+        text += reinterpret_cast<const char*>(u8"透明度") + id + "=" + repeat(values) + "\r\n";
+        text += reinterpret_cast<const char*>(u8"中間点") + id + "=50\r\n";
+    }
+    text += reinterpret_cast<const char*>(u8"ぼかし幅=100\r\n色空間=sRGB\r\n補間経路=短経路\r\n");
+    return text + "[Object.1]\r\neffect.name=" + reinterpret_cast<const char*>(u8"標準描画") + "\r\nX=0.00\r\n";
+}
+
+}  // namespace test_util
+
+#endif  // !FAKE_EDIT_H
@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "alloc_counter.h"
+#include "test_util.h"
+#include "utils/common/frame_arena.h"
+
+namespace {
+constexpr std::string_view LONG_TEXT = "a label long enough to not fit in the small string buffer";
+
+/// @brief 容量に収まる間は、コンテナの確保でヒープ確保が起きないこと
+void testAllocationsStayInArena()
+{
+    frame_arena::Arena arena{1024};
+
+    test_util::AllocationCounter counter;
+    for (int frame = 0; frame < 10; ++frame) {
+        arena.reset();
+        frame_arena::Vector<std::pair<float, uint32_t>> distances{&arena};
+        distances.reserve(32);
+        for (uint32_t i = 0; i < 32; ++i) distances.emplace_back(static_cast<float>(i), i);
+        frame_arena::String text{LONG_TEXT, &arena};
+        text += "###id";
+    }
+    CHECK(counter.count() == 0);
+    CHECK(arena.overflowCount() == 0);
+    CHECK(arena.frameBytes() > 0);
+    CHECK(arena.capacity() == 1024);
+}
+
+/// @brief 容量を超えた分はそのフレームだけヒープから確保し、次のフレームからは収まるように広げること
+void testOverflowGrowsCapacity()
+{
+    frame_arena::Arena arena{1024};
+    arena.reset();
+
+    test_util::AllocationCounter overflow_counter;
+    void* small = arena.allocate(512);
+    void* large = arena.allocate(4096);
+    CHECK(overflow_counter.count() > 0);
+    CHECK(arena.overflowCount() == 1);
+    CHECK(arena.frameBytes() == 512 + 4096);
+    CHECK(small != nullptr && large != nullptr);
+
+    arena.reset();
+    CHECK(arena.capacity() == 8192);
+    CHECK(arena.peakBytes() == 512 + 4096);
+    CHECK(arena.overflowCount() == 0);
+
+    test_util::AllocationCounter counter;
+    bool is_allocated = true;
+    for (int frame = 0; frame < 10; ++frame) {
+        arena.reset();
+        is_allocated = is_allocated && arena.allocate(512) != nullptr;
+        is_allocated = is_allocated && arena.allocate(4096) != nullptr;
+    }
+    CHECK(counter.count() == 0);
+    CHECK(is_allocated);
+    CHECK(arena.overflowCount() == 0);
+}
+
+/// @brief 要求したアラインメントで確保すること
+void testAlignment()
+{
+    frame_arena::Arena arena{1024};
+    void* unaligned = arena.allocate(3, 1);
+    void* aligned   = arena.allocate(8, 64);
+    CHECK(unaligned != nullptr);
+    CHECK(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+    // 容量を超えた場合も同じ
+    void* overflow = arena.allocate(2048, 128);
+    CHECK(arena.overflowCount() == 1);
+    CHECK(reinterpret_cast<uintptr_t>(overflow) % 128 == 0);
+}
+}  // namespace
+
+int main()
+{
+    testAllocationsStayInArena();
+    testOverflowGrowsCapacity();
+    testAlignment();
+    return test_util::result();
+}
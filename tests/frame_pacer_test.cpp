@@ -0,0 +1,83 @@
+#include <chrono>
+
+#include "core/frame_pacer.h"
+#include "test_util.h"
+
+namespace {
+using gradient_editor::FramePacer;
+using namespace std::chrono_literals;
+
+// 実際の時計は使わず、任意の時刻からの経過で判断を確かめる
+const FramePacer::TimePoint START = FramePacer::TimePoint{} + 100s;
+
+FramePacer makePacer()
+{
+    return FramePacer{{.active_duration = 1000ms, .idle_interval = 500ms}};
+}
+
+/// @brief 最初のフレームは必ず描画し、その後は idle_interval ごとにだけ描画すること
+void testIdle()
+{
+    FramePacer pacer = makePacer();
+    CHECK(pacer.shouldRender(START));
+    CHECK(pacer.waitTimeout(START) == FramePacer::Duration::zero());
+
+    pacer.onFrameRendered(START);
+    CHECK(!pacer.shouldRender(START + 1ms));
+    CHECK(pacer.waitTimeout(START + 1ms) == 499ms);
+    CHECK(!pacer.shouldRender(START + 499ms));
+    CHECK(pacer.shouldRender(START + 500ms));
+    CHECK(pacer.waitTimeout(START + 500ms) == FramePacer::Duration::zero());
+
+    pacer.onFrameRendered(START + 500ms);
+    CHECK(!pacer.shouldRender(START + 600ms));
+    CHECK(pacer.waitTimeout(START + 600ms) == 400ms);
+}
+
+/// @brief 処理が続いている間は毎フレーム描画し、終われば待つこと
+void testBusy()
+{
+    FramePacer pacer = makePacer();
+    pacer.onFrameRendered(START);
+    pacer.setBusy(true);
+    CHECK(pacer.shouldRender(START + 1ms));
+    CHECK(pacer.waitTimeout(START + 1ms) == FramePacer::Duration::zero());
+
+    pacer.onFrameRendered(START + 1ms);
+    CHECK(pacer.shouldRender(START + 2ms));
+
+    pacer.setBusy(false);
+    CHECK(!pacer.shouldRender(START + 2ms));
+    CHECK(pacer.waitTimeout(START + 2ms) == 499ms);
+}
+
+/// @brief イベントの後 active_duration の間は毎フレーム描画し、続くイベントで期間が延びること
+void testEvent()
+{
+    FramePacer pacer = makePacer();
+    pacer.onFrameRendered(START);
+    pacer.notifyEvent(START + 10ms);
+    CHECK(pacer.shouldRender(START + 10ms));
+    pacer.onFrameRendered(START + 10ms);
+    CHECK(pacer.shouldRender(START + 1009ms));
+    pacer.onFrameRendered(START + 1009ms);
+    CHECK(!pacer.shouldRender(START + 1010ms));
+
+    // 期間の途中のイベントで延び、古い時刻のイベントでは縮まない
+    pacer.notifyEvent(START + 1100ms);
+    pacer.notifyEvent(START + 200ms);
+    pacer.onFrameRendered(START + 1100ms);
+    CHECK(pacer.shouldRender(START + 2099ms));
+    pacer.onFrameRendered(START + 2099ms);
+    CHECK(!pacer.shouldRender(START + 2100ms));
+    CHECK(pacer.waitTimeout(START + 2100ms) == 499ms);
+}
+}  // namespace
+
+int main()
+{
+    testIdle();
+    testBusy();
+    testEvent();
+    return test_util::result();
+}
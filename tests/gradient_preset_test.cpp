@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.hpp"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+
+namespace {
+/// @brief formatColor() の結果を parseColor() で元の値に戻せること
+void testColorRoundTrip()
+{
+    CHECK(preset::formatColor(0x000000ff) == "0x000000FF");
+    CHECK(preset::formatColor(0xAB7B01FF) == "0xAB7B01FF");
+    CHECK(preset::formatColor(0xffffffff) == "0xFFFFFFFF");
+    CHECK(preset::formatColor(0) == "0x00000000");
+
+    std::mt19937 rng{20261019u};
+    for (int i = 0; i < 100000; ++i) {
+        const uint32_t rgba = static_cast<uint32_t>(rng());
+        if (!CHECK(preset::parseColor(preset::formatColor(rgba)) == rgba)) {
+            std::fprintf(stderr, "  rgba=%08x\n", rgba);
+            break;
+        }
+    }
+}
+
+/// @brief 大文字・小文字を区別せず、桁数が少ない場合は上位の桁を 0 として読むこと
+void testParseColorVariants()
+{
+    CHECK(preset::parseColor("0xab7b01ff") == 0xab7b01ff);
+    CHECK(preset::parseColor("0XAB7B01FF") == 0xab7b01ff);
+    CHECK(preset::parseColor("0xAb7B01fF") == 0xab7b01ff);
+    CHECK(preset::parseColor("0xff") == 0x000000ff);
+}
+
+/// @brief 16 進数として読めない色は不透明な白として扱うこと
+void testParseColorRejectsMalformed()
+{
+    constexpr uint32_t FALLBACK = 0xffffffff;
+    CHECK(preset::parseColor("") == FALLBACK);
+    CHECK(preset::parseColor("0x") == FALLBACK);
+    CHECK(preset::parseColor("0xGG0000FF") == FALLBACK);
+    CHECK(preset::parseColor("0x12zz5678") == FALLBACK);
+    CHECK(preset::parseColor("0x-1234567") == FALLBACK);
+    CHECK(preset::parseColor("0x 1234567") == FALLBACK);
+    CHECK(preset::parseColor("#000000FF") == FALLBACK);
+    CHECK(preset::parseColor("000000FF") == FALLBACK);  // "0x" がない
+    CHECK(preset::parseColor("1x000000") == FALLBACK);
+}
+
+/// @brief JSON では "0xRRGGBBAA" の文字列で保存し、読み込むと同じ値に戻ること
+void testPresetJsonRoundTrip()
+{
+    preset::GradientPreset preset;
+    preset.name   = "colors";
+    preset.colors = {0x00000000, 0x12345678, 0xffffffff};
+
+    const nlohmann::ordered_json j = preset;
+    CHECK(j.at("colors").at(1) == "0x12345678");
+    const auto loaded = j.get<preset::GradientPreset>();
+    CHECK(loaded.colors == preset.colors);
+
+    // 壊れた色はその色だけを白にし、プリセット自体は読み込む
+    auto broken         = j;
+    broken["colors"][1] = "0xnothex";
+    CHECK((broken.get<preset::GradientPreset>().colors == std::vector<uint32_t>{0x00000000, 0xffffffff, 0xffffffff}));
+}
+}  // namespace
+
+int main()
+{
+    testColorRoundTrip();
+    testParseColorVariants();
+    testParseColorRejectsMalformed();
+    testPresetJsonRoundTrip();
+    return test_util::result();
+}
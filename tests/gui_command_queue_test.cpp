@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "core/gui_command_queue.h"
+#include "test_util.h"
+#include "utils/common/mpsc_queue.h"
+
+namespace {
+constexpr uint32_t PRODUCER_COUNT     = 4;
+constexpr uint32_t ITEMS_PER_PRODUCER = 20000;
+constexpr auto WAKE_TIMEOUT           = std::chrono::seconds{10};
+
+struct Item {
+    uint32_t producer = 0;
+    uint32_t sequence = 0;
+};
+
+/// @brief 同じスレッドが積んだ要素は積んだ順に、すべての要素が 1 度ずつ取り出せること
+void testMpscQueueStress()
+{
+    MpscQueue<Item> queue;
+    std::vector<std::jthread> producers;
+    for (uint32_t producer = 0; producer < PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([&queue, producer] {
+            for (uint32_t i = 0; i < ITEMS_PER_PRODUCER; ++i) queue.push({.producer = producer, .sequence = i});
+        });
+    }
+
+    std::vector<uint32_t> next_sequences(PRODUCER_COUNT, 0);
+    uint32_t received_count = 0;
+    bool is_in_order        = true;
+    while (received_count < PRODUCER_COUNT * ITEMS_PER_PRODUCER) {
+        auto item = queue.pop();
+        if (!item) {
+            // 空、または push() の途中
+            std::this_thread::yield();
+            continue;
+        }
+        if (item->producer >= PRODUCER_COUNT || item->sequence != next_sequences[item->producer]) {
+            is_in_order = false;
+            break;
+        }
+        ++next_sequences[item->producer];
+        ++received_count;
+    }
+    producers.clear();
+
+    CHECK(is_in_order);
+    CHECK(received_count == PRODUCER_COUNT * ITEMS_PER_PRODUCER);
+    CHECK(!queue.pop().has_value());
+}
+
+/// @brief 起こす必要があるのは drain() の後の最初の post() だけであること
+void testGuiCommandQueueWakeFlag()
+{
+    using namespace gradient_editor;
+    GuiCommandQueue queue;
+    CHECK(queue.post(gui_command::RequestRender{}));
+    CHECK(!queue.post(gui_command::RequestRender{}));
+    CHECK(queue.drain([](auto&) {}) == 2);
+    CHECK(queue.post(gui_command::Quit{}));
+    CHECK(queue.drain([](auto&) {}) == 1);
+    CHECK(queue.drain([](auto&) {}) == 0);
+}
+
+/// @brief 複数のスレッドから post() しても起こし損ねがなく、すべてのコマンドを順に処理できること
+/// @note 起こし損ねると GUI スレッド役が待ち続けるため、待ち時間の上限で失敗にする
+void testGuiCommandQueueStress()
+{
+    using namespace gradient_editor;
+    GuiCommandQueue queue;
+    std::counting_semaphore<> wake{0};
+    std::atomic<uint32_t> wake_count{0};
+
+    // Continuation の中から書き換える。drain() する GUI スレッド役のみが触る
+    std::vector<uint32_t> next_sequences(PRODUCER_COUNT, 0);
+    bool is_in_order = true;
+
+    std::vector<std::jthread> producers;
+    for (uint32_t producer = 0; producer < PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([&, producer] {
+            for (uint32_t i = 0; i < ITEMS_PER_PRODUCER; ++i) {
+                GuiCommand command = i % 2 == 0
+                                         ? GuiCommand{gui_command::Continuation{[&next_sequences, &is_in_order, producer, i] {
+                                               if (next_sequences[producer] != i) is_in_order = false;
+                                               next_sequences[producer] = i + 2;
+                                           }}}
+                                         : GuiCommand{gui_command::RequestRender{}};
+                if (queue.post(std::move(command))) {
+                    wake_count.fetch_add(1, std::memory_order_relaxed);
+                    wake.release();
+                }
+            }
+        });
+    }
+
+    uint32_t processed_count = 0;
+    uint32_t render_count    = 0;
+    bool is_woken            = true;
+    while (processed_count < PRODUCER_COUNT * ITEMS_PER_PRODUCER) {
+        if (!wake.try_acquire_for(WAKE_TIMEOUT)) {
+            is_woken = false;
+            break;
+        }
+        processed_count += static_cast<uint32_t>(queue.drain([&](auto& command) {
+            using T = std::remove_cvref_t<decltype(command)>;
+            if constexpr (std::is_same_v<T, gui_command::Continuation>) {
+                command.run();
+            } else if constexpr (std::is_same_v<T, gui_command::RequestRender>) {
+                ++render_count;
+            }
+        }));
+    }
+    producers.clear();
+
+    CHECK(is_woken);
+    CHECK(is_in_order);
+    CHECK(processed_count == PRODUCER_COUNT * ITEMS_PER_PRODUCER);
+    CHECK(render_count == PRODUCER_COUNT * ITEMS_PER_PRODUCER / 2);
+    for (uint32_t producer = 0; producer < PRODUCER_COUNT; ++producer) CHECK(next_sequences[producer] == ITEMS_PER_PRODUCER);
+    CHECK(wake_count.load() <= processed_count);
+}
+}  // namespace
+
+int main()
+{
+    testMpscQueueStress();
+    testGuiCommandQueueWakeFlag();
+    testGuiCommandQueueStress();
+    return test_util::result();
+}
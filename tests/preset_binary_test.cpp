@@ -0,0 +1,186 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.hpp"
+#include "temp_directory.h"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_binary.h"
+
+namespace {
+preset_file::GradientPresetFile makeFile()
+{
+    preset_file::GradientPresetFile file;
+    file.presets.resize(3);
+    file.presets[0].name = reinterpret_cast<const char*>(u8"夕焼け");
+    file.presets[1].name = "";
+    file.presets[1].colors.clear();
+    file.presets[1].positions.clear();
+    file.presets[1].midpoints.clear();
+    file.presets[2].name               = "rainbow";
+    file.presets[2].colors             = {0xff0000ff, 0x00ff0080, 0x0000ff00};
+    file.presets[2].positions          = {0.0f, 0.333333f, 1.0f};
+    file.presets[2].midpoints          = {0.25f, 0.75f};
+    file.presets[2].blur_width         = 0.125f;
+    file.presets[2].color_space        = 7;
+    file.presets[2].interpolation_path = 1;
+    file.journal_seq                   = 42;
+    return file;
+}
+
+bool isSame(const preset_file::GradientPresetFile& a, const preset_file::GradientPresetFile& b)
+{
+    if (a.presets.size() != b.presets.size() || a.journal_seq != b.journal_seq) return false;
+    for (size_t i = 0; i < a.presets.size(); ++i) {
+        const auto& pa = a.presets[i];
+        const auto& pb = b.presets[i];
+        if (pa.name != pb.name || pa.colors != pb.colors || pa.positions != pb.positions || pa.midpoints != pb.midpoints ||
+            pa.blur_width != pb.blur_width || pa.color_space != pb.color_space || pa.interpolation_path != pb.interpolation_path) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void writeText(const std::filesystem::path& path, std::string_view text)
+{
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/// @brief JSON → バイナリ → JSON で内容が変わらないこと
+void testRoundTrip()
+{
+    const auto file  = makeFile();
+    const auto bytes = preset_binary::serialize(file, {.size = 1, .time = 2}, file.journal_seq);
+
+    preset_binary::View view;
+    if (!CHECK(view.open(bytes))) return;
+    CHECK(view.header().source == (preset_binary::SourceStamp{.size = 1, .time = 2}));
+    CHECK(isSame(preset_binary::deserialize(view), file));
+
+    const auto json_file = nlohmann::ordered_json::parse(nlohmann::ordered_json(preset_binary::deserialize(view)).dump()).get<preset_file::GradientPresetFile>();
+    CHECK(isSame(json_file, file));
+}
+
+/// @brief 途中で切れたデータ、識別子やバージョンの異なるデータ、範囲外を指すレコードは読み込まないこと
+void testRejectsCorruptData()
+{
+    const auto bytes = preset_binary::serialize(makeFile(), {}, 0);
+    preset_binary::View view;
+
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        if (!CHECK(!view.open(std::span{bytes}.first(size)))) {
+            std::fprintf(stderr, "  accepted truncated data: %zu / %zu bytes\n", size, bytes.size());
+            break;
+        }
+    }
+    CHECK(view.presetCount() == 0);
+
+    auto bad_magic = bytes;
+    bad_magic[0]   = std::byte{'X'};
+    CHECK(!view.open(bad_magic));
+
+    auto bad_version = bytes;
+    const uint32_t next_version = preset_binary::VERSION + 1;
+    std::memcpy(bad_version.data() + offsetof(preset_binary::Header, version), &next_version, sizeof(next_version));
+    CHECK(!view.open(bad_version));
+
+    // 最後のレコードの色の範囲を配列の外に向ける
+    auto bad_record = bytes;
+    const size_t record_offset = sizeof(preset_binary::Header) + 2 * sizeof(preset_binary::PresetRecord) + offsetof(preset_binary::PresetRecord, color_offset);
+    const uint32_t color_offset = 0xfffffffe;
+    std::memcpy(bad_record.data() + record_offset, &color_offset, sizeof(color_offset));
+    CHECK(!view.open(bad_record));
+
+    // 要素数を大きくして、全体の大きさの計算があふれないこと
+    auto huge_count = bytes;
+    const uint32_t preset_count = 0xffffffff;
+    std::memcpy(huge_count.data() + offsetof(preset_binary::Header, preset_count), &preset_count, sizeof(preset_count));
+    CHECK(!view.open(huge_count));
+
+    CHECK(view.open(bytes));
+}
+
+/// @brief 壊れたファイルと空のファイルは readFile() で読み込まないこと
+void testReadFileRejectsCorruptFile()
+{
+    test_util::TempDirectory dir{"binary_corrupt"};
+    const auto file = makeFile();
+    const auto path = dir / "presets.bin";
+
+    CHECK(preset_binary::writeFile(path, file, {.size = 1, .time = 2}, file.journal_seq));
+    CHECK(preset_binary::readFile(path).has_value());
+
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+    CHECK(!preset_binary::readFile(path).has_value());
+
+    std::filesystem::resize_file(path, 0);
+    CHECK(!preset_binary::readFile(path).has_value());
+    CHECK(!preset_binary::readFile(dir / "missing.bin").has_value());
+}
+
+/// @brief JSON の大きさか更新日時がバイナリに記録したものと異なる場合は、JSON から読み込むこと
+void testStaleStampFallsBackToJson()
+{
+    test_util::TempDirectory dir{"binary_stale"};
+    PresetManager manager{dir / "presets.json"};
+
+    auto file = makeFile();
+    CHECK(manager.writePresetFile(file).is_success);
+    const auto binary_path = dir / "presets.bin";
+    CHECK(std::filesystem::exists(binary_path));
+
+    // 一致する場合はバイナリから読み込み、作り直しは不要
+    auto cached = manager.loadPresetFile();
+    CHECK(cached.error.empty());
+    CHECK(!cached.stale_binary_source.has_value());
+    CHECK(cached.preset_file.presets.size() == 3);
+
+    // 大きさが変わった
+    file.presets[0].name = "changed";
+    writeText(manager.presetFilePath(), nlohmann::ordered_json(file).dump());
+    auto resized = manager.loadPresetFile();
+    CHECK(resized.error.empty());
+    CHECK(resized.stale_binary_source.has_value());
+    CHECK(resized.preset_file.presets[0].name == "changed");
+
+    // バイナリを作り直すと、次はバイナリから読み込む
+    CHECK(manager.finishLoad(resized.preset_file, resized).is_success);
+    auto rebuilt = manager.loadPresetFile();
+    CHECK(!rebuilt.stale_binary_source.has_value());
+    CHECK(rebuilt.preset_file.presets[0].name == "changed");
+
+    // 大きさが同じで、更新日時のみが変わった
+    file.presets[0].name = "CHANGED";
+    writeText(manager.presetFilePath(), nlohmann::ordered_json(file).dump());
+    const auto stamp = preset_binary::getSourceStamp(manager.presetFilePath());
+    auto bytes       = preset_binary::serialize(makeFile(), {.size = stamp->size, .time = stamp->time - 1}, 0);
+    writeText(binary_path, std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()});
+    auto touched = manager.loadPresetFile();
+    CHECK(touched.stale_binary_source.has_value());
+    CHECK(touched.preset_file.presets[0].name == "CHANGED");
+
+    // バイナリが壊れている場合も JSON から読み込む
+    writeText(binary_path, "GEPB");
+    auto corrupt = manager.loadPresetFile();
+    CHECK(corrupt.error.empty());
+    CHECK(corrupt.stale_binary_source.has_value());
+    CHECK(corrupt.preset_file.presets[0].name == "CHANGED");
+}
+}  // namespace
+
+int main()
+{
+    testRoundTrip();
+    testRejectsCorruptData();
+    testReadFileRejectsCorruptFile();
+    testStaleStampFallsBackToJson();
+    return test_util::result();
+}
@@ -0,0 +1,165 @@
+#include <cstdint>
+#include <string>
+
+#include "json.hpp"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_hash.h"
+#include "ui/widgets/preset_import.h"
+
+namespace {
+preset::GradientPreset makePreset()
+{
+    preset::GradientPreset preset;
+    preset.name       = "base";
+    preset.colors     = {0xff0000ff, 0x00ff00ff, 0x0000ffff};
+    preset.positions  = {0.0f, 0.5f, 1.0f};
+    preset.midpoints  = {0.3f, 0.7f};
+    preset.blur_width = 0.25f;
+    return preset;
+}
+
+uint64_t hashOf(const preset::GradientPreset& preset)
+{
+    return preset_hash::contentHash(preset_hash::canonicalize(preset));
+}
+
+bool isEquivalent(const preset::GradientPreset& a, const preset::GradientPreset& b)
+{
+    const auto ca = preset_hash::canonicalize(a);
+    const auto cb = preset_hash::canonicalize(b);
+    return preset_hash::contentHash(ca) == preset_hash::contentHash(cb) && preset_hash::isSameContent(ca, cb);
+}
+
+/// @brief 丸めの単位より小さい位置・中間点・ぼかし幅の違いは同じ内容とみなすこと
+void testFloatRounding()
+{
+    const auto base = makePreset();
+
+    auto jittered          = base;
+    jittered.positions[1] += 1e-6f;
+    jittered.midpoints[0] += 2e-5f;
+    jittered.midpoints[1] -= 2e-5f;
+    jittered.blur_width   += 3e-5f;
+    CHECK(isEquivalent(base, jittered));
+
+    // 範囲外の位置は [0, 1] に収める
+    auto out_of_range         = base;
+    out_of_range.positions[0] = -0.1f;
+    out_of_range.positions[2] = 1.2f;
+    CHECK(isEquivalent(base, out_of_range));
+
+    // 丸めの単位以上の違いは別の内容
+    auto moved          = base;
+    moved.positions[1] += 1.0f / preset_hash::QUANTIZATION_STEPS * 2.0f;
+    CHECK(!isEquivalent(base, moved));
+    CHECK(hashOf(base) != hashOf(moved));
+}
+
+/// @brief マーカーの並びが異なっても、中間点が同じマーカーに属していれば同じ内容とみなすこと
+void testMarkerOrder()
+{
+    const auto base = makePreset();
+
+    // 緑, 赤, 青 の順。中間点はそれぞれ直前のマーカーのもの
+    auto shuffled      = base;
+    shuffled.colors    = {0x00ff00ff, 0xff0000ff, 0x0000ffff};
+    shuffled.positions = {0.5f, 0.0f, 1.0f};
+    shuffled.midpoints = {0.7f, 0.3f};
+    CHECK(isEquivalent(base, shuffled));
+
+    // 中間点を入れ替えずにマーカーだけを並べ替えたものは別の内容
+    auto mismatched      = shuffled;
+    mismatched.midpoints = {0.3f, 0.7f};
+    CHECK(!isEquivalent(base, mismatched));
+
+    // 中間点が足りない場合は 0.5 で補う
+    auto missing           = base;
+    missing.midpoints      = {0.3f};
+    auto explicit_mid      = base;
+    explicit_mid.midpoints = {0.3f, 0.5f};
+    CHECK(isEquivalent(missing, explicit_mid));
+}
+
+/// @brief 色の 16 進数の大文字・小文字は内容に影響しないこと
+void testHexCase()
+{
+    const auto upper = nlohmann::ordered_json::parse(R"({"name": "upper", "colors": ["0xFF00AAFF", "0x0A0B0CFF"], "positions": [0.0, 1.0],
+                                                         "midpoints": [0.5], "blur_width": 0.0, "color_space": 0, "interpolation_path": 0})")
+                           .get<preset::GradientPreset>();
+    const auto lower = nlohmann::ordered_json::parse(R"({"name": "lower", "colors": ["0xff00aaff", "0x0a0b0cff"], "positions": [0.0, 1.0],
+                                                         "midpoints": [0.5], "blur_width": 0.0, "color_space": 0, "interpolation_path": 0})")
+                           .get<preset::GradientPreset>();
+    CHECK(isEquivalent(upper, lower));
+
+    uint32_t css_upper = 0;
+    uint32_t css_lower = 0;
+    CHECK(preset_import::parseCssColor("#FF00AA", css_upper));
+    CHECK(preset_import::parseCssColor("#ff00aa", css_lower));
+    CHECK(css_upper == css_lower);
+}
+
+/// @brief 名前は内容に含めず、色・色空間・補間の経路は含めること
+void testContentFields()
+{
+    const auto base = makePreset();
+
+    auto renamed = base;
+    renamed.name = "renamed";
+    CHECK(isEquivalent(base, renamed));
+
+    auto recolored      = base;
+    recolored.colors[1] = 0x00fe00ff;
+    CHECK(!isEquivalent(base, recolored));
+
+    auto other_space        = base;
+    other_space.color_space = base.color_space + 1;
+    CHECK(!isEquivalent(base, other_space));
+
+    auto other_path               = base;
+    other_path.interpolation_path = base.interpolation_path + 1;
+    CHECK(!isEquivalent(base, other_path));
+}
+
+/// @brief 同じ内容のプリセットを重複として見つけ、名前の衝突には "_copy" を付けること
+void testDedupIndex()
+{
+    preset_file::GradientPresetFile file;
+    file.presets  = {makePreset()};
+    file.revision = 1;
+
+    preset_hash::PresetDedupIndex index;
+    index.sync(file);
+
+    auto shuffled      = makePreset();
+    shuffled.name      = "other";
+    shuffled.colors    = {0x00ff00ff, 0xff0000ff, 0x0000ffff};
+    shuffled.positions = {0.5f, 0.0f, 1.0f};
+    shuffled.midpoints = {0.7f, 0.3f};
+    CHECK(index.findDuplicate(preset_hash::canonicalize(shuffled)) == 0u);
+
+    auto distinct      = makePreset();
+    distinct.name      = "distinct";
+    distinct.colors[0] = 0x123456ff;
+    CHECK(!index.findDuplicate(preset_hash::canonicalize(distinct)).has_value());
+
+    CHECK(index.uniqueName("base") == "base_copy");
+    CHECK(index.uniqueName("new") == "new");
+
+    file.presets.push_back(distinct);
+    ++file.revision;
+    index.add(file);
+    CHECK(index.findDuplicate(preset_hash::canonicalize(distinct)) == 1u);
+    CHECK(index.uniqueName("base") == "base_copy2");
+}
+}  // namespace
+
+int main()
+{
+    testFloatRounding();
+    testMarkerOrder();
+    testHexCase();
+    testContentFields();
+    testDedupIndex();
+    return test_util::result();
+}
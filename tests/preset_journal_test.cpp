@@ -0,0 +1,172 @@
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.hpp"
+#include "temp_directory.h"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+
+namespace {
+using preset_journal::Operation;
+using preset_journal::OperationType;
+
+preset::GradientPreset makePreset(std::string name, const uint32_t rgba = 0xff0000ff)
+{
+    preset::GradientPreset preset;
+    preset.name   = std::move(name);
+    preset.colors = {rgba, 0xffffffff};
+    return preset;
+}
+
+std::vector<std::string> names(const preset_file::GradientPresetFile& file)
+{
+    std::vector<std::string> result;
+    for (const auto& preset : file.presets) result.push_back(preset.name);
+    return result;
+}
+
+void writeText(const std::filesystem::path& path, std::string_view text)
+{
+    std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+    ofs.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+/// @brief ジャーナルの 1 行を、commitOperation() と同じ形式で作る
+std::string journalLine(Operation op, const uint64_t seq)
+{
+    op.seq = seq;
+    return nlohmann::ordered_json(op).dump() + "\n";
+}
+
+/// @brief プリセットファイルの journal_seq 以前の操作は反映済みとして読み飛ばすこと
+void testReplaySkipsAppliedOperations()
+{
+    test_util::TempDirectory dir{"journal_skip"};
+    PresetManager manager{dir / "presets.json"};
+
+    // seq 1, 2 は反映済み
+    preset_file::GradientPresetFile file;
+    file.presets     = {makePreset("A"), makePreset("B")};
+    file.journal_seq = 2;
+    writeText(manager.presetFilePath(), nlohmann::ordered_json(file).dump());
+    writeText(manager.journalPath(), journalLine({.type = OperationType::Add, .preset = makePreset("A")}, 1) +
+                                         journalLine({.type = OperationType::Add, .preset = makePreset("B")}, 2) +
+                                         journalLine({.type = OperationType::Add, .preset = makePreset("C")}, 3) +
+                                         journalLine({.type = OperationType::Swap, .index_1 = 0, .index_2 = 2}, 4));
+
+    auto result = manager.loadPresetFile();
+    CHECK(result.error.empty());
+    CHECK((names(result.preset_file) == std::vector<std::string>{"C", "B", "A"}));
+    CHECK(!result.needs_compaction);
+
+    // 次の操作は最後に再生した通し番号の続きになる
+    CHECK(manager.commitOperation(result.preset_file, {.type = OperationType::Delete, .index_1 = 1}).is_success);
+    std::ifstream journal{manager.journalPath()};
+    std::string line, last_line;
+    while (std::getline(journal, line)) last_line = line;
+    CHECK(nlohmann::ordered_json::parse(last_line).at("seq") == 5);
+}
+
+/// @brief 書き込み途中で終了した最後の行は無視し、圧縮が必要と判定すること
+void testReplayToleratesTruncatedLine()
+{
+    test_util::TempDirectory dir{"journal_truncated"};
+    PresetManager manager{dir / "presets.json"};
+
+    preset_file::GradientPresetFile file;
+    file.presets = {makePreset("A")};
+    writeText(manager.presetFilePath(), nlohmann::ordered_json(file).dump());
+
+    const std::string torn = journalLine({.type = OperationType::Add, .preset = makePreset("C")}, 2);
+    writeText(manager.journalPath(), journalLine({.type = OperationType::Add, .preset = makePreset("B")}, 1) + torn.substr(0, torn.size() / 2));
+
+    auto result = manager.loadPresetFile();
+    CHECK(result.error.empty());
+    CHECK((names(result.preset_file) == std::vector<std::string>{"A", "B"}));
+    CHECK(result.needs_compaction);
+
+    // 圧縮すると壊れた行ごとジャーナルが消え、読み込み直しても同じ内容になる
+    CHECK(manager.finishLoad(result.preset_file, result).is_success);
+    CHECK(!std::filesystem::exists(manager.journalPath()));
+
+    PresetManager reloaded{manager.presetFilePath()};
+    auto reload_result = reloaded.loadPresetFile();
+    CHECK((names(reload_result.preset_file) == std::vector<std::string>{"A", "B"}));
+    CHECK(!reload_result.needs_compaction);
+}
+
+/// @brief 操作を記録して圧縮した後に読み込み直すと、同じ内容と通し番号になること
+void testCompactThenReload()
+{
+    test_util::TempDirectory dir{"journal_compact"};
+    PresetManager manager{dir / "presets.json"};
+
+    preset_file::GradientPresetFile file;
+    file.presets = {makePreset("A"), makePreset("B")};
+    CHECK(manager.writePresetFile(file).is_success);
+
+    CHECK(manager.commitOperation(file, {.type = OperationType::Add, .preset = makePreset("C")}).is_success);
+    CHECK(manager.commitOperation(file, {.type = OperationType::Swap, .index_1 = 0, .index_2 = 2}).is_success);
+    CHECK(manager.commitOperation(file, {.type = OperationType::Overwrite, .index_1 = 1, .preset = makePreset("D", 0x00ff00ff)}).is_success);
+    CHECK(manager.commitOperation(file, {.type = OperationType::Delete, .index_1 = 2}).is_success);
+    CHECK(!manager.commitOperation(file, {.type = OperationType::Delete, .index_1 = 9}).is_success);
+    CHECK((names(file) == std::vector<std::string>{"C", "D"}));
+
+    // 圧縮する前でも、ジャーナルを再生して同じ内容を読み込める
+    {
+        PresetManager reader{manager.presetFilePath()};
+        CHECK((names(reader.loadPresetFile().preset_file) == std::vector<std::string>{"C", "D"}));
+    }
+
+    CHECK(std::filesystem::exists(manager.journalPath()));
+    CHECK(manager.compact(file).is_success);
+    CHECK(!std::filesystem::exists(manager.journalPath()));
+
+    PresetManager reloaded{manager.presetFilePath()};
+    auto result = reloaded.loadPresetFile();
+    CHECK(result.error.empty());
+    CHECK((names(result.preset_file) == std::vector<std::string>{"C", "D"}));
+    CHECK(result.preset_file.presets[1].colors.front() == 0x00ff00ff);
+    CHECK(result.preset_file.journal_seq == 4);
+    CHECK(!result.needs_compaction);
+
+    // 圧縮後の操作は続きの通し番号で記録され、次の読み込みで再生される
+    CHECK(reloaded.commitOperation(result.preset_file, {.type = OperationType::Add, .preset = makePreset("E")}).is_success);
+    PresetManager next{manager.presetFilePath()};
+    CHECK((names(next.loadPresetFile().preset_file) == std::vector<std::string>{"C", "D", "E"}));
+}
+
+/// @brief 記録した操作の数がしきい値に達したら、ファイル全体を書き出してジャーナルを空にすること
+void testCompactionThreshold()
+{
+    test_util::TempDirectory dir{"journal_threshold"};
+    PresetManager manager{dir / "presets.json"};
+
+    preset_file::GradientPresetFile file;
+    file.presets = {makePreset("A"), makePreset("B")};
+    CHECK(manager.writePresetFile(file).is_success);
+
+    for (uint32_t i = 0; i < PresetManager::JOURNAL_COMPACTION_THRESHOLD; ++i) {
+        manager.commitOperation(file, {.type = OperationType::Swap, .index_1 = 0, .index_2 = 1});
+    }
+    CHECK(!std::filesystem::exists(manager.journalPath()));
+
+    PresetManager reloaded{manager.presetFilePath()};
+    auto result = reloaded.loadPresetFile();
+    CHECK(names(result.preset_file) == names(file));
+    CHECK(result.preset_file.journal_seq == PresetManager::JOURNAL_COMPACTION_THRESHOLD);
+}
+}  // namespace
+
+int main()
+{
+    testReplaySkipsAppliedOperations();
+    testReplayToleratesTruncatedLine();
+    testCompactThenReload();
+    testCompactionThreshold();
+    return test_util::result();
+}
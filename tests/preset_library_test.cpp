@@ -0,0 +1,244 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "json.hpp"
+#include "temp_directory.h"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_library.h"
+
+namespace {
+using gradient_editor::PresetLibrary;
+using gradient_editor::TaskPriority;
+using gradient_editor::ThreadPool;
+
+constexpr std::chrono::milliseconds POLL_INTERVAL{5};
+constexpr std::chrono::seconds TIMEOUT{10};
+
+/// @brief 外部のツールと同じく、JSON のみを書き換える
+void writeExternal(const std::filesystem::path& path, const size_t count)
+{
+    preset_file::GradientPresetFile file;
+    file.presets.resize(count);
+    for (size_t i = 0; i < count; ++i) file.presets[i].name = "preset " + std::to_string(i);
+
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".external";
+    {
+        std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+        ofs << nlohmann::ordered_json(file).dump();
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+/// @brief GUI スレッドのフレームと同じく update() を呼び続け、pred が成り立つまで待つ
+/// @param adopted_count 差し替えた回数を加える
+bool updateUntil(PresetLibrary& library, const std::function<bool()>& pred, int* adopted_count = nullptr)
+{
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (library.update() && adopted_count) ++*adopted_count;
+        if (pred()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return false;
+}
+
+/// @brief 何もせずに update() を呼び続け、差し替えた回数を返す
+int updateFor(PresetLibrary& library, const std::chrono::milliseconds duration)
+{
+    int adopted_count   = 0;
+    const auto deadline = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (library.update()) ++adopted_count;
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return adopted_count;
+}
+
+preset_journal::Operation makeAdd(const std::string& name)
+{
+    preset_journal::Operation op;
+    op.type        = preset_journal::OperationType::Add;
+    op.preset.name = name;
+    return op;
+}
+
+/// @brief ワーカースレッドで読み込んだ結果を GUI スレッドで差し替え、自身の書き込みでは読み込み直さないこと
+void testLoadThenAdopt()
+{
+    test_util::TempDirectory dir{"library_adopt"};
+    const auto path = dir / "presets.json";
+    writeExternal(path, 3);
+
+    PresetLibrary library;
+    std::vector<std::string> errors;
+    library.setErrorCallback([&errors](const std::string& error) { errors.push_back(error); });
+    library.start(path, POLL_INTERVAL);
+    CHECK(!library.isLoaded());
+
+    int adopted_count = 0;
+    if (!CHECK(updateUntil(library, [&] { return library.isLoaded(); }, &adopted_count))) return;
+    CHECK(adopted_count == 1);
+    CHECK(library.file().presets.size() == 3);
+    CHECK(library.file().revision == 1);
+    CHECK(!library.isLoading());
+    CHECK(library.manager().knownFileStamps() == library.manager().currentFileStamps());
+
+    // ジャーナルへの追記は監視に検知されるが、自身の書き込みのため読み込み直さない
+    CHECK(library.manager().commitOperation(library.file(), makeAdd("local")).is_success);
+    CHECK(library.file().presets.size() == 4);
+    CHECK(updateFor(library, POLL_INTERVAL * 10) == 0);
+    CHECK(library.file().presets.size() == 4);
+    CHECK(errors.empty());
+
+    library.shutdown();
+}
+
+/// @brief 読み込み中にこちらで書き込んだ場合は結果を捨て、書き込みを含めて読み込み直すこと
+void testDiscardsResultRacingLocalWrite()
+{
+    test_util::TempDirectory dir{"library_race"};
+    const auto path = dir / "presets.json";
+    writeExternal(path, 3);
+
+    PresetLibrary library;
+    library.start(path, POLL_INTERVAL);
+
+    // 結果を受け取る前に書き込む
+    const auto deadline = std::chrono::steady_clock::now() + TIMEOUT;
+    while (library.isLoading() && std::chrono::steady_clock::now() < deadline) std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    CHECK(library.manager().commitOperation(library.file(), makeAdd("racing")).is_success);
+
+    CHECK(!library.update());
+    CHECK(!library.isLoaded());
+
+    if (!CHECK(updateUntil(library, [&] { return library.isLoaded(); }))) return;
+    CHECK(library.file().presets.size() == 4);
+    CHECK(library.file().presets.back().name == "racing");
+    library.shutdown();
+}
+
+/// @brief 外部での変更は、差し替えるまでに何回行われても 1 回の読み込みにまとめること。
+///        変更はスレッドプールから行い、GUI スレッドと並行して書き込む
+void testCoalescesExternalChanges()
+{
+    test_util::TempDirectory dir{"library_coalesce"};
+    const auto path = dir / "presets.json";
+    writeExternal(path, 1);
+
+    ThreadPool pool;
+    pool.start(4);
+
+    PresetLibrary library;
+    std::atomic<int> wakeup_count{0};
+    library.setUpdateCallback([&wakeup_count] { wakeup_count.fetch_add(1, std::memory_order_relaxed); });
+    library.start(path, POLL_INTERVAL);
+    if (!CHECK(updateUntil(library, [&] { return library.isLoaded(); }))) return;
+
+    // 4 つのタスクから書き込む。書き込みどうしは外部のツールと同じく一時ファイルの置き換えで行い、順番はロックで決める
+    constexpr int WRITER_COUNT      = 4;
+    constexpr int WRITES_PER_WRITER = 25;
+    std::mutex write_mutex;
+    size_t last_count = 1;
+    const auto run_writers = [&] {
+        std::vector<std::future<void>> writers;
+        for (int w = 0; w < WRITER_COUNT; ++w) {
+            writers.push_back(pool.async(TaskPriority::Background, [&](std::stop_token) {
+                for (int i = 0; i < WRITES_PER_WRITER; ++i) {
+                    std::lock_guard lock(write_mutex);
+                    last_count = last_count % 50 + 2;
+                    writeExternal(path, last_count);
+                }
+            }));
+        }
+        for (auto& writer : writers) writer.get();
+    };
+
+    // 書き込みの間は update() を呼ばない。変更の検知は溜まるが、読み込みは 1 回にまとまる
+    run_writers();
+    std::this_thread::sleep_for(POLL_INTERVAL * 4);
+    CHECK(wakeup_count.load() > 1);  // 最初の読み込みの完了と、変更の検知
+    int adopted_count = 0;
+    CHECK(updateUntil(library, [&] { return adopted_count > 0 && !library.isLoading(); }, &adopted_count));
+    adopted_count += updateFor(library, POLL_INTERVAL * 10);
+    CHECK(adopted_count == 1);
+    CHECK(library.file().presets.size() == last_count);
+
+    // 書き込みの間も update() を呼び続けた場合、読み込みは書き込みの回数以下で、最後には最新の内容になる
+    adopted_count = 0;
+    auto writers  = std::async(std::launch::async, run_writers);
+    while (writers.wait_for(std::chrono::milliseconds{1}) != std::future_status::ready) {
+        if (library.update()) ++adopted_count;
+    }
+    CHECK(updateUntil(library, [&] { return library.file().presets.size() == last_count && !library.isLoading(); }, &adopted_count));
+    adopted_count += updateFor(library, POLL_INTERVAL * 10);
+    CHECK(adopted_count >= 1);
+    CHECK(adopted_count <= WRITER_COUNT * WRITES_PER_WRITER);
+    CHECK(library.file().presets.size() == last_count);
+
+    library.shutdown();
+    pool.shutdown();
+}
+
+/// @brief 終了時は表示中のプリセットでキャッシュを保存してから、ワーカースレッドを止めてジャーナルを本体に反映すること
+void testShutdownOrder()
+{
+    test_util::TempDirectory dir{"library_shutdown"};
+    const auto path = dir / "presets.json";
+    writeExternal(path, 2);
+
+    PresetLibrary library;
+    library.start(path, POLL_INTERVAL);
+    if (!CHECK(updateUntil(library, [&] { return library.isLoaded(); }))) return;
+    CHECK(library.manager().commitOperation(library.file(), makeAdd("journaled")).is_success);
+    const auto journal_path = library.manager().journalPath();
+    CHECK(std::filesystem::exists(journal_path));
+
+    int save_count = 0;
+    const auto result = library.shutdown([&](const preset_file::GradientPresetFile& file) {
+        ++save_count;
+        CHECK(file.presets.size() == 3);
+        CHECK(std::filesystem::exists(journal_path));  // まだ圧縮していない
+    });
+    CHECK(result.is_success);
+    CHECK(save_count == 1);
+    CHECK(!library.isWatching());
+    CHECK(!std::filesystem::exists(journal_path));
+
+    // 次回の起動ではジャーナルを再生せずに同じ内容になる
+    PresetManager next{path};
+    const auto loaded = next.loadPresetFile();
+    CHECK(loaded.error.empty());
+    CHECK(loaded.preset_file.presets.size() == 3);
+    CHECK(loaded.preset_file.presets.back().name == "journaled");
+
+    // 読み込みを差し替える前に終了した場合はキャッシュを保存せず、ファイルにも書き込まない
+    const auto stamps = next.currentFileStamps();
+    PresetLibrary unloaded;
+    unloaded.start(path, POLL_INTERVAL);
+    CHECK(unloaded.shutdown([&](const preset_file::GradientPresetFile&) { ++save_count; }).is_success);
+    CHECK(save_count == 1);
+    CHECK(!unloaded.isWatching());
+    CHECK(next.currentFileStamps() == stamps);
+}
+}  // namespace
+
+int main()
+{
+    testLoadThenAdopt();
+    testDiscardsResultRacingLocalWrite();
+    testCoalescesExternalChanges();
+    testShutdownOrder();
+    return test_util::result();
+}
@@ -0,0 +1,75 @@
+#include <cstdint>
+
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_list_cache.h"
+
+namespace {
+preset_file::GradientPresetFile makeFile(const size_t count)
+{
+    preset_file::GradientPresetFile file;
+    file.presets.resize(count);
+    for (size_t i = 0; i < count; ++i) file.presets[i].colors = {static_cast<uint32_t>(i), 0xffffffff};
+    return file;
+}
+
+/// @brief 行ごとに 1 回だけ変換し、内容のハッシュが入ること
+void testDecodesEachRowOnce()
+{
+    auto file = makeFile(3);
+    preset_list::RowCache<uint32_t> cache;
+    int decode_count = 0;
+    const auto decode = [&](const preset::GradientPreset& preset) {
+        ++decode_count;
+        return preset.colors[0];
+    };
+
+    CHECK(cache.sync(file));
+    CHECK(cache.size() == 3);
+    for (int frame = 0; frame < 5; ++frame) {
+        CHECK(!cache.sync(file));
+        for (uint32_t i = 0; i < 3; ++i) CHECK(cache.get(file, i, decode).data == i);
+    }
+    CHECK(decode_count == 3);
+
+    const uint64_t hash0 = cache.get(file, 0, decode).content_hash;
+    CHECK(hash0 != 0);
+    CHECK(hash0 != cache.get(file, 1, decode).content_hash);
+}
+
+/// @brief revision か参照するファイルが変わった場合は、すべて変換し直すこと
+void testInvalidatesOnRevisionOrFile()
+{
+    auto file = makeFile(2);
+    preset_list::RowCache<uint32_t> cache;
+    int decode_count  = 0;
+    const auto decode = [&](const preset::GradientPreset& preset) {
+        ++decode_count;
+        return preset.colors[0];
+    };
+
+    cache.sync(file);
+    const uint64_t old_hash = cache.get(file, 1, decode).content_hash;
+
+    file.presets[1].colors[0] = 42;
+    ++file.revision;
+    CHECK(cache.sync(file));
+    CHECK(cache.get(file, 1, decode).data == 42);
+    CHECK(cache.get(file, 1, decode).content_hash != old_hash);
+    CHECK(decode_count == 2);
+
+    auto other = makeFile(4);
+    other.revision = file.revision;
+    CHECK(cache.sync(other));
+    CHECK(cache.size() == 4);
+    CHECK(cache.get(other, 3, decode).data == 3);
+    CHECK(decode_count == 3);
+}
+}  // namespace
+
+int main()
+{
+    testDecodesEachRowOnce();
+    testInvalidatesOnRevisionOrFile();
+    return test_util::result();
+}
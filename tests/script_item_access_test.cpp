@@ -0,0 +1,242 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "core/script_item_access.h"
+#include "fake_edit.h"
+#include "test_util.h"
+
+namespace {
+using gradient_editor::ScriptItemAccess;
+using gradient_editor::SectionRange;
+using test_util::FakeEdit;
+using test_util::FakeObject;
+
+const std::wstring EFFECT_NAME = std::wstring{gradient_editor::EFFECT_NAMES[0]} + gradient_editor::EFFECT_GROUP_NAME;
+
+/// @brief GradientMarkerData と同じ名前のメンバーを持つマーカー
+struct TestMarker {
+    int32_t id = 0;
+    float pos  = 0.0f;
+    struct {
+        float x, y, z, w;
+    } color{1.0f, 1.0f, 1.0f, 1.0f};
+    struct {
+        float ratio;
+    } midpoint{0.5f};
+};
+
+const std::vector<TestMarker> MARKERS = {
+    {.id = 0, .pos = 0.25f, .color = {1.0f, 0.0f, 0.0f, 1.0f}, .midpoint = {0.5f}},
+    {.id = 1, .pos = 0.75f, .color = {0.0f, 0.0f, 1.0f, 0.5f}, .midpoint = {0.5f}},
+};
+
+std::string_view itemValue(const FakeObject& object, std::string_view key)
+{
+    static alias_parser::AliasDocument document;
+    document.parse(object.alias);
+    const auto* section = document.findSection("Object.0");
+    if (!section) return {};
+    return document.getValue(*section, key).value_or(std::string_view{});
+}
+
+std::string_view u8view(const char8_t* text)
+{
+    return reinterpret_cast<const char*>(text);
+}
+
+/// @brief 選択オブジェクトの最後のセクションへの反映で、セクションの少ないリンク先が 1 値に潰れないこと
+void testLinkedObjectKeepsSections()
+{
+    FakeEdit edit;
+    FakeObject focused{test_util::makeGradientAlias(4, 2)};
+    FakeObject linked{test_util::makeGradientAlias(2, 2)};
+
+    ScriptItemAccess items;
+    items.stageGradient(MARKERS, 1.0f, 0, 0, SectionRange::single(3));
+    items.writeStaged(&edit, &focused, EFFECT_NAME, 0);
+    CHECK(items.sectionCount() == 4);
+    items.writeStaged(&edit, &linked, EFFECT_NAME, 0);
+    CHECK(items.sectionCount() == 2);
+
+    CHECK(itemValue(focused, u8view(u8"位置1")) == "0,0,0,25");
+    CHECK(itemValue(focused, u8view(u8"透明度2")) == "0,0,0,50");
+    CHECK(itemValue(focused, u8view(u8"マーカー数")) == "2,2,2,2");
+
+    // リンク先は自身の最後のセクションに反映され、それ以外のセクションは残る
+    CHECK(itemValue(linked, u8view(u8"位置1")) == "0,25");
+    CHECK(itemValue(linked, u8view(u8"位置2")) == "0,75");
+    CHECK(itemValue(linked, u8view(u8"透明度2")) == "0,50");
+
+    // セクションを持たない項目は 1 値のまま
+    CHECK(itemValue(linked, u8view(u8"色1")) == "ff0000");
+    CHECK(itemValue(linked, u8view(u8"色2")) == "0000ff");
+
+    // すべてのセクションへの反映
+    items.stageGradient(MARKERS, 1.0f, 0, 0, SectionRange::all());
+    items.writeStaged(&edit, &linked, EFFECT_NAME, 0);
+    CHECK(itemValue(linked, u8view(u8"位置1")) == "25,25");
+}
+
+/// @brief マーカー数を減らしたとき、リンク先に残った分も自身のセクション数の範囲でリセットすること
+void testResetLinkedObject()
+{
+    FakeEdit edit;
+    FakeObject linked{test_util::makeGradientAlias(2, 4, "7")};
+
+    ScriptItemAccess items;
+    items.open(&edit, &linked, EFFECT_NAME, 0);
+    items.resetMarkers(&edit, &linked, 2, 4, SectionRange::single(3), 30);
+
+    CHECK(itemValue(linked, u8view(u8"位置1")) == "7,7");
+    CHECK(itemValue(linked, u8view(u8"位置3")) == "7,0");
+    CHECK(itemValue(linked, u8view(u8"透明度4")) == "7,0");
+    CHECK(edit.writes.size() == 4);  // 位置と透明度。色と中間点は初期値のまま
+    for (const auto& write : edit.writes) CHECK(write.effect_key == EFFECT_NAME + L":0");
+}
+
+/// @brief エイリアスにない項目は get_object_item_value() で読み書きすること
+void testFallbackWithoutAlias()
+{
+    FakeEdit edit;
+    FakeObject object{test_util::makeGradientAlias(3, 2, "4")};
+
+    ScriptItemAccess items;
+    // エフェクトのインデックスが合わない場合はエイリアスのセクションが見つからない
+    items.open(&edit, &object, EFFECT_NAME, 0);
+    CHECK(items.readItem(&edit, &object, gradient_editor::ScriptItemKeys::instance().position(0), 0.0f, 2) == 4.0f);
+    CHECK(edit.get_call_count == 0);
+
+    items.open(&edit, &object, EFFECT_NAME, 1);
+    CHECK(items.readItem(&edit, &object, gradient_editor::ScriptItemKeys::instance().position(0), -1.0f, 2) == -1.0f);
+    CHECK(edit.get_call_count == 1);
+}
+
+/// @brief すべてのセクションへの反映は、セクションの数によらず項目ごとに 1 回だけ書き込むこと
+void testApplyAllSectionsWritesEachItemOnce()
+{
+    FakeEdit edit;
+    FakeObject object{test_util::makeGradientAlias(4, 3)};
+    const std::vector<TestMarker> markers = {
+        {.id = 0, .pos = 0.0f, .color = {1.0f, 0.0f, 0.0f, 1.0f}, .midpoint = {0.5f}},
+        {.id = 1, .pos = 0.5f, .color = {0.0f, 1.0f, 0.0f, 0.5f}, .midpoint = {0.25f}},
+        {.id = 2, .pos = 1.0f, .color = {0.0f, 0.0f, 1.0f, 1.0f}, .midpoint = {0.5f}},
+    };
+
+    ScriptItemAccess items;
+    items.stageGradient(markers, 1.0f, 0, 0, SectionRange::all());
+    items.writeStaged(&edit, &object, EFFECT_NAME, 0);
+
+    // 値が変わる項目: 色 3 つ、透明度2、位置2,3、中間点2。
+    // マーカー数、透明度1,3、位置1、中間点1、ぼかし幅、色空間、補間経路は元の値のまま
+    CHECK(edit.writes.size() == 7);
+    CHECK(edit.set_call_count == edit.writes.size());
+    CHECK(edit.get_call_count == 0);
+    for (size_t i = 0; i < edit.writes.size(); ++i) {
+        CHECK(edit.writes[i].object == &object);
+        CHECK(edit.writes[i].effect_key == EFFECT_NAME + L":0");
+        for (size_t j = 0; j < i; ++j) CHECK(edit.writes[i].item_name != edit.writes[j].item_name);
+    }
+
+    // セクションを持つ項目は、すべてのセクションが同じ値の 1 行になる
+    CHECK(itemValue(object, u8view(u8"マーカー数")) == "3,3,3,3");
+    CHECK(itemValue(object, u8view(u8"位置2")) == "50,50,50,50");
+    CHECK(itemValue(object, u8view(u8"位置3")) == "100,100,100,100");
+    CHECK(itemValue(object, u8view(u8"透明度2")) == "50,50,50,50");
+    CHECK(itemValue(object, u8view(u8"位置1")) == "0,0,0,0");
+    CHECK(itemValue(object, u8view(u8"中間点2")) == "25");
+    CHECK(itemValue(object, u8view(u8"色3")) == "0000ff");
+
+    // 同じ値を再度反映しても書き込まない
+    edit.clearCalls();
+    items.writeStaged(&edit, &object, EFFECT_NAME, 0);
+    CHECK(edit.set_call_count == 0);
+
+    // 範囲への反映は、範囲外のセクションを残したまま項目ごとに 1 回
+    items.stageGradient(markers, 1.0f, 0, 0, SectionRange{.first = 1, .last = 2});
+    object.alias = test_util::makeGradientAlias(4, 3, "7");
+    items.writeStaged(&edit, &object, EFFECT_NAME, 0);
+    CHECK(edit.writes.size() == 10);  // 上の 7 項目と、7 から変わる位置1、透明度1,3
+    CHECK(itemValue(object, u8view(u8"位置2")) == "7,50,50,7");
+    CHECK(itemValue(object, u8view(u8"透明度1")) == "7,0,0,7");
+}
+
+/// @brief ScriptBridge::loadGradientFromScript() と同じ順序で、すべての項目を読み込む
+float loadAll(ScriptItemAccess& items, FakeEdit& edit, FakeObject& object, const uint32_t section_index)
+{
+    const auto& keys = gradient_editor::ScriptItemKeys::instance();
+    items.open(&edit, &object, EFFECT_NAME, 0);
+
+    float sum             = 0.0f;
+    uint32_t marker_count = items.readItem(&edit, &object, keys.markerCount(), 2u, section_index);
+    for (uint32_t id = 0; id < marker_count; ++id) {
+        sum += items.readItem(&edit, &object, keys.position(id), 0.0f, section_index);
+        sum += static_cast<float>(items.readItem(&edit, &object, keys.color(id), 0xffffffu, 0, 16));
+        sum += items.readItem(&edit, &object, keys.alpha(id), 0.0f, section_index);
+        if (id + 1 < marker_count) sum += items.readItem(&edit, &object, keys.midpoint(id), 0.0f);
+    }
+    sum += items.readItem(&edit, &object, keys.blurWidth(), 100.0f);
+    sum += static_cast<float>(items.readItem(&edit, &object, keys.colorSpace(), std::string_view{gradient_editor::COLOR_SPACE_NAMES[0]}).size());
+    sum += static_cast<float>(items.readItem(&edit, &object, keys.interpDir(), std::string_view{gradient_editor::INTERP_DIR_NAMES[0]}).size());
+    return sum;
+}
+
+/// @brief 一度反映と読み込みを行った後は、選択オブジェクトとリンク先への反映と読み込みでヒープ確保が起きないこと
+void testApplyAndLoadDoNotAllocate()
+{
+    constexpr uint32_t LOAD_MARKER_COUNT = 30;
+
+    // 反映のたびに値が変わるよう、位置と色の異なる 2 通りのマーカーを交互に反映する
+    std::vector<TestMarker> markers[2];
+    for (uint32_t i = 0; i < LOAD_MARKER_COUNT; ++i) {
+        const float pos = static_cast<float>(i) / static_cast<float>(LOAD_MARKER_COUNT - 1);
+        markers[0].push_back({.id = static_cast<int32_t>(i), .pos = pos, .color = {pos, 0.5f, 0.25f, 1.0f}, .midpoint = {0.5f}});
+        markers[1].push_back({.id = static_cast<int32_t>(i), .pos = pos * 0.5f, .color = {0.25f, pos, 0.5f, 0.75f}, .midpoint = {0.25f}});
+    }
+
+    FakeEdit edit;
+    edit.is_recording = false;
+    FakeObject focused{test_util::makeGradientAlias(4, LOAD_MARKER_COUNT)};
+    FakeObject linked{test_util::makeGradientAlias(2, LOAD_MARKER_COUNT)};
+
+    ScriptItemAccess items;
+    const auto apply = [&](const std::vector<TestMarker>& gradient, const SectionRange sections) {
+        items.stageGradient(gradient, 1.0f, 3, 1, sections);
+        items.writeStaged(&edit, &focused, EFFECT_NAME, 0);
+        items.writeStaged(&edit, &linked, EFFECT_NAME, 0);
+    };
+
+    // 1 回目で、項目名のテーブル、エイリアスの索引、値の文字列などの領域を確保する。
+    // 変更後の値の文字列は行ごとに使い回すため、どちらのマーカーもすべてのセクションへ一度反映しておく
+    apply(markers[0], SectionRange::all());
+    apply(markers[1], SectionRange::all());
+    loadAll(items, edit, focused, 3);
+    edit.clearCalls();
+
+    test_util::AllocationCounter counter;
+    float sum = 0.0f;
+    for (uint32_t i = 0; i < 10; ++i) {
+        apply(markers[i % 2], i % 3 == 0 ? SectionRange::all() : SectionRange::single(i % 4));
+        sum += loadAll(items, edit, focused, i % 4);
+        sum += loadAll(items, edit, linked, i % 2);
+    }
+    CHECK(counter.count() == 0);
+
+    // 値を書き込み、エイリアスから読み込めていること
+    CHECK(edit.set_call_count > 0);
+    CHECK(edit.get_call_count == 0);
+    CHECK(sum > 0.0f);
+}
+}  // namespace
+
+int main()
+{
+    testLinkedObjectKeepsSections();
+    testResetLinkedObject();
+    testFallbackWithoutAlias();
+    testApplyAllSectionsWritesEachItemOnce();
+    testApplyAndLoadDoNotAllocate();
+    return test_util::result();
+}
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "alloc_counter.h"
+#include "core/script_item_keys.h"
+#include "test_util.h"
+#include "utils/aviutl2/alias_parser.h"
+#include "utils/aviutl2/item_value.h"
+
+namespace {
+using gradient_editor::EffectKeyBuffer;
+using gradient_editor::ScriptItemKeys;
+
+/// @brief テーブルを生成した後は、項目名の取得でヒープ確保が起きないこと
+void testKeysDoNotAllocate()
+{
+    const ScriptItemKeys& keys     = ScriptItemKeys::instance();
+    const std::wstring effect_name = std::wstring{gradient_editor::EFFECT_NAMES[0]} + gradient_editor::EFFECT_GROUP_NAME;
+
+    test_util::AllocationCounter counter;
+    size_t total_size = 0;
+    for (uint32_t id = 0; id < gradient_editor::MAX_MARKER_COUNT; ++id) {
+        total_size += keys.position(id).alias_name.size() + keys.color(id).alias_name.size();
+        total_size += keys.alpha(id).alias_name.size() + keys.midpoint(id).alias_name.size();
+    }
+    const wchar_t* effect_key = keys.effectWithIndex(effect_name, 3);
+    total_size += keys.effectAliasName(effect_name).size();
+    CHECK(counter.count() == 0);
+
+    CHECK(total_size > 0);
+    CHECK(!keys.position(gradient_editor::MAX_MARKER_COUNT));
+    CHECK(keys.position(0).alias_name == reinterpret_cast<const char*>(u8"位置1"));
+    CHECK(std::wstring_view{keys.color(11).name} == L"色12");
+    CHECK(effect_key && std::wstring_view{effect_key} == effect_name + L":3");
+    CHECK(!keys.effectWithIndex(effect_name, ScriptItemKeys::MAX_EFFECT_INDEX));
+}
+
+/// @brief テーブル外のインデックスは組み立てるが、2 回目以降はバッファを使い回すこと
+void testEffectKeyBufferReuses()
+{
+    const std::wstring effect_name = std::wstring{gradient_editor::EFFECT_NAMES[0]} + gradient_editor::EFFECT_GROUP_NAME;
+    EffectKeyBuffer buffer;
+    CHECK(std::wstring_view{buffer.get(effect_name, 100)} == effect_name + L":100");
+
+    test_util::AllocationCounter counter;
+    const wchar_t* key = buffer.get(effect_name, 123);
+    CHECK(counter.count() == 0);
+    CHECK(std::wstring_view{key} == effect_name + L":123");
+}
+
+/// @brief 値の文字列への変換と 1 行分の組み立てでヒープ確保が起きないこと
+void testFormatItemValueDoesNotAllocate()
+{
+    plugin2_utils::ValueBuffer buf;
+    const std::string text = "linear";
+
+    // スレッドごとのバッファを確保させておく
+    plugin2_utils::itemLineBuffer().reserve(256);
+
+    test_util::AllocationCounter counter;
+    const bool is_int_ok    = plugin2_utils::formatItemValue(buf, 12, 0) == "12";
+    const bool is_hex_ok    = plugin2_utils::formatItemValue(buf, 0xFFAA00, 0, 16) == "ffaa00";
+    const bool is_double_ok = plugin2_utils::formatItemValue(buf, 0.5, 0.0) == "0.5";
+    const bool is_float_ok  = plugin2_utils::formatItemValue(buf, 12.25f, 0.0f) == "12.25";
+    const bool is_string_ok = plugin2_utils::formatItemValue(buf, text, std::string{}).data() == text.data();
+
+    std::string& line = plugin2_utils::itemLineBuffer();
+    alias_parser::appendReplacedTokenRange(line, "0.000,12.000,0.500", 1, 2, plugin2_utils::formatItemValue(buf, 3.5, 0.0));
+    CHECK(counter.count() == 0);
+
+    CHECK(is_int_ok);
+    CHECK(is_hex_ok);
+    CHECK(is_double_ok);
+    CHECK(is_float_ok);
+    CHECK(is_string_ok);
+    CHECK(line == "0.000,3.5,3.5");
+
+    // 基数が範囲外の場合は "0"
+    CHECK(plugin2_utils::formatItemValue(buf, 12, 0, 99) == "0");
+}
+}  // namespace
+
+int main()
+{
+    testKeysDoNotAllocate();
+    testEffectKeyBufferReuses();
+    testFormatItemValueDoesNotAllocate();
+    return test_util::result();
+}
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/startup_phases.h"
+#include "test_util.h"
+
+namespace {
+using gradient_editor::StartupPhases;
+using namespace std::chrono_literals;
+
+/// @brief 進めた分だけ時刻が変わる時計
+struct FakeClock {
+    StartupPhases::TimePoint now = StartupPhases::TimePoint{} + 100s;
+
+    std::function<StartupPhases::TimePoint()> function()
+    {
+        return [this] { return now; };
+    }
+};
+
+/// @brief 予約した順に実行し、フェーズごとの所要時間と待ち時間を記録すること
+void testRunAndMark()
+{
+    FakeClock clock;
+    StartupPhases phases{clock.function()};
+    std::vector<std::string> order;
+
+    clock.now += 2ms;
+    phases.mark("window");
+    clock.now += 800ms;
+    phases.mark("wait_visible", true);
+
+    phases.add("d3d", [&] {
+        order.emplace_back("d3d");
+        clock.now += 35ms;
+        return true;
+    });
+    phases.add("fonts", [&] {
+        order.emplace_back("fonts");
+        clock.now += 10ms;
+        return true;
+    });
+    CHECK(phases.hasPending());
+    CHECK(phases.runPending());
+    CHECK(!phases.hasPending());
+    CHECK(!phases.hasFailed());
+    CHECK((order == std::vector<std::string>{"d3d", "fonts"}));
+
+    // フェーズの後の mark() は最後のフェーズの終了からの時間になる
+    clock.now += 5ms;
+    phases.mark("presets");
+
+    const auto& timings = phases.timings();
+    CHECK(timings.size() == 5);
+    if (timings.size() == 5) {
+        CHECK(std::string{timings[0].name} == "window" && timings[0].duration == 2ms && !timings[0].is_wait);
+        CHECK(std::string{timings[1].name} == "wait_visible" && timings[1].duration == 800ms && timings[1].is_wait);
+        CHECK(std::string{timings[2].name} == "d3d" && timings[2].duration == 35ms && timings[2].is_success);
+        CHECK(std::string{timings[3].name} == "fonts" && timings[3].duration == 10ms);
+        CHECK(std::string{timings[4].name} == "presets" && timings[4].duration == 5ms);
+    }
+    CHECK(phases.busyTime() == 52ms);
+    CHECK(phases.report() == "window 2.00 ms, (wait_visible 800.00 ms), d3d 35.00 ms, fonts 10.00 ms, presets 5.00 ms / busy 52.00 ms");
+}
+
+/// @brief 失敗したフェーズで止まり、以降のフェーズは後から runPending() しても実行しないこと
+void testStopsAtFailure()
+{
+    FakeClock clock;
+    StartupPhases phases{clock.function()};
+    int run_count = 0;
+
+    phases.add("first", [&] {
+        ++run_count;
+        clock.now += 1ms;
+        return true;
+    });
+    phases.add("broken", [&] {
+        ++run_count;
+        clock.now += 3ms;
+        return false;
+    });
+    phases.add("never", [&] {
+        ++run_count;
+        return true;
+    });
+
+    CHECK(!phases.runPending());
+    CHECK(phases.hasFailed());
+    CHECK(run_count == 2);
+    CHECK(!phases.runPending());
+    CHECK(run_count == 2);
+
+    CHECK(phases.timings().size() == 2);
+    if (phases.timings().size() == 2) CHECK(!phases.timings()[1].is_success);
+    CHECK(phases.report() == "first 1.00 ms, broken 3.00 ms FAILED / busy 4.00 ms");
+}
+
+/// @brief 実行し終えたフェーズの後に予約したフェーズだけを実行すること
+void testAddAfterRun()
+{
+    FakeClock clock;
+    StartupPhases phases{clock.function()};
+    int first_count  = 0;
+    int second_count = 0;
+
+    phases.add("first", [&] {
+        ++first_count;
+        return true;
+    });
+    CHECK(phases.runPending());
+    phases.add("second", [&] {
+        ++second_count;
+        return true;
+    });
+    CHECK(phases.runPending());
+    CHECK(first_count == 1);
+    CHECK(second_count == 1);
+    CHECK(phases.timings().size() == 2);
+}
+}  // namespace
+
+int main()
+{
+    testRunAndMark();
+    testStopsAtFailure();
+    testAddAfterRun();
+    return test_util::result();
+}
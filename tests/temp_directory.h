@@ -0,0 +1,40 @@
+#ifndef TEMP_DIRECTORY_H
+#define TEMP_DIRECTORY_H
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+/// @brief テストごとの一時ディレクトリ。作成時に中身を空にし、破棄するときに削除する
+namespace test_util {
+
+class TempDirectory {
+public:
+    explicit TempDirectory(std::string_view name)
+        : m_path{std::filesystem::temp_directory_path() / ("gradient_editor_" + std::string{name})}
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+        std::filesystem::create_directories(m_path);
+    }
+
+    ~TempDirectory()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(m_path, ec);
+    }
+
+    TempDirectory(const TempDirectory&)            = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return m_path; }
+    [[nodiscard]] std::filesystem::path operator/(std::string_view file_name) const { return m_path / file_name; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+}  // namespace test_util
+
+#endif  // !TEMP_DIRECTORY_H
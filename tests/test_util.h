@@ -0,0 +1,32 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdio>
+
+/// @brief テストで使う最小限の検査
+/// @note 失敗しても続行し、最後に result() の戻り値を main() から返す
+namespace test_util {
+
+inline int g_failure_count = 0;
+
+inline bool check(const bool is_ok, const char* expr, const char* file, const int line)
+{
+    if (!is_ok) {
+        ++g_failure_count;
+        std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+    return is_ok;
+}
+
+inline int result()
+{
+    if (g_failure_count == 0) return 0;
+    std::fprintf(stderr, "%d check(s) failed\n", g_failure_count);
+    return 1;
+}
+
+}  // namespace test_util
+
+#define CHECK(expr) test_util::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#endif  // !TEST_UTIL_H
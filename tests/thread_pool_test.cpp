@@ -0,0 +1,281 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <semaphore>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/thread_pool.h"
+#include "test_util.h"
+
+namespace {
+using gradient_editor::TaskPriority;
+using gradient_editor::ThreadPool;
+
+constexpr auto WAIT_TIMEOUT = std::chrono::seconds{10};
+
+/// @brief ワーカーを塞ぐタスク。open() するまで戻らない
+class Gate {
+public:
+    /// @brief ワーカーを塞ぎ、塞いだことを確かめてから戻る
+    bool block(ThreadPool& pool)
+    {
+        pool.submit(TaskPriority::Interactive, [this](std::stop_token) {
+            m_entered.release();
+            m_open.acquire();
+        });
+        return m_entered.try_acquire_for(WAIT_TIMEOUT);
+    }
+
+    void open() { m_open.release(); }
+
+private:
+    std::binary_semaphore m_entered{0};
+    std::binary_semaphore m_open{0};
+};
+
+/// @brief 実行した順に名前を記録する
+class OrderLog {
+public:
+    void push(std::string name)
+    {
+        std::lock_guard lock(m_mutex);
+        m_names.push_back(std::move(name));
+    }
+
+    [[nodiscard]] std::vector<std::string> names()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_names;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_names;
+};
+
+bool isBrokenPromise(std::future<void>& future)
+{
+    if (future.wait_for(WAIT_TIMEOUT) != std::future_status::ready) return false;
+    try {
+        future.get();
+    } catch (const std::future_error& e) {
+        return e.code() == std::future_errc::broken_promise;
+    }
+    return false;
+}
+
+/// @brief Interactive のタスクは、先に積まれた Background のタスクより先に実行すること。同じ優先度では積んだ順
+void testPriorityOrder()
+{
+    ThreadPool pool;
+    pool.start(1);
+    Gate gate;
+    if (!CHECK(gate.block(pool))) return;
+
+    OrderLog log;
+    std::vector<std::future<void>> futures;
+    for (const char* name : {"b0", "b1", "b2"}) {
+        futures.push_back(pool.async(TaskPriority::Background, [&log, name](std::stop_token) { log.push(name); }));
+    }
+    for (const char* name : {"i0", "i1", "i2"}) {
+        futures.push_back(pool.async(TaskPriority::Interactive, [&log, name](std::stop_token) { log.push(name); }));
+    }
+    gate.open();
+    for (auto& future : futures) CHECK(future.wait_for(WAIT_TIMEOUT) == std::future_status::ready);
+
+    CHECK((log.names() == std::vector<std::string>{"i0", "i1", "i2", "b0", "b1", "b2"}));
+}
+
+/// @brief ワーカーが自身のキューに積んだ Background のタスクより、共有のキューの Interactive のタスクを先に実行すること
+void testInteractiveAcrossQueues()
+{
+    ThreadPool pool;
+    pool.start(1);
+
+    OrderLog log;
+    std::binary_semaphore queued{0};
+    std::binary_semaphore release{0};
+    std::promise<void> done;
+    pool.submit(TaskPriority::Interactive, [&](std::stop_token) {
+        // ワーカーから積んだタスクはこのワーカーのキューに入る
+        pool.submit(TaskPriority::Background, [&](std::stop_token) {
+            log.push("own first");
+            done.set_value();
+        });
+        pool.submit(TaskPriority::Background, [&log](std::stop_token) { log.push("own second"); });
+        queued.release();
+        release.acquire();
+    });
+    if (!CHECK(queued.try_acquire_for(WAIT_TIMEOUT))) return;
+    pool.submit(TaskPriority::Interactive, [&log](std::stop_token) { log.push("shared interactive"); });
+    release.release();
+
+    CHECK(done.get_future().wait_for(WAIT_TIMEOUT) == std::future_status::ready);
+    // 自身のキューは後ろから取る
+    CHECK((log.names() == std::vector<std::string>{"shared interactive", "own second", "own first"}));
+}
+
+/// @brief 実行前に取り消したタスクは実行せず、future は broken_promise になること。実行中のタスクは stop_token で止められること
+void testCancellation()
+{
+    ThreadPool pool;
+    pool.start(1);
+    Gate gate;
+    if (!CHECK(gate.block(pool))) return;
+
+    std::stop_source cancel;
+    std::atomic<int> run_count{0};
+    std::vector<std::future<void>> cancelled;
+    for (int i = 0; i < 8; ++i) {
+        cancelled.push_back(pool.async(TaskPriority::Background, [&run_count](std::stop_token) { run_count.fetch_add(1); }, cancel.get_token()));
+    }
+    auto kept = pool.async(TaskPriority::Background, [&run_count](std::stop_token) { run_count.fetch_add(100); });
+    cancel.request_stop();
+    gate.open();
+
+    CHECK(kept.wait_for(WAIT_TIMEOUT) == std::future_status::ready);
+    for (auto& future : cancelled) CHECK(isBrokenPromise(future));
+    CHECK(run_count.load() == 100);
+
+    // 実行中のタスクは渡された stop_token を見て自ら終わる
+    std::stop_source running_cancel;
+    std::binary_semaphore started{0};
+    auto running = pool.async(
+        TaskPriority::Interactive,
+        [&started](const std::stop_token stop_token) {
+            started.release();
+            int spins = 0;
+            while (!stop_token.stop_requested()) {
+                std::this_thread::yield();
+                ++spins;
+            }
+            return spins;
+        },
+        running_cancel.get_token());
+    if (!CHECK(started.try_acquire_for(WAIT_TIMEOUT))) return;
+    running_cancel.request_stop();
+    CHECK(running.wait_for(WAIT_TIMEOUT) == std::future_status::ready);
+}
+
+/// @brief 塞がれたワーカーのキューに積まれたタスクは、他のワーカーが取って実行すること
+void testWorkStealing()
+{
+    constexpr int CHILD_COUNT = 16;
+    ThreadPool pool;
+    pool.start(4);
+
+    std::mutex mutex;
+    std::vector<std::thread::id> child_threads;
+    std::counting_semaphore<CHILD_COUNT> children_done{0};
+    std::thread::id parent_thread;
+    bool is_all_done = false;
+
+    auto parent = pool.async(TaskPriority::Interactive, [&](std::stop_token) {
+        parent_thread = std::this_thread::get_id();
+        // このワーカーのキューに積む。自身は完了を待って塞がっているため、他のワーカーが取らない限り実行されない
+        for (int i = 0; i < CHILD_COUNT; ++i) {
+            pool.submit(TaskPriority::Background, [&](std::stop_token) {
+                {
+                    std::lock_guard lock(mutex);
+                    child_threads.push_back(std::this_thread::get_id());
+                }
+                children_done.release();
+            });
+        }
+        is_all_done = true;
+        for (int i = 0; i < CHILD_COUNT; ++i) is_all_done = is_all_done && children_done.try_acquire_for(WAIT_TIMEOUT);
+    });
+    CHECK(parent.wait_for(WAIT_TIMEOUT * 2) == std::future_status::ready);
+
+    CHECK(is_all_done);
+    std::lock_guard lock(mutex);
+    CHECK(child_threads.size() == CHILD_COUNT);
+    for (const auto& id : child_threads) CHECK(id != parent_thread);
+}
+
+/// @brief shutdown() は実行中のタスクの終了を待ち、積まれているタスクは実行せずに破棄すること。その後も開始し直せること
+void testShutdownWithQueuedWork()
+{
+    ThreadPool pool;
+    pool.start(2);
+
+    // どちらのワーカーも、プールの停止を stop_token で受け取るまで戻らないタスクで塞ぐ
+    std::counting_semaphore<2> entered{0};
+    std::atomic<int> finished_count{0};
+    for (int i = 0; i < 2; ++i) {
+        pool.submit(TaskPriority::Interactive, [&](const std::stop_token stop_token) {
+            entered.release();
+            while (!stop_token.stop_requested()) std::this_thread::yield();
+            std::this_thread::sleep_for(std::chrono::milliseconds{20});
+            finished_count.fetch_add(1);
+        });
+    }
+    for (int i = 0; i < 2; ++i) CHECK(entered.try_acquire_for(WAIT_TIMEOUT));
+
+    std::atomic<int> run_count{0};
+    std::vector<std::future<void>> queued;
+    std::stop_source never_cancelled;
+    for (int i = 0; i < 100; ++i) {
+        const auto priority = i % 2 == 0 ? TaskPriority::Interactive : TaskPriority::Background;
+        // stop_token を渡したタスクも、停止後は実行しない
+        auto token = i % 3 == 0 ? never_cancelled.get_token() : std::stop_token{};
+        queued.push_back(pool.async(priority, [&run_count](std::stop_token) { run_count.fetch_add(1); }, std::move(token)));
+    }
+
+    pool.shutdown();
+    CHECK(finished_count.load() == 2);
+    CHECK(pool.threadCount() == 0);
+    CHECK(run_count.load() == 0);
+    for (auto& future : queued) CHECK(isBrokenPromise(future));
+
+    pool.start(2);
+    auto after_restart = pool.async(TaskPriority::Background, [](std::stop_token) { return 42; });
+    CHECK(after_restart.wait_for(WAIT_TIMEOUT) == std::future_status::ready && after_restart.get() == 42);
+}
+
+/// @brief 多数のスレッドから積んだタスクを、すべて 1 度ずつ実行すること
+void testSubmitFromManyThreads()
+{
+    constexpr int PRODUCER_COUNT = 4;
+    constexpr int TASKS_PER      = 5000;
+    ThreadPool pool;
+    pool.start(4);
+
+    std::atomic<int> run_count{0};
+    std::counting_semaphore<PRODUCER_COUNT * TASKS_PER> done{0};
+    {
+        std::vector<std::jthread> producers;
+        for (int p = 0; p < PRODUCER_COUNT; ++p) {
+            producers.emplace_back([&pool, &run_count, &done, p] {
+                for (int i = 0; i < TASKS_PER; ++i) {
+                    const auto priority = (i + p) % 2 == 0 ? TaskPriority::Interactive : TaskPriority::Background;
+                    pool.submit(priority, [&run_count, &done](std::stop_token) {
+                        run_count.fetch_add(1);
+                        done.release();
+                    });
+                }
+            });
+        }
+    }
+    bool is_all_done = true;
+    for (int i = 0; i < PRODUCER_COUNT * TASKS_PER && is_all_done; ++i) is_all_done = done.try_acquire_for(WAIT_TIMEOUT);
+    CHECK(is_all_done);
+    CHECK(run_count.load() == PRODUCER_COUNT * TASKS_PER);
+}
+}  // namespace
+
+int main()
+{
+    testPriorityOrder();
+    testInteractiveAcrossQueues();
+    testCancellation();
+    testWorkStealing();
+    testShutdownWithQueuedWork();
+    testSubmitFromManyThreads();
+    return test_util::result();
+}
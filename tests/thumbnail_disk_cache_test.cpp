@@ -0,0 +1,167 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "temp_directory.h"
+#include "test_util.h"
+#include "ui/widgets/gradient_preset.h"
+#include "ui/widgets/preset_hash.h"
+#include "ui/widgets/thumbnail_disk_cache.h"
+
+namespace {
+using thumbnail_cache::ThumbnailDiskCache;
+
+constexpr uint64_t RENDERER_ID = 0x1234;
+
+std::vector<std::byte> makePixels(const int32_t width, const int32_t height, const uint8_t value)
+{
+    return std::vector<std::byte>(static_cast<size_t>(width) * height * 4, std::byte{value});
+}
+
+bool isFilled(const std::span<const std::byte> pixels, const size_t size, const uint8_t value)
+{
+    if (pixels.size() != size) return false;
+    for (const std::byte b : pixels) {
+        if (b != std::byte{value}) return false;
+    }
+    return true;
+}
+
+preset::GradientPreset makePreset()
+{
+    preset::GradientPreset preset;
+    preset.name      = "thumbnail";
+    preset.colors    = {0xff0000ff, 0x0000ffff};
+    preset.positions = {0.0f, 1.0f};
+    preset.midpoints = {0.5f};
+    return preset;
+}
+
+uint64_t hashOf(const preset::GradientPreset& preset)
+{
+    return preset_hash::contentHash(preset_hash::canonicalize(preset));
+}
+
+/// @brief キーは内容のハッシュとピクセルサイズで、名前の変更では無効にならず、内容かサイズが変わると無効になること
+void testKeyAndInvalidation()
+{
+    ThumbnailDiskCache cache;
+    const auto preset = makePreset();
+    cache.store(hashOf(preset), 160, 20, makePixels(160, 20, 7));
+    CHECK(cache.isDirty());
+
+    CHECK(isFilled(cache.find(hashOf(preset), 160, 20), 160 * 20 * 4, 7));
+
+    // 名前はキーに含めない
+    auto renamed = preset;
+    renamed.name = "renamed";
+    CHECK(!cache.find(hashOf(renamed), 160, 20).empty());
+
+    // 内容が変わった
+    auto recolored      = preset;
+    recolored.colors[1] = 0x00ff00ff;
+    CHECK(cache.find(hashOf(recolored), 160, 20).empty());
+
+    // サイズが変わった
+    CHECK(cache.find(hashOf(preset), 161, 20).empty());
+    CHECK(cache.find(hashOf(preset), 160, 21).empty());
+
+    // 範囲外のサイズと、サイズに合わないピクセルは登録しない
+    cache.store(1, 0, 20, {});
+    cache.store(2, 70000, 1, makePixels(70000, 1, 1));
+    cache.store(3, 4, 4, makePixels(4, 3, 1));
+    CHECK(cache.size() == 1);
+}
+
+/// @brief 保存したものを次の起動で読み込めること。存在しないプリセットのもの、古いサイズのものは保存しないこと
+void testSaveAndLoad()
+{
+    test_util::TempDirectory dir{"thumbnail_save"};
+    const auto path = dir / "presets.thumbnails";
+
+    ThumbnailDiskCache cache;
+    CHECK(!cache.load(path, RENDERER_ID));  // 初回の起動
+    cache.store(1, 160, 20, makePixels(160, 20, 1));
+    cache.store(2, 160, 20, makePixels(160, 20, 2));
+    cache.store(2, 200, 20, makePixels(200, 20, 3));  // ウィンドウの幅を変えた
+    cache.store(3, 160, 20, makePixels(160, 20, 4));  // 削除されたプリセット
+    CHECK(cache.save(path, [](const uint64_t hash) { return hash != 3; }));
+    CHECK(!cache.isDirty());
+
+    ThumbnailDiskCache next;
+    CHECK(next.load(path, RENDERER_ID));
+    CHECK(next.size() == 2);
+    CHECK(!next.isDirty());
+    CHECK(isFilled(next.find(1, 160, 20), 160 * 20 * 4, 1));
+    CHECK(next.find(2, 160, 20).empty());
+    CHECK(isFilled(next.find(2, 200, 20), 200 * 20 * 4, 3));
+    CHECK(next.find(3, 160, 20).empty());
+
+    // 読み込んだものに追加して保存し直せる
+    next.store(4, 160, 20, makePixels(160, 20, 5));
+    CHECK(next.save(path, [](uint64_t) { return true; }));
+    ThumbnailDiskCache third;
+    CHECK(third.load(path, RENDERER_ID));
+    CHECK(third.size() == 3);
+    CHECK(isFilled(third.find(1, 160, 20), 160 * 20 * 4, 1));
+}
+
+/// @brief シェーダーが変わった場合と壊れたファイルは、キャッシュ全体を使わないこと
+void testRejectsStaleOrCorruptFile()
+{
+    test_util::TempDirectory dir{"thumbnail_reject"};
+    const auto path = dir / "presets.thumbnails";
+
+    ThumbnailDiskCache cache;
+    CHECK(!cache.load(path, RENDERER_ID));
+    cache.store(1, 16, 4, makePixels(16, 4, 9));
+    CHECK(cache.save(path, [](uint64_t) { return true; }));
+
+    ThumbnailDiskCache other_renderer;
+    CHECK(!other_renderer.load(path, RENDERER_ID + 1));
+    CHECK(other_renderer.size() == 0);
+
+    // ピクセルの途中で切れている
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    ThumbnailDiskCache truncated;
+    CHECK(!truncated.load(path, RENDERER_ID));
+    CHECK(truncated.size() == 0);
+    CHECK(truncated.find(1, 16, 4).empty());
+}
+
+/// @brief 合計が MAX_PIXEL_BYTES を超える場合は、最近使ったものから残すこと
+void testSaveKeepsRecentWithinLimit()
+{
+    test_util::TempDirectory dir{"thumbnail_limit"};
+    const auto path = dir / "presets.thumbnails";
+
+    // 1 個で上限の 3 分の 1 を少し超える大きさ。2 個までしか残らない
+    constexpr int32_t WIDTH  = 4096;
+    const int32_t height     = static_cast<int32_t>(thumbnail_cache::MAX_PIXEL_BYTES / (WIDTH * 4) / 3 + 1);
+    const size_t pixel_bytes = static_cast<size_t>(WIDTH) * height * 4;
+
+    ThumbnailDiskCache cache;
+    CHECK(!cache.load(path, RENDERER_ID));
+    for (uint64_t hash = 1; hash <= 3; ++hash) cache.store(hash, WIDTH, height, makePixels(WIDTH, height, static_cast<uint8_t>(hash)));
+    CHECK(!cache.find(1, WIDTH, height).empty());  // 1 を最近使ったものにする
+    CHECK(cache.save(path, [](uint64_t) { return true; }));
+
+    ThumbnailDiskCache next;
+    CHECK(next.load(path, RENDERER_ID));
+    CHECK(next.size() == 2);
+    CHECK(isFilled(next.find(1, WIDTH, height), pixel_bytes, 1));
+    CHECK(isFilled(next.find(3, WIDTH, height), pixel_bytes, 3));
+    CHECK(next.find(2, WIDTH, height).empty());
+}
+}  // namespace
+
+int main()
+{
+    testKeyAndInvalidation();
+    testSaveAndLoad();
+    testRejectsStaleOrCorruptFile();
+    testSaveKeepsRecentWithinLimit();
+    return test_util::result();
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "alloc_counter.h"
+#include "test_util.h"
+#include "ui/widgets/thumbnail_lru.h"
+
+namespace {
+using thumbnail_cache::ThumbnailLru;
+
+/// @brief 同じ内容・大きさで取得した場合は描画し直さず、内容か大きさが変わった場合は同じスロットで描画し直すこと
+void testHitAndRerender()
+{
+    ThumbnailLru lru{4};
+
+    const auto first = lru.acquire(1, 100, 64, 16);
+    CHECK(first.needs_render);
+
+    const auto hit = lru.acquire(1, 100, 64, 16);
+    CHECK(!hit.needs_render);
+    CHECK(hit.index == first.index);
+
+    const auto changed = lru.acquire(1, 101, 64, 16);
+    CHECK(changed.needs_render);
+    CHECK(changed.index == first.index);
+
+    const auto resized = lru.acquire(1, 101, 128, 16);
+    CHECK(resized.needs_render);
+    CHECK(resized.index == first.index);
+    CHECK(!lru.acquire(1, 101, 128, 16).needs_render);
+    CHECK(lru.size() == 1);
+}
+
+/// @brief 容量を超えた場合は最も長く使われていないもののスロットを引き継ぎ、最近使ったものは残ること
+void testEvictsLeastRecentlyUsed()
+{
+    ThumbnailLru lru{3};
+    const uint32_t slot1 = lru.acquire(1, 0, 1, 1).index;
+    const uint32_t slot2 = lru.acquire(2, 0, 1, 1).index;
+    lru.acquire(3, 0, 1, 1);
+
+    // 1 を使うと、最も長く使われていないものは 2 になる
+    CHECK(!lru.acquire(1, 0, 1, 1).needs_render);
+
+    const auto evicted = lru.acquire(4, 0, 1, 1);
+    CHECK(evicted.needs_render);
+    CHECK(evicted.index == slot2);
+    CHECK(lru.size() == 3);
+
+    CHECK(!lru.acquire(1, 0, 1, 1).needs_render);
+    CHECK(lru.acquire(1, 0, 1, 1).index == slot1);
+
+    // 追い出された 2 は描画し直す
+    CHECK(lru.acquire(2, 0, 1, 1).needs_render);
+}
+
+/// @brief スロット番号は容量未満に収まること
+void testSlotIndexBelowCapacity()
+{
+    constexpr uint32_t CAPACITY = 8;
+    ThumbnailLru lru{CAPACITY};
+    std::vector<bool> used(CAPACITY, false);
+    for (uint64_t key = 0; key < 1000; ++key) {
+        const auto slot = lru.acquire(key * 7 % 37, key, 1, 1);
+        if (!CHECK(slot.index < CAPACITY)) break;
+        used[slot.index] = true;
+    }
+    CHECK(lru.size() == CAPACITY);
+    CHECK(std::count(used.begin(), used.end(), true) == CAPACITY);
+}
+
+/// @brief clear() の後はすべて描画し直すこと
+void testClear()
+{
+    ThumbnailLru lru{2};
+    lru.acquire(1, 0, 1, 1);
+    lru.acquire(2, 0, 1, 1);
+    lru.clear();
+    CHECK(lru.size() == 0);
+    CHECK(lru.acquire(1, 0, 1, 1).needs_render);
+    CHECK(lru.acquire(1, 0, 1, 1).index == 0);
+}
+
+/// @brief 容量に達した後は、追い出しを含めてヒープ確保が起きないこと
+void testEvictionDoesNotAllocate()
+{
+    ThumbnailLru lru{64};
+    for (uint64_t key = 0; key < 64; ++key) lru.acquire(key, 0, 1, 1);
+
+    const test_util::AllocationCounter counter;
+    for (uint64_t key = 64; key < 10000; ++key) lru.acquire(key, key, 1, 1);
+    CHECK(counter.count() == 0);
+}
+}  // namespace
+
+int main()
+{
+    testHitAndRerender();
+    testEvictsLeastRecentlyUsed();
+    testSlotIndexBelowCapacity();
+    testClear();
+    testEvictionDoesNotAllocate();
+    return test_util::result();
+}
@@ -0,0 +1,90 @@
+#include <string>
+#include <string_view>
+
+#include "alloc_counter.h"
+#include "test_util.h"
+#include "utils/aviutl2/translation_cache.h"
+
+namespace {
+using aul2::TranslationCache;
+
+// ホストの代わりの翻訳。g_is_english で言語を切り替える
+bool g_is_english       = false;
+int g_translate_count   = 0;
+bool g_has_translations = true;
+
+const wchar_t* fakeTranslate(const wchar_t* key)
+{
+    ++g_translate_count;
+    if (!g_has_translations) return nullptr;
+    if (!g_is_english) return key;
+    const std::wstring_view view{key};
+    if (view == L"表示") return L"View";
+    if (view == L"反映") return L"Apply";
+    return L"?";
+}
+
+/// @brief 2 回目以降は翻訳もヒープ確保もせず、同じポインタを返すこと
+void testCachedLookupDoesNotAllocate()
+{
+    g_is_english = true;
+    TranslationCache cache{fakeTranslate};
+    cache.refresh();
+
+    const char* label  = cache.get({}, L"反映", "###apply");
+    const char* plain  = cache.get({}, L"反映", {});
+    const char* prefix = cache.get("> ", L"反映", " (%d)");
+    CHECK(std::string_view{label} == "Apply###apply");
+    CHECK(std::string_view{plain} == "Apply");
+    CHECK(std::string_view{prefix} == "> Apply (%d)");
+    CHECK(cache.size() == 3);
+
+    const int translate_count = g_translate_count;
+    test_util::AllocationCounter counter;
+    bool is_same = true;
+    for (int i = 0; i < 100; ++i) {
+        cache.refresh();
+        is_same = is_same && cache.get({}, L"反映", "###apply") == label;
+        is_same = is_same && cache.get({}, L"反映", {}) == plain;
+        is_same = is_same && cache.get("> ", L"反映", " (%d)") == prefix;
+    }
+    CHECK(counter.count() == 0);
+    CHECK(is_same);
+    // refresh() で言語の確認に翻訳するだけで、キャッシュ済みの文字列は翻訳しない
+    CHECK(g_translate_count - translate_count == 100);
+}
+
+/// @brief 言語が変わるとキャッシュを破棄して翻訳し直すこと
+void testRefreshOnLanguageChange()
+{
+    g_is_english = false;
+    TranslationCache cache{fakeTranslate};
+    cache.refresh();
+    CHECK(std::string_view{cache.get({}, L"反映", {})} == reinterpret_cast<const char*>(u8"反映"));
+
+    g_is_english = true;
+    cache.refresh();
+    CHECK(cache.size() == 0);
+    CHECK(std::string_view{cache.get({}, L"反映", {})} == "Apply");
+    g_is_english = false;
+}
+
+/// @brief 翻訳できない間は前後の文字列のみを返し、キャッシュを破棄しないこと
+void testWithoutTranslations()
+{
+    g_has_translations = false;
+    TranslationCache cache{fakeTranslate};
+    CHECK(std::string_view{cache.get("[", L"反映", "]")} == "[]");
+    cache.refresh();
+    CHECK(cache.size() == 1);
+    g_has_translations = true;
+}
+}  // namespace
+
+int main()
+{
+    testCachedLookupDoesNotAllocate();
+    testRefreshOnLanguageChange();
+    testWithoutTranslations();
+    return test_util::result();
+}